@@ -4,6 +4,7 @@
 #include "Application.h"
 #include "ApplicationEvent.h"
 #include "ApplicationRunner.h"
+#include "AssetManager.h"
 #include "EventManager.h"
 #include "ImGuiBuilder.h"
 #include "Input.h"
@@ -74,12 +75,14 @@ void Application::Initialize()
     DOO_CORE_INFO("Application initialized");
     Input::Get()->Initialize();
     Renderer::Get()->Initialize();
+    AssetManager::Get()->Initialize();
     ImGuiBuilder::Get()->Initialize();
 }
 
 void Application::Deinitialize()
 {
     DOO_CORE_INFO("Application deinitialized");
+    AssetManager::Get()->Deinitialize();
     Renderer::Get()->Deinitialize();
     ImGuiBuilder::Get()->Deinitialize();
     Input::Get()->Deinitialize();
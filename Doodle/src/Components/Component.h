@@ -173,9 +173,15 @@ struct TransformComponent : public BaseComponent
     Transform GlobalTransform;
 
     bool Dirty = true;
+    // 静态物体会被 StaticBatcher 合并，移动或修改材质都会重建整个合批，代价较高
+    bool Static = false;
 
     void OnInspectorLayout() override
     {
+        if (ImGui::Checkbox("Static", &Static))
+        {
+            GetScene()->MarkStaticDirty();
+        }
         ImGui::Text("Position");
         if (ImGui::DragFloat3("##Position", &LocalTransform.Position.x, 0.1f))
         {
@@ -198,6 +204,14 @@ struct TransformComponent : public BaseComponent
         }
     }
 
+    void SetStatic(bool isStatic)
+    {
+        if (Static == isStatic)
+            return;
+        Static = isStatic;
+        GetScene()->MarkStaticDirty();
+    }
+
     void SetLocalPosition(const glm::vec3 &position)
     {
         LocalTransform.Position = position;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AssetManager.h"
 #include "BaseComponent.h"
 #include "ImGuiUtils.h"
 #include "Mesh.h"
@@ -40,9 +41,12 @@ struct MeshComponent : public IRenderable
 {
     COMPONENT_CLASS_TYPE(Mesh)
 
+    static constexpr float LOD_HYSTERESIS = 0.25f;
+
     std::shared_ptr<Mesh> Mesh;
+    uint32_t LOD = 0; // 上一次选择的 LOD
 
-    MeshComponent(const std::string &filename) : Mesh(Mesh::Create(filename))
+    MeshComponent(const std::string &filename) : Mesh(AssetManager::Get()->LoadMesh(filename))
     {
     }
 
@@ -55,10 +59,26 @@ struct MeshComponent : public IRenderable
         Mesh->Render();
     }
 
+    // 选择投影误差不超过 maxPixelError 的最粗 LOD，pixelsPerUnit 是网格所在距离处模型空间单位长度对应的像素数。
+    // 误差超出阈值一定比例才换更细的，低于阈值一定比例才换更粗的，避免在阈值附近来回切换
+    uint32_t SelectLOD(float pixelsPerUnit, float maxPixelError)
+    {
+        uint32_t lodCount = Mesh->GetLODCount();
+        LOD = std::min(LOD, lodCount - 1);
+        while (LOD > 0 && Mesh->GetLODError(LOD) * pixelsPerUnit > maxPixelError * (1.0f + LOD_HYSTERESIS))
+            LOD--;
+        while (LOD + 1 < lodCount &&
+               Mesh->GetLODError(LOD + 1) * pixelsPerUnit < maxPixelError * (1.0f - LOD_HYSTERESIS))
+            LOD++;
+        return LOD;
+    }
+
     void OnInspectorLayout() override
     {
         ImGuiUtils::ReadOnlyInputInt("Vertices", Mesh->GetVertexCount());
         ImGuiUtils::ReadOnlyInputInt("Faces", Mesh->GetFaceCount());
+        ImGuiUtils::ReadOnlyInputInt("LODs", Mesh->GetLODCount());
+        ImGuiUtils::ReadOnlyInputInt("Current LOD", LOD);
     }
 };
 
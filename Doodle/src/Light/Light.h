@@ -102,6 +102,8 @@ struct UBOScene
     float Padding1;
     glm::vec2 Resolution;
     float Padding2[2];
+    // 环境辐照度的球谐系数，w 未使用
+    glm::vec4 IrradianceSH[9];
 };
 
 struct UBOPointLights
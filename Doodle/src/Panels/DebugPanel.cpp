@@ -1,5 +1,7 @@
 #include "DebugPanel.h"
+#include "GPUMemoryTracker.h"
 #include "RenderPipeline.h"
+#include "TextureStreamer.h"
 #include "imgui.h"
 
 namespace Doodle
@@ -14,6 +16,103 @@ void DebugPanel::OnPanelLayout()
     ImGui::Checkbox("Wireframe Mode", &m_useWireframe);
     auto width = ImGui::GetContentRegionAvail().x;
 
+    if (ImGui::CollapsingHeader("GPU Memory"))
+    {
+        constexpr float MB = 1024.0f * 1024.0f;
+        auto tracker = GPUMemoryTracker::Get();
+        ImGui::Text("Total: %.1f MB, Peak: %.1f MB", static_cast<float>(tracker->GetTotalBytes()) / MB,
+                    static_cast<float>(tracker->GetPeakBytes()) / MB);
+
+        if (ImGui::BeginTable("GPUMemoryCategories", 4, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Size (MB)");
+            ImGui::TableSetupColumn("Peak (MB)");
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < static_cast<size_t>(GPUMemoryCategory::Count); i++)
+            {
+                auto category = static_cast<GPUMemoryCategory>(i);
+                auto stats = tracker->GetStats(category);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GPUMemoryCategoryToString(category));
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.Count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<float>(stats.Bytes) / MB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<float>(stats.PeakBytes) / MB);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::DragInt("Top Allocations", &m_topAllocationCount, 1.0f, 1, 100);
+        if (ImGui::BeginTable("GPUMemoryAllocations", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY,
+                              ImVec2(0.0f, 200.0f)))
+        {
+            ImGui::TableSetupColumn("Name");
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("Size (MB)");
+            ImGui::TableHeadersRow();
+            for (const auto &allocation : tracker->GetLargestAllocations(m_topAllocationCount))
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(allocation.Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GPUMemoryCategoryToString(allocation.Category));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", static_cast<float>(allocation.Size) / MB);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Texture Streaming"))
+    {
+        auto streamer = TextureStreamer::Get();
+        bool enabled = streamer->IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+            streamer->SetEnabled(enabled);
+        int budget = static_cast<int>(streamer->GetBudget() / (1024 * 1024));
+        if (ImGui::DragInt("Budget (MB)", &budget, 1.0f, 16, 8192))
+            streamer->SetBudget(static_cast<uint64_t>(budget) * 1024 * 1024);
+
+        float residentMB = static_cast<float>(streamer->GetResidentBytes()) / (1024.0f * 1024.0f);
+        std::string overlay = fmt::format("{:.1f} / {} MB", residentMB, budget);
+        ImGui::ProgressBar(residentMB / static_cast<float>(budget), ImVec2(-1.0f, 0.0f), overlay.c_str());
+        ImGui::BeginDisabled();
+        ImGuiUtils::ReadOnlyInputInt("Textures", static_cast<int>(streamer->GetTextures().size()));
+        ImGui::EndDisabled();
+
+        if (ImGui::BeginTable("StreamingTextures", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY,
+                              ImVec2(0.0f, 200.0f)))
+        {
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableSetupColumn("Resident");
+            ImGui::TableSetupColumn("Requested");
+            ImGui::TableHeadersRow();
+            for (auto &[_, state] : streamer->GetTextures())
+            {
+                auto texture = state.Texture.lock();
+                if (!texture)
+                    continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%ux%u", texture->GetWidth(), texture->GetHeight());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", texture->GetResidentMipLevel());
+                ImGui::TableNextColumn();
+                if (state.RequestedLevel == UINT32_MAX)
+                    ImGui::TextDisabled("-");
+                else
+                    ImGui::Text("%u", state.RequestedLevel);
+            }
+            ImGui::EndTable();
+        }
+    }
+
     for (auto &frameBuffer : RenderPipeline::Get()->GetFrameBuffers())
     {
         if (ImGui::CollapsingHeader(frameBuffer.first.c_str()))
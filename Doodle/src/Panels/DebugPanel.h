@@ -22,6 +22,7 @@ public:
 
 private:
     bool m_useWireframe = false;
+    int m_topAllocationCount = 16;
 };
 
 } // namespace Doodle
@@ -1,6 +1,8 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include "ApplicationRunner.h"
+#include "AssetManager.h"
 #include "Component.h"
 #include "EditorCamera.h"
 #include "Entity.h"
@@ -153,14 +155,29 @@ void HierarchyPanel::OnPanelLayout()
             ImGui::EndMenu();
         }
 
-        if (ImGui::MenuItem("Load Model..."))
+        bool loadModel = ImGui::MenuItem("Load Model...");
+        bool loadStaticModel = ImGui::MenuItem("Load Static Model...");
+        if (loadModel || loadStaticModel)
         {
             std::filesystem::path filepath = FileSystem::OpenFileDialog(
                 {{"Wavefront OBJ", "obj"}, {"Autodesk FBX", "fbx"}, {"GL Transmission", "gltf,glb"}});
             if (filepath != "")
             {
-                auto model = Model::Create(filepath.string());
-                auto entity = scene->CreateEntityFromModel(model);
+                // 导入在主线程上进行：期间处理窗口事件保持响应，每 10% 记录一次进度，按 Esc 取消
+                int reported = -1;
+                auto progress = [&reported](float value) {
+                    int percent = static_cast<int>(value * 10.0f) * 10;
+                    if (percent != reported)
+                    {
+                        DOO_CORE_INFO("Importing model: {0}%", percent);
+                        reported = percent;
+                    }
+                    ApplicationRunner::GetWindow()->PollEvents();
+                    return !Input::IsKeyDown(KeyCode::Escape);
+                };
+                auto model = AssetManager::Get()->LoadModel(filepath.string(), progress);
+                if (model && model->IsValid())
+                    scene->CreateEntityFromModel(model, loadStaticModel);
             }
         }
 
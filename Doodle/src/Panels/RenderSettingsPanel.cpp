@@ -22,11 +22,24 @@ void RenderSettingsPanel::OnPanelLayout()
         return;
     }
 
-    for (auto &renderPass : RenderPipeline::Get()->GetRenderPasses())
+    bool gpuDriven = RenderPipeline::Get()->IsGPUDriven();
+    if (ImGui::Checkbox("GPU Driven", &gpuDriven))
+        RenderPipeline::Get()->SetGPUDriven(gpuDriven);
+
+    float renderScale = RenderPipeline::Get()->GetRenderScale();
+    if (ImGui::SliderFloat("Render Scale", &renderScale, RenderPipeline::MIN_RENDER_SCALE, 1.0f))
+        RenderPipeline::Get()->SetRenderScale(renderScale);
+
+    static const char *s_upscaleModes[] = {"None", "Temporal", "Spatial"};
+    int upscaleMode = static_cast<int>(RenderPipeline::Get()->GetUpscaleMode());
+    if (ImGui::Combo("Upscale Mode", &upscaleMode, s_upscaleModes, IM_ARRAYSIZE(s_upscaleModes)))
+        RenderPipeline::Get()->SetUpscaleMode(static_cast<UpscaleMode>(upscaleMode));
+
+    for (const auto &name : RenderPipeline::Get()->GetRenderPassOrder())
     {
-        if (ImGui::CollapsingHeader(renderPass.first.c_str()))
+        if (ImGui::CollapsingHeader(name.c_str()))
         {
-            renderPass.second->OnLayout();
+            RenderPipeline::Get()->GetRenderPass(name)->OnLayout();
         }
     }
 }
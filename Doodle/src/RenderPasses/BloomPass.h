@@ -6,72 +6,37 @@
 #include "Renderer.h"
 #include "RendererAPI.h"
 #include "Shader.h"
+#include "Texture.h"
 #include "glm/fwd.hpp"
 #include "imgui.h"
 #include "pch.h"
 
 #include "Component.h"
 #include "RenderPass.h"
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
 namespace Doodle
 {
 
-struct BloomMip
-{
-    std::shared_ptr<FrameBuffer> Fbo = nullptr;
-    glm::u32vec2 Size; // 纹理的尺寸
-};
-
-class DOO_API BloomFbo
+// 所有 mip 级别共用一张带 mip 链的 RGBA16F 纹理，降采样与升采样都在计算着色器中通过 image load/store 完成
+class DOO_API BloomMipChain
 {
     friend class BloomPass;
 
 public:
-    BloomFbo(uint32_t width, uint32_t height, uint32_t mipCount)
-        : m_width(width), m_height(height), m_mipCount(mipCount)
+    BloomMipChain(uint32_t width, uint32_t height, uint32_t mipCount) : m_mipCount(mipCount)
     {
-        m_downsampleShader = ShaderLibrary::Get()->GetShader("downsample");
-        m_upsampleShader = ShaderLibrary::Get()->GetShader("upsample");
+        m_downsampleShader = ShaderLibrary::Get()->GetShader("bloomDownsample");
+        m_upsampleShader = ShaderLibrary::Get()->GetShader("bloomUpsample");
         m_bloomShader = ShaderLibrary::Get()->GetShader("bloom");
-
-        m_mipChain.resize(m_mipCount);
-
-        // 创建多个 mip 级别的纹理
-        for (unsigned int i = 0; i < m_mipCount; i++)
-        {
-            glm::u32vec2 mipSize = {static_cast<uint32_t>(width * std::pow(0.5f, i)),
-                                    static_cast<uint32_t>(height * std::pow(0.5f, i))};
-
-            FramebufferAttachmentSpecification attachments = {FramebufferTextureFormat::RGBA16F};
-            FramebufferSpecification spec = {mipSize.x, mipSize.y, attachments};
-
-            m_mipChain[i] = {FrameBuffer::Create(spec), mipSize};
-        }
-
-        RenderPipeline::Get()->SetFrameBuffer("BloomMap", m_mipChain[0].Fbo);
+        Resize(width, height);
     }
 
     void SetMipCount(uint32_t mipCount)
     {
-        if (mipCount == m_mipCount)
-            return;
-        m_mipChain.resize(m_mipCount);
-        if (mipCount > m_mipCount)
-        {
-            for (unsigned int i = m_mipCount; i < mipCount; i++)
-            {
-                glm::u32vec2 mipSize = {static_cast<uint32_t>(m_width * std::pow(0.5f, i)),
-                                        static_cast<uint32_t>(m_height * std::pow(0.5f, i))};
-
-                FramebufferAttachmentSpecification attachments = {FramebufferTextureFormat::RGBA16F};
-                FramebufferSpecification spec = {mipSize.x, mipSize.y, attachments};
-
-                m_mipChain.push_back({FrameBuffer::Create(spec), mipSize});
-            }
-        }
-        m_mipCount = mipCount;
+        m_mipCount = std::clamp(mipCount, 1u, m_texture->GetMipLevelCount());
     }
 
     uint32_t GetMipCount() const
@@ -79,61 +44,77 @@ public:
         return m_mipCount;
     }
 
+    // 只有尺寸变化时才重新分配纹理
     void Resize(uint32_t width, uint32_t height)
     {
+        if (m_texture && width == m_width && height == m_height)
+            return;
         m_width = width;
         m_height = height;
 
-        // 创建多个 mip 级别的纹理
-        for (unsigned int i = 0; i < m_mipCount; i++)
-        {
-            glm::u32vec2 mipSize = {static_cast<uint32_t>(width * std::pow(0.5f, i)),
-                                    static_cast<uint32_t>(height * std::pow(0.5f, i))};
-
-            FramebufferAttachmentSpecification attachments = {FramebufferTextureFormat::RGBA16F};
-            FramebufferSpecification spec = {mipSize.x, mipSize.y, attachments};
-
-            m_mipChain[i].Fbo->Resize(mipSize.x, mipSize.y);
-            m_mipChain[i].Size = mipSize;
-        }
+        // 旧纹理可能仍被本帧已提交的渲染命令引用，延迟到命令执行后释放
+        if (m_texture)
+            Renderer::Submit([texture = m_texture]() {});
+
+        TextureParams params;
+        params.Format = TextureFormat::RGBA16F;
+        params.Wrap = TextureWrap::ClampToEdge;
+        params.Filter = TextureFilter::MipmapLinear;
+        params.Width = width;
+        params.Height = height;
+        m_texture = Texture2D::Create(params);
+        m_mipCount = std::min(m_mipCount, m_texture->GetMipLevelCount());
     }
 
     void RenderBloom(std::shared_ptr<FrameBuffer> source)
     {
         if (m_mipCount == 0)
             return;
+        // mip 链通过纹理单元绑定，句柄在重新分配后的第一帧还不可用
+        m_texture->Bind(MIP_CHAIN_TEXTURE_SLOT);
+
         // Downsample
-        for (unsigned int i = 0; i < m_mipCount; i++)
+        m_downsampleShader->Bind();
+        m_downsampleShader->SetUniformTexture("u_SourceTexture", source->GetColorAttachmentTextureHandle());
+        for (uint32_t i = 0; i < m_mipCount; i++)
         {
-            const BloomMip &mip = m_mipChain[i];
-            mip.Fbo->Bind();
-            auto input = (i == 0) ? source : m_mipChain[i - 1].Fbo;
-            Renderer::RenderFullscreenQuad(input, m_downsampleShader);
+            m_downsampleShader->SetUniform1i("u_FromSource", i == 0 ? 1 : 0);
+            m_downsampleShader->SetUniform1i("u_SourceLod", i == 0 ? 0 : static_cast<int>(i - 1));
+            m_texture->BindImage(0, i);
+            Dispatch(i);
+            Renderer::Barrier(BarrierFlags::ShaderImageAccess | BarrierFlags::TextureFetch);
         }
 
-        Renderer::SetBlend(BlendType::One, BlendType::One);
-        m_upsampleShader->SetUniform1f("u_FilterRadius", m_blurRadius);
         // Upsample
-        for (unsigned int i = m_mipCount - 1; i > 0; i--)
+        m_upsampleShader->Bind();
+        m_upsampleShader->SetUniform1f("u_FilterRadius", m_blurRadius);
+        for (uint32_t i = m_mipCount - 1; i > 0; i--)
         {
-            const BloomMip &mip = m_mipChain[i];
-            const BloomMip &nextMip = m_mipChain[i - 1];
-
-            nextMip.Fbo->Bind();
-            Renderer::RenderFullscreenQuad(mip.Fbo, m_upsampleShader);
+            m_upsampleShader->SetUniform1i("u_SourceLod", static_cast<int>(i));
+            m_texture->BindImage(0, i - 1);
+            Dispatch(i - 1);
+            Renderer::Barrier(BarrierFlags::ShaderImageAccess | BarrierFlags::TextureFetch);
         }
 
-        Renderer::SetBlend(BlendType::SrcAlpha, BlendType::OneMinusSrcAlpha);
         source->Bind();
-        m_bloomShader->SetUniformTexture("u_BloomTexture", m_mipChain[0].Fbo->GetColorAttachmentTextureHandle());
         Renderer::RenderFullscreenQuad(source, m_bloomShader);
-        // 返回默认的混合模式
+        m_texture->Unbind();
     }
 
 private:
-    unsigned int m_width, m_height;
-    unsigned int m_mipCount;
-    std::vector<BloomMip> m_mipChain;
+    static constexpr uint32_t GROUP_SIZE = 8;
+    static constexpr uint32_t MIP_CHAIN_TEXTURE_SLOT = 1;
+
+    void Dispatch(uint32_t level)
+    {
+        uint32_t width = std::max(m_width >> level, 1u);
+        uint32_t height = std::max(m_height >> level, 1u);
+        Renderer::DispatchCompute((width + GROUP_SIZE - 1) / GROUP_SIZE, (height + GROUP_SIZE - 1) / GROUP_SIZE);
+    }
+
+    uint32_t m_width = 0, m_height = 0;
+    uint32_t m_mipCount;
+    std::shared_ptr<Texture2D> m_texture;
     std::shared_ptr<Shader> m_downsampleShader;
     std::shared_ptr<Shader> m_upsampleShader;
     std::shared_ptr<Shader> m_bloomShader;
@@ -146,7 +127,7 @@ public:
     BloomPass(const RenderPassSpecification &specification) : RenderPass(specification)
     {
 
-        m_bloomFbo = std::make_shared<BloomFbo>(1920, 1080, 5);
+        m_bloomMipChain = std::make_shared<BloomMipChain>(1920, 1080, 5);
     }
 
     void BeginScene() override
@@ -162,20 +143,20 @@ public:
         auto targetFrameBuffer = GetSpecification().TargetFrameBuffer;
         auto width = targetFrameBuffer->GetWidth();
         auto height = targetFrameBuffer->GetHeight();
-        m_bloomFbo->Resize(width, height);
-        m_bloomFbo->m_bloomShader->SetUniform1f("u_BloomStrength", m_bloomStrength);
-        m_bloomFbo->m_bloomShader->SetUniform1f("u_Exposure", m_exposure);
-        m_bloomFbo->RenderBloom(targetFrameBuffer);
+        m_bloomMipChain->Resize(width, height);
+        m_bloomMipChain->m_bloomShader->SetUniform1f("u_BloomStrength", m_bloomStrength);
+        m_bloomMipChain->m_bloomShader->SetUniform1f("u_Exposure", m_exposure);
+        m_bloomMipChain->RenderBloom(targetFrameBuffer);
     }
 
     void OnLayout() override
     {
 
-        uint32_t mipCount = m_bloomFbo->GetMipCount();
+        uint32_t mipCount = m_bloomMipChain->GetMipCount();
         ImGui::DragInt("Mip Count", reinterpret_cast<int *>(&mipCount), 1, 1, 10);
-        m_bloomFbo->SetMipCount(mipCount);
+        m_bloomMipChain->SetMipCount(mipCount);
 
-        ImGui::DragFloat("Blur Radius", &m_bloomFbo->m_blurRadius, 0.001f, 0.0f, 0.01f);
+        ImGui::DragFloat("Blur Radius", &m_bloomMipChain->m_blurRadius, 0.001f, 0.0f, 0.01f);
         ImGui::DragFloat("Bloom Strength", &m_bloomStrength, 0.01f, 0.0f, 1.0f);
         ImGui::DragFloat("Exposure", &m_exposure, 0.1f, 0.0f, 10.0f);
     }
@@ -183,7 +164,7 @@ public:
 private:
     float m_bloomStrength = 0.04f;
     float m_exposure = 1.0f;
-    std::shared_ptr<BloomFbo> m_bloomFbo;
+    std::shared_ptr<BloomMipChain> m_bloomMipChain;
 };
 
 } // namespace Doodle
\ No newline at end of file
@@ -7,6 +7,10 @@
 #include "pch.h"
 
 #include "Component.h"
+#include "GPUScene.h"
+#include "InstanceBatcher.h"
+#include "MaterialTable.h"
+#include "RenderList.h"
 #include "RenderPass.h"
 #include <memory>
 
@@ -41,47 +45,44 @@ public:
         auto *scene = m_scene;
         auto &sceneData = scene->GetData();
 
-        m_shader->SetUniformMatrix4f("u_View", sceneData.CameraData.View);
-        m_shader->SetUniformMatrix4f("u_Projection", sceneData.CameraData.Projection);
-        m_shader->SetUniform1f("u_NearPlane", sceneData.CameraData.Near);
-        m_shader->SetUniform1f("u_FarPlane", sceneData.CameraData.Far);
+        UBOView viewData;
+        viewData.View = sceneData.CameraData.View;
+        viewData.Projection = sceneData.CameraData.Projection;
+        viewData.ViewProjection = sceneData.CameraData.ViewProjection;
+        viewData.LightSpaceMatrix = RenderPipeline::Get()->GetUniformMatrix4f("u_LightSpaceMatrix");
+        viewData.NearPlane = sceneData.CameraData.Near;
+        viewData.FarPlane = sceneData.CameraData.Far;
+        viewData.UnjitteredViewProjection = RenderPipeline::Get()->GetUniformMatrix4f("u_UnjitteredViewProjection");
+        viewData.PreviousViewProjection = RenderPipeline::Get()->GetUniformMatrix4f("u_PreviousViewProjection");
+        SetViewData(viewData);
 
         Renderer::SetDepthTest(DepthTestType::LessEqual);
-        auto vaoView = scene->View<TransformComponent, VAOComponent, MaterialComponent>();
-        for (auto entity : vaoView)
+        MaterialTable::Get()->Bind();
+        for (const auto &item : RenderList::Get()->GetVertexArrayItems())
         {
-            const auto &transform = vaoView.get<TransformComponent>(entity);
-            const auto &vao = vaoView.get<VAOComponent>(entity);
-            const auto &material = vaoView.get<MaterialComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-            auto normalScale = material.MaterialInstance->GetUniform1f("u_NormalScale");
-            auto normalTexture = material.MaterialInstance->GetUniformTexture("u_NormalTexture");
-
-            m_shader->SetUniformMatrix4f("u_Model", model);
-            m_shader->SetUniform1f("u_NormalScale", normalScale);
-            m_shader->SetUniformTexture("u_NormalTexture", normalTexture);
+            m_shader->SetUniformMatrix4f("u_Model", item.Model);
+            m_shader->SetUniformMatrix3f("u_NormalMatrix", item.NormalMatrix);
+            m_shader->SetUniform1ui("u_MaterialID", item.MaterialInstance->GetMaterialSlot());
             m_shader->Bind();
-            vao.Render();
+            item.VertexArray->Render();
         }
 
-        auto meshView = scene->View<TransformComponent, MeshComponent, MaterialComponent>();
-        for (auto entity : meshView)
+        if (RenderPipeline::Get()->IsGPUDriven())
         {
-            const auto &transform = meshView.get<TransformComponent>(entity);
-            const auto &mesh = meshView.get<MeshComponent>(entity);
-            const auto &material = meshView.get<MaterialComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-            auto normalScale = material.MaterialInstance->GetUniform1f("u_NormalScale");
-            auto normalTexture = material.MaterialInstance->GetUniformTexture("u_NormalTexture");
-
-            m_shader->SetUniformMatrix4f("u_Model", model);
-            m_shader->SetUniform1f("u_NormalScale", normalScale);
-            m_shader->SetUniformTexture("u_NormalTexture", normalTexture);
-            m_shader->Bind();
-            mesh.Render();
+            GPUScene::Get()->Draw(m_shader, sceneData.CameraData.ViewProjection);
+        }
+        else
+        {
+            InstanceBatcher::Get()->Bind();
+            m_shader->SetUniform1i("u_UseInstanceBuffer", 1);
+            for (const auto &batch : InstanceBatcher::Get()->GetBatches())
+            {
+                m_shader->SetUniform1ui("u_MaterialID", batch.MaterialInstance->GetMaterialSlot());
+                batch.Mesh->RenderInstanced(batch.InstanceCount, batch.FirstInstance, batch.LOD);
+            }
+            m_shader->SetUniform1i("u_UseInstanceBuffer", 0);
         }
+        m_shader->SetUniform1ui("u_MaterialID", MaterialTable::INVALID_SLOT);
         Renderer::SetDepthTest(DepthTestType::Less);
     }
 
@@ -21,7 +21,16 @@ public:
     {
         m_gtaoShader = ShaderLibrary::Get()->GetShader("gtao");
         m_spatialFilterShader = ShaderLibrary::Get()->GetShader("bilateral");
+        m_temporalShader = ShaderLibrary::Get()->GetShader("gtaoTemporal");
+        m_upsampleShader = ShaderLibrary::Get()->GetShader("bilateralUpsample");
         m_blueNoiseTexture = Texture2D::Create("assets/textures/blueNoise.png");
+
+        // r: AO, g: 线性深度
+        FramebufferSpecification spec = {960, 540, {FramebufferTextureFormat::RGBA16F}};
+        m_halfResAO = FrameBuffer::Create(spec);
+        m_historyAO[0] = FrameBuffer::Create(spec);
+        m_historyAO[1] = FrameBuffer::Create(spec);
+        m_blurredAO = FrameBuffer::Create(spec);
     }
 
     void BeginScene() override
@@ -38,6 +47,13 @@ public:
         auto occlusionMap = RenderPipeline::Get()->GetFrameBuffer("OcclusionMap");
         occlusionMap->Resize(gBuffer->GetWidth(), gBuffer->GetHeight());
 
+        if (m_halfResolution)
+        {
+            ExecuteHalfResolution(gBuffer, occlusionMap);
+            return;
+        }
+        m_historyValid = false;
+
         auto *scene = m_scene;
         auto &sceneData = scene->GetData();
 
@@ -50,6 +66,7 @@ public:
         m_gtaoShader->SetUniform2f("u_Resolution", {occlusionMap->GetWidth(), occlusionMap->GetHeight()});
         m_gtaoShader->SetUniform2f("u_PixelSize", {1.0f / occlusionMap->GetWidth(), 1.0f / occlusionMap->GetHeight()});
         m_gtaoShader->SetUniform1i("u_FrameCounter", Application::Time::GetFrameCount());
+        m_gtaoShader->SetUniform1i("u_HalfResolution", 0);
 
         m_gtaoShader->SetUniform1i("u_Slices", m_slices);
         m_gtaoShader->SetUniform1i("u_HorizonSteps", m_horizonSteps);
@@ -66,21 +83,116 @@ public:
 
     void OnLayout() override
     {
+        ImGui::Checkbox("Half Resolution", &m_halfResolution);
         ImGui::DragInt("Slices", &m_slices, 1, 1, 100);
         ImGui::DragInt("Horizon Steps", &m_horizonSteps, 1, 1, 100);
         ImGui::DragFloat("Radius", &m_radius, 0.1f, 0.1f, 10.0f);
         ImGui::DragFloat("Falloff Start", &m_falloffStart, 0.01f, 0.01f, 1.0f);
 
         ImGui::DragFloat("Spatial Sigma", &m_spatialSigma, 0.1f, 0.1f, 10.0f);
-        ImGui::DragFloat("Color Sigma", &m_colorSigma, 0.1f, 0.1f, 10.0f);
-        ImGui::DragInt("Filter Radius", &m_filterRadius, 1, 1, 10);
+        if (m_halfResolution)
+        {
+            ImGui::DragFloat("Depth Sigma", &m_depthSigma, 0.01f, 0.01f, 1.0f);
+            ImGui::DragInt("Filter Radius", &m_upsampleRadius, 1, 1, 10);
+            ImGui::DragFloat("Temporal Blend", &m_temporalBlend, 0.01f, 0.01f, 1.0f);
+        }
+        else
+        {
+            ImGui::DragFloat("Color Sigma", &m_colorSigma, 0.1f, 0.1f, 10.0f);
+            ImGui::DragInt("Filter Radius", &m_filterRadius, 1, 1, 10);
+        }
     }
 
 private:
+    // 半分辨率计算 GTAO，噪声逐帧轮换后做时间累积，再用深度感知的分离双边滤波上采样到全分辨率
+    void ExecuteHalfResolution(std::shared_ptr<FrameBuffer> gBuffer, std::shared_ptr<FrameBuffer> occlusionMap)
+    {
+        auto &sceneData = m_scene->GetData();
+        const glm::mat4 &view = sceneData.CameraData.View;
+        const glm::mat4 &projection = sceneData.CameraData.Projection;
+        glm::mat4 inverseProjection = glm::inverse(projection);
+
+        uint32_t width = std::max(gBuffer->GetWidth() / 2, 1u);
+        uint32_t height = std::max(gBuffer->GetHeight() / 2, 1u);
+        if (width != m_halfResAO->GetWidth() || height != m_halfResAO->GetHeight())
+        {
+            m_halfResAO->Resize(width, height);
+            m_historyAO[0]->Resize(width, height);
+            m_historyAO[1]->Resize(width, height);
+            m_blurredAO->Resize(width, height);
+            m_historyValid = false;
+        }
+
+        m_halfResAO->Bind();
+        m_gtaoShader->SetUniformTexture("u_GDepth", gBuffer->GetDepthAttachmentTextureHandle());
+        m_gtaoShader->SetUniformTexture("u_NoiseTexture", m_blueNoiseTexture->GetTextureHandle());
+        m_gtaoShader->SetUniformMatrix4f("u_View", view);
+        m_gtaoShader->SetUniformMatrix4f("u_Projection", projection);
+        m_gtaoShader->SetUniformMatrix4f("u_InverseProjection", inverseProjection);
+        m_gtaoShader->SetUniform2f("u_Resolution", {gBuffer->GetWidth(), gBuffer->GetHeight()});
+        m_gtaoShader->SetUniform2f("u_PixelSize", {1.0f / width, 1.0f / height});
+        m_gtaoShader->SetUniform1i("u_FrameCounter", Application::Time::GetFrameCount());
+        m_gtaoShader->SetUniform1i("u_HalfResolution", 1);
+        m_gtaoShader->SetUniform1i("u_Slices", m_slices);
+        m_gtaoShader->SetUniform1i("u_HorizonSteps", m_horizonSteps);
+        m_gtaoShader->SetUniform1f("u_Radius", m_radius);
+        m_gtaoShader->SetUniform1f("u_FalloffStart", m_falloffStart);
+        Renderer::RenderFullscreenQuad(gBuffer, m_gtaoShader);
+
+        // 与 GBuffer 的运动矢量一致，重投影使用未抖动的矩阵，否则 TAAU 的抖动会被当作相机运动
+        glm::mat4 unjitteredViewProjection = RenderPipeline::Get()->GetUniformMatrix4f("u_UnjitteredViewProjection");
+        glm::mat4 unjitteredProjection = unjitteredViewProjection * glm::inverse(view);
+
+        auto &history = m_historyAO[m_historyIndex];
+        auto &previousHistory = m_historyAO[1 - m_historyIndex];
+        history->Bind();
+        m_temporalShader->SetUniformTexture("u_HistoryTexture", previousHistory->GetColorAttachmentTextureHandle());
+        m_temporalShader->SetUniform1i("u_HistoryValid", m_historyValid ? 1 : 0);
+        m_temporalShader->SetUniformMatrix4f("u_InverseProjection", glm::inverse(unjitteredProjection));
+        m_temporalShader->SetUniformMatrix4f("u_InverseView", glm::inverse(view));
+        m_temporalShader->SetUniformMatrix4f("u_PreviousView", m_previousView);
+        m_temporalShader->SetUniformMatrix4f("u_PreviousViewProjection", m_previousViewProjection);
+        m_temporalShader->SetUniform1f("u_TemporalBlend", m_temporalBlend);
+        Renderer::RenderFullscreenQuad(m_halfResAO, m_temporalShader);
+
+        m_upsampleShader->SetUniformTexture("u_GDepth", gBuffer->GetDepthAttachmentTextureHandle());
+        m_upsampleShader->SetUniformMatrix4f("u_InverseProjection", inverseProjection);
+        m_upsampleShader->SetUniform1f("u_SpatialSigma", m_spatialSigma);
+        m_upsampleShader->SetUniform1f("u_DepthSigma", m_depthSigma);
+        m_upsampleShader->SetUniform1i("u_FilterRadius", m_upsampleRadius);
+
+        m_blurredAO->Bind();
+        m_upsampleShader->SetUniform2f("u_Direction", {1.0f, 0.0f});
+        m_upsampleShader->SetUniform1i("u_Upsample", 0);
+        Renderer::RenderFullscreenQuad(history, m_upsampleShader);
+
+        occlusionMap->Bind();
+        m_upsampleShader->SetUniform2f("u_Direction", {0.0f, 1.0f});
+        m_upsampleShader->SetUniform1i("u_Upsample", 1);
+        Renderer::RenderFullscreenQuad(m_blurredAO, m_upsampleShader);
+
+        m_previousView = view;
+        m_previousViewProjection = unjitteredViewProjection;
+        m_historyIndex = 1 - m_historyIndex;
+        m_historyValid = true;
+    }
+
     std::shared_ptr<Shader> m_gtaoShader;
     std::shared_ptr<Shader> m_spatialFilterShader;
+    std::shared_ptr<Shader> m_temporalShader;
+    std::shared_ptr<Shader> m_upsampleShader;
     std::shared_ptr<Texture2D> m_blueNoiseTexture;
 
+    std::shared_ptr<FrameBuffer> m_halfResAO;
+    std::shared_ptr<FrameBuffer> m_historyAO[2];
+    std::shared_ptr<FrameBuffer> m_blurredAO;
+    uint32_t m_historyIndex = 0;
+    bool m_historyValid = false;
+    glm::mat4 m_previousView{1.0f};
+    glm::mat4 m_previousViewProjection{1.0f};
+
+    bool m_halfResolution = true;
+
     int m_slices = 2;
     int m_horizonSteps = 3;
     float m_radius = 2.0f;
@@ -89,6 +201,10 @@ private:
     float m_spatialSigma = 2.0f;
     float m_colorSigma = 1.0f;
     int m_filterRadius = 5;
+
+    float m_depthSigma = 0.1f;
+    int m_upsampleRadius = 3;
+    float m_temporalBlend = 0.1f;
 };
 
 } // namespace Doodle
\ No newline at end of file
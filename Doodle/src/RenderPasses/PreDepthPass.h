@@ -6,6 +6,9 @@
 #include "pch.h"
 
 #include "Component.h"
+#include "GPUScene.h"
+#include "InstanceBatcher.h"
+#include "RenderList.h"
 #include "RenderPass.h"
 #include <memory>
 
@@ -33,32 +36,35 @@ public:
         auto *scene = m_scene;
         auto &sceneData = scene->GetData();
 
-        m_shader->SetUniformMatrix4f("u_View", sceneData.CameraData.View);
-        m_shader->SetUniformMatrix4f("u_Projection", sceneData.CameraData.Projection);
+        UBOView viewData;
+        viewData.View = sceneData.CameraData.View;
+        viewData.Projection = sceneData.CameraData.Projection;
+        viewData.ViewProjection = sceneData.CameraData.ViewProjection;
+        viewData.NearPlane = sceneData.CameraData.Near;
+        viewData.FarPlane = sceneData.CameraData.Far;
+        SetViewData(viewData);
 
-        auto vaoView = scene->View<TransformComponent, VAOComponent, MaterialComponent>();
-        for (auto entity : vaoView)
+        for (const auto &item : RenderList::Get()->GetVertexArrayItems())
         {
-            const auto &transform = vaoView.get<TransformComponent>(entity);
-            const auto &vao = vaoView.get<VAOComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-            m_shader->SetUniformMatrix4f("u_Model", glm::mat4(0.123f) + model);
+            m_shader->SetUniformMatrix4f("u_Model", glm::mat4(0.123f) + item.Model);
             m_shader->Bind();
-            vao.Render();
+            item.VertexArray->Render();
         }
 
-        auto meshView = scene->View<TransformComponent, MeshComponent, MaterialComponent>();
-        for (auto entity : meshView)
+        if (RenderPipeline::Get()->IsGPUDriven())
         {
-            const auto &transform = meshView.get<TransformComponent>(entity);
-            const auto &mesh = meshView.get<MeshComponent>(entity);
-            const auto &material = meshView.get<MaterialComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-            m_shader->SetUniformMatrix4f("u_Model", model);
-            m_shader->Bind();
-            mesh.Render();
+            GPUScene::Get()->Draw(m_shader, sceneData.CameraData.ViewProjection);
+        }
+        else
+        {
+            InstanceBatcher::Get()->Bind();
+            m_shader->SetUniform1i("u_UseInstanceBuffer", 1);
+            for (const auto &batch : InstanceBatcher::Get()->GetBatches())
+            {
+                m_shader->Bind();
+                batch.Mesh->RenderInstanced(batch.InstanceCount, batch.FirstInstance, batch.LOD);
+            }
+            m_shader->SetUniform1i("u_UseInstanceBuffer", 0);
         }
         auto preDepthMap = RenderPipeline::Get()->GetFrameBuffer("PreDepthMap");
         auto targetFrameBuffer = GetSpecification().TargetFrameBuffer;
@@ -3,28 +3,20 @@
 #include "pch.h"
 
 #include "Component.h"
-#include "LTCMatrix.h"
+#include "GPUScene.h"
+#include "InstanceBatcher.h"
+#include "LTCTable.h"
+#include "MaterialTable.h"
+#include "RenderList.h"
 #include "RenderPass.h"
 #include "RenderPipeline.h"
 #include "Texture.h"
+#include "ViewData.h"
 #include <memory>
 
 namespace Doodle
 {
 
-#define SET_UNIFORMS()                                                                                                 \
-    material.MaterialInstance->SetUniformMatrix4f("u_Model", model);                                                   \
-    material.MaterialInstance->SetUniformMatrix4f("u_View", sceneData.CameraData.View);                                \
-    material.MaterialInstance->SetUniformMatrix4f("u_Projection", sceneData.CameraData.Projection);                    \
-    material.MaterialInstance->SetUniformTexture("u_IrradianceMap", irradienceMap->GetTextureHandle());                \
-    material.MaterialInstance->SetUniformTexture("u_PrefilterMap", prefilterMap->GetTextureHandle());                  \
-    material.MaterialInstance->SetUniformTexture("u_BrdfLUT", m_brdfLUT->GetTextureHandle());                          \
-    material.MaterialInstance->SetUniformTexture("u_LTC1", m_ltc1->GetTextureHandle());                                \
-    material.MaterialInstance->SetUniformTexture("u_LTC2", m_ltc2->GetTextureHandle());                                \
-    material.MaterialInstance->SetUniformMatrix4f("u_LightSpaceMatrix", lightSpaceMatrix);                             \
-    material.MaterialInstance->SetUniformTexture("u_ShadowMap", shadowMap->GetDepthAttachmentTextureHandle());         \
-    material.MaterialInstance->SetUniformTexture("u_OcclusionMap", occlusionMap->GetColorAttachmentTextureHandle(0));
-
 class DOO_API ShadingPass : public RenderPass
 {
 public:
@@ -34,12 +26,13 @@ public:
         params.Wrap = TextureWrap::ClampToEdge;
         m_brdfLUT = Texture2D::Create("assets/textures/brdfLUT.png", params);
 
-        params.Wrap = TextureWrap::ClampToEdge;
-        params.Filter = TextureFilter::Linear;
-        Buffer ltc1Buffer = Buffer::Copy(LTC1, sizeof(LTC1));
-        m_ltc1 = Texture2D::Create(ltc1Buffer, params);
-        Buffer ltc2Buffer = Buffer::Copy(LTC2, sizeof(LTC2));
-        m_ltc2 = Texture2D::Create(ltc2Buffer, params);
+        if (!LTCTable::Load(LTCTable::DEFAULT_PATH, m_ltc1, m_ltc2))
+        {
+            m_ltc1 = Texture2D::GetBlackTexture();
+            m_ltc2 = Texture2D::GetBlackTexture();
+        }
+
+        m_frameTextureBuffer = std::make_shared<FrameTextureBuffer>();
     }
 
     void BeginScene() override
@@ -59,46 +52,75 @@ public:
 
         auto *scene = m_scene;
         auto &sceneData = scene->GetData();
-        auto irradienceMap = sceneData.EnvironmentData.IrradianceMap;
-        auto prefilterMap = sceneData.EnvironmentData.RadianceMap;
 
-        glm::mat4 lightSpaceMatrix = RenderPipeline::Get()->GetUniformMatrix4f("u_LightSpaceMatrix");
-        std::shared_ptr<FrameBuffer> shadowMap = RenderPipeline::Get()->GetFrameBuffer("ShadowMap");
-        std::shared_ptr<FrameBuffer> occlusionMap = RenderPipeline::Get()->GetFrameBuffer("OcclusionMap");
-        auto targetFrameBuffer = GetSpecification().TargetFrameBuffer;
+        // 视图常量与纹理句柄每个 Pass 只上传一次，逐次绘制只设置 u_Model 与 u_MaterialID
+        UBOView viewData;
+        viewData.View = sceneData.CameraData.View;
+        viewData.Projection = sceneData.CameraData.Projection;
+        viewData.ViewProjection = sceneData.CameraData.ViewProjection;
+        viewData.LightSpaceMatrix = RenderPipeline::Get()->GetUniformMatrix4f("u_LightSpaceMatrix");
+        viewData.NearPlane = sceneData.CameraData.Near;
+        viewData.FarPlane = sceneData.CameraData.Far;
+        SetViewData(viewData);
+
+        FrameTextures frameTextures;
+        frameTextures.PrefilterMap = sceneData.EnvironmentData.RadianceMap;
+        frameTextures.BrdfLUT = m_brdfLUT;
+        frameTextures.LTC1 = m_ltc1;
+        frameTextures.LTC2 = m_ltc2;
+        frameTextures.ShadowMap = RenderPipeline::Get()->GetFrameBuffer("ShadowMap");
+        frameTextures.OcclusionMap = RenderPipeline::Get()->GetFrameBuffer("OcclusionMap");
+        m_frameTextureBuffer->Update(frameTextures);
+        m_frameTextureBuffer->Bind();
 
         Renderer::SetDepthTest(DepthTestType::LessEqual);
-        auto vaoView = scene->View<TransformComponent, VAOComponent, MaterialComponent>();
-        for (auto entity : vaoView)
+        MaterialTable::Get()->Bind();
+        for (const auto &item : RenderList::Get()->GetVertexArrayItems())
         {
-            const auto &transform = vaoView.get<TransformComponent>(entity);
-            const auto &vao = vaoView.get<VAOComponent>(entity);
-            const auto &material = vaoView.get<MaterialComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-
-            SET_UNIFORMS();
-
-            material.MaterialInstance->Bind();
-            vao.Render();
-            material.MaterialInstance->Unbind();
+            auto shader = item.MaterialInstance->GetShader();
+            item.MaterialInstance->Bind();
+            shader->SetUniformMatrix4f("u_Model", item.Model);
+            shader->SetUniformMatrix3f("u_NormalMatrix", item.NormalMatrix);
+            shader->SetUniform1ui("u_MaterialID", item.MaterialInstance->GetMaterialSlot());
+            item.VertexArray->Render();
+            item.MaterialInstance->Unbind();
         }
 
-        auto meshView = scene->View<TransformComponent, MeshComponent, MaterialComponent>();
-        for (auto entity : meshView)
+        bool gpuDriven = RenderPipeline::Get()->IsGPUDriven();
+        auto standardShader = ShaderLibrary::Get()->GetShader("standard");
+        if (gpuDriven)
         {
+            GPUScene::Get()->Draw(standardShader, sceneData.CameraData.ViewProjection,
+                                  RenderObjectFlags::StandardShading);
+        }
 
-            const auto &transform = meshView.get<TransformComponent>(entity);
-            const auto &mesh = meshView.get<MeshComponent>(entity);
-            const auto &material = meshView.get<MaterialComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-
-            SET_UNIFORMS();
+        InstanceBatcher::Get()->Bind();
+        if (!gpuDriven)
+        {
+            // standard 材质的参数都在 MaterialTable 中，每次绘制只需要切换 u_MaterialID
+            standardShader->SetUniform1i("u_UseInstanceBuffer", 1);
+            for (const auto &batch : InstanceBatcher::Get()->GetBatches())
+            {
+                if (batch.MaterialInstance->GetShader() != standardShader)
+                    continue;
+                standardShader->SetUniform1ui("u_MaterialID", batch.MaterialInstance->GetMaterialSlot());
+                batch.Mesh->RenderInstanced(batch.InstanceCount, batch.FirstInstance, batch.LOD);
+            }
+            standardShader->SetUniform1i("u_UseInstanceBuffer", 0);
+        }
+        standardShader->SetUniform1ui("u_MaterialID", MaterialTable::INVALID_SLOT);
 
-            material.MaterialInstance->Bind();
-            mesh.Render();
-            material.MaterialInstance->Unbind();
+        for (const auto &batch : InstanceBatcher::Get()->GetBatches())
+        {
+            auto shader = batch.MaterialInstance->GetShader();
+            if (shader == standardShader)
+                continue;
+
+            batch.MaterialInstance->Bind();
+            shader->SetUniform1i("u_UseInstanceBuffer", 1);
+            batch.Mesh->RenderInstanced(batch.InstanceCount, batch.FirstInstance, batch.LOD);
+            shader->SetUniform1i("u_UseInstanceBuffer", 0);
+            batch.MaterialInstance->Unbind();
         }
         Renderer::SetDepthTest(DepthTestType::Less);
     }
@@ -107,6 +129,7 @@ private:
     std::shared_ptr<Texture2D> m_brdfLUT;
     std::shared_ptr<Texture2D> m_ltc1;
     std::shared_ptr<Texture2D> m_ltc2;
+    std::shared_ptr<FrameTextureBuffer> m_frameTextureBuffer;
 };
 
 } // namespace Doodle
\ No newline at end of file
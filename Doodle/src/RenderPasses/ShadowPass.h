@@ -5,6 +5,9 @@
 #include "pch.h"
 
 #include "Component.h"
+#include "GPUScene.h"
+#include "InstanceBatcher.h"
+#include "RenderList.h"
 #include "RenderPass.h"
 #include <memory>
 
@@ -45,36 +48,40 @@ public:
             glm::lookAt(sceneData.CameraData.Position, sceneData.CameraData.Position + directionalLight.Direction,
                         glm::vec3(0.0f, 1.0f, 0.0f));
 
-        m_shader->SetUniformMatrix4f("u_View", lightView);
-        m_shader->SetUniformMatrix4f("u_Projection", lightProjection);
+        glm::mat4 lightSpaceMatrix = lightProjection * lightView;
+        RenderPipeline::Get()->SetUniformMatrix4f("u_LightSpaceMatrix", lightSpaceMatrix);
 
-        RenderPipeline::Get()->SetUniformMatrix4f("u_LightSpaceMatrix", lightProjection * lightView);
+        UBOView viewData;
+        viewData.View = lightView;
+        viewData.Projection = lightProjection;
+        viewData.ViewProjection = lightSpaceMatrix;
+        viewData.LightSpaceMatrix = lightSpaceMatrix;
+        viewData.NearPlane = -range;
+        viewData.FarPlane = range;
+        SetViewData(viewData);
 
-        auto vaoView = scene->View<TransformComponent, VAOComponent, MaterialComponent>();
-        for (auto entity : vaoView)
+        for (const auto &item : RenderList::Get()->GetVertexArrayItems())
         {
-            const auto &transform = vaoView.get<TransformComponent>(entity);
-            const auto &vao = vaoView.get<VAOComponent>(entity);
-
-            glm::mat4 model = transform.GetTransformMatrix();
-            m_shader->SetUniformMatrix4f("u_Model", model);
+            m_shader->SetUniformMatrix4f("u_Model", item.Model);
             m_shader->Bind();
-            vao.Render();
+            item.VertexArray->Render();
         }
 
-        auto meshView = scene->View<TransformComponent, MeshComponent, MaterialComponent>();
-        for (auto entity : meshView)
+        if (RenderPipeline::Get()->IsGPUDriven())
         {
-            const auto &transform = meshView.get<TransformComponent>(entity);
-            const auto &mesh = meshView.get<MeshComponent>(entity);
-            const auto &material = meshView.get<MaterialComponent>(entity);
+            GPUScene::Get()->Draw(m_shader, lightSpaceMatrix, RenderObjectFlags::None, true);
+            return;
+        }
 
-            glm::mat4 model = transform.GetTransformMatrix();
-            m_shader->SetUniformMatrix4f("u_Model", model);
+        InstanceBatcher::Get()->Bind();
+        m_shader->SetUniform1i("u_UseInstanceBuffer", 1);
+        for (const auto &batch : InstanceBatcher::Get()->GetBatches())
+        {
             m_shader->Bind();
-            mesh.Render();
+            batch.Mesh->RenderInstanced(batch.InstanceCount, batch.FirstInstance, batch.ShadowLOD);
             m_shader->Unbind();
         }
+        m_shader->SetUniform1i("u_UseInstanceBuffer", 0);
     }
 
     void OnLayout() override
@@ -82,6 +89,9 @@ public:
         auto &sceneData = m_scene->GetData();
         ImGui::DragFloat("Bias", &sceneData.ShadowBias, 0.001f, 0.0f, 1.0f);
         ImGui::DragFloat("Normal Bias", &sceneData.ShadowNormalBias, 0.001f, 0.0f, 1.0f);
+        int lodBias = static_cast<int>(RenderList::Get()->GetShadowLODBias());
+        if (ImGui::SliderInt("LOD Bias", &lodBias, 0, 3))
+            RenderList::Get()->SetShadowLODBias(static_cast<uint32_t>(lodBias));
     }
 
 private:
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Framebuffer.h"
+#include "RenderPipeline.h"
+#include "Renderer.h"
+#include "Shader.h"
+#include "imgui.h"
+#include "pch.h"
+
+#include "RenderPass.h"
+#include <memory>
+
+namespace Doodle
+{
+
+// 把渲染分辨率的 SceneColor 输出到目标分辨率
+class DOO_API UpscalePass : public RenderPass
+{
+public:
+    UpscalePass(const RenderPassSpecification &specification) : RenderPass(specification)
+    {
+        m_temporalShader = ShaderLibrary::Get()->GetShader("taau");
+        m_easuShader = ShaderLibrary::Get()->GetShader("easu");
+        m_rcasShader = ShaderLibrary::Get()->GetShader("rcas");
+        m_history[0] = FrameBuffer::Create({1920, 1080, {FramebufferTextureFormat::RGBA16F}});
+        m_history[1] = FrameBuffer::Create({1920, 1080, {FramebufferTextureFormat::RGBA16F}});
+    }
+
+    void BeginScene() override
+    {
+        m_historyValid = false;
+    }
+
+    void EndScene() override
+    {
+    }
+
+    void Execute() override
+    {
+        auto sceneColor = RenderPipeline::Get()->GetFrameBuffer("SceneColor");
+        auto targetFrameBuffer = GetSpecification().TargetFrameBuffer;
+        switch (RenderPipeline::Get()->GetUpscaleMode())
+        {
+        case UpscaleMode::Temporal:
+            ExecuteTemporal(sceneColor, targetFrameBuffer);
+            break;
+        case UpscaleMode::Spatial:
+            m_historyValid = false;
+            ExecuteSpatial(sceneColor, targetFrameBuffer);
+            break;
+        default:
+            m_historyValid = false;
+            Renderer::RenderFullscreenQuad(sceneColor);
+            break;
+        }
+    }
+
+    void OnLayout() override
+    {
+        switch (RenderPipeline::Get()->GetUpscaleMode())
+        {
+        case UpscaleMode::Temporal:
+            ImGui::DragFloat("Blend Factor", &m_blendFactor, 0.01f, 0.01f, 1.0f);
+            ImGui::DragFloat("Clamp Gamma", &m_clampGamma, 0.05f, 0.5f, 3.0f);
+            break;
+        case UpscaleMode::Spatial:
+            ImGui::DragFloat("Sharpness", &m_sharpness, 0.01f, 0.0f, 2.0f);
+            break;
+        default:
+            ImGui::TextDisabled("No layout available");
+            break;
+        }
+    }
+
+private:
+    // 时间上采样：当前帧抖动后的低分辨率样本与按运动矢量重投影的历史混合，历史经过邻域方差裁剪
+    void ExecuteTemporal(std::shared_ptr<FrameBuffer> sceneColor, std::shared_ptr<FrameBuffer> targetFrameBuffer)
+    {
+        uint32_t width = targetFrameBuffer->GetWidth();
+        uint32_t height = targetFrameBuffer->GetHeight();
+        if (width != m_history[0]->GetWidth() || height != m_history[0]->GetHeight())
+        {
+            m_history[0]->Resize(width, height);
+            m_history[1]->Resize(width, height);
+            m_historyValid = false;
+        }
+
+        auto pipeline = RenderPipeline::Get();
+        auto gBuffer = pipeline->GetFrameBuffer("GBuffer");
+        auto &history = m_history[m_historyIndex];
+        auto &previousHistory = m_history[1 - m_historyIndex];
+
+        history->Bind();
+        m_temporalShader->SetUniformTexture("u_MotionTexture", gBuffer->GetColorAttachmentTextureHandle(2));
+        m_temporalShader->SetUniformTexture("u_GDepth", gBuffer->GetDepthAttachmentTextureHandle());
+        m_temporalShader->SetUniformTexture("u_HistoryTexture", previousHistory->GetColorAttachmentTextureHandle());
+        m_temporalShader->SetUniform1i("u_HistoryValid", m_historyValid ? 1 : 0);
+        m_temporalShader->SetUniform2f("u_Jitter", pipeline->GetUniform2f("u_Jitter"));
+        m_temporalShader->SetUniformMatrix4f("u_InverseViewProjection",
+                                             glm::inverse(pipeline->GetUniformMatrix4f("u_UnjitteredViewProjection")));
+        m_temporalShader->SetUniformMatrix4f("u_PreviousViewProjection",
+                                             pipeline->GetUniformMatrix4f("u_PreviousViewProjection"));
+        m_temporalShader->SetUniform1f("u_BlendFactor", m_blendFactor);
+        m_temporalShader->SetUniform1f("u_ClampGamma", m_clampGamma);
+        Renderer::RenderFullscreenQuad(sceneColor, m_temporalShader);
+        history->BlitTo(targetFrameBuffer, BufferFlags::Color);
+
+        m_historyIndex = 1 - m_historyIndex;
+        m_historyValid = true;
+    }
+
+    // 空间上采样：EASU 边缘自适应放大到目标分辨率，再用 RCAS 锐化；没有历史，只需要一张 RGBA8 中间缓冲
+    void ExecuteSpatial(std::shared_ptr<FrameBuffer> sceneColor, std::shared_ptr<FrameBuffer> targetFrameBuffer)
+    {
+        uint32_t width = targetFrameBuffer->GetWidth();
+        uint32_t height = targetFrameBuffer->GetHeight();
+        if (!m_spatialBuffer)
+            m_spatialBuffer = FrameBuffer::Create({width, height, {FramebufferTextureFormat::RGBA8}});
+        m_spatialBuffer->Resize(width, height);
+
+        m_spatialBuffer->Bind();
+        Renderer::RenderFullscreenQuad(sceneColor, m_easuShader);
+
+        targetFrameBuffer->Bind();
+        m_rcasShader->SetUniform1f("u_Sharpness", m_sharpness);
+        Renderer::RenderFullscreenQuad(m_spatialBuffer, m_rcasShader);
+    }
+
+    std::shared_ptr<Shader> m_temporalShader;
+    std::shared_ptr<Shader> m_easuShader;
+    std::shared_ptr<Shader> m_rcasShader;
+    std::shared_ptr<FrameBuffer> m_history[2];
+    std::shared_ptr<FrameBuffer> m_spatialBuffer;
+    uint32_t m_historyIndex = 0;
+    bool m_historyValid = false;
+
+    float m_blendFactor = 0.1f;
+    float m_clampGamma = 1.0f;
+    float m_sharpness = 0.2f;
+};
+
+} // namespace Doodle
@@ -0,0 +1,180 @@
+#include "pch.h"
+#include <filesystem>
+
+#include "ApplicationEvent.h"
+#include "AssetManager.h"
+#include "EventManager.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "Shader.h"
+#include "Utils.h"
+
+namespace Doodle
+{
+
+static std::string GetAssetPath(const std::string &filepath)
+{
+    std::string path = std::filesystem::absolute(filepath).lexically_normal().generic_string();
+#ifdef DOO_PLATFORM_WINDOWS
+    std::transform(path.begin(), path.end(), path.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+    return path;
+}
+
+static uint64_t GetMeshMemorySize(const Mesh &mesh)
+{
+    return mesh.GetVertices().size() * sizeof(PackedVertex) + mesh.GetIndices().size() * sizeof(uint32_t);
+}
+
+static uint64_t GetModelMemorySize(const ModelNode &node)
+{
+    uint64_t size = 0;
+    for (const auto &[name, mesh] : node.Meshes)
+        size += GetMeshMemorySize(*mesh);
+    for (const auto &child : node.Children)
+        size += GetModelMemorySize(child);
+    return size;
+}
+
+void AssetManager::Initialize()
+{
+    EventManager::Get()->AddListener<AppUpdateEvent>(this, &AssetManager::OnUpdate, ExecutionOrder::Last);
+}
+
+void AssetManager::Deinitialize()
+{
+    EventManager::Get()->RemoveListener<AppUpdateEvent>(this, &AssetManager::OnUpdate);
+    // GL 资源需要在上下文销毁前释放
+    m_entries.clear();
+    m_stats = {};
+}
+
+std::shared_ptr<Texture2D> AssetManager::LoadTexture(const std::string &filepath, const TextureParams &params,
+                                                     bool async, std::shared_ptr<Texture2D> placeholder)
+{
+    return Load<Texture2D>(AssetType::Texture, GetTextureKey(GetAssetPath(filepath), params), [&]() {
+        return async ? Texture2D::CreateAsync(filepath, params, placeholder) : Texture2D::Create(filepath, params);
+    });
+}
+
+std::shared_ptr<Mesh> AssetManager::LoadMesh(const std::string &filepath)
+{
+    return Load<Mesh>(AssetType::Mesh, GetAssetPath(filepath), [&]() { return Mesh::Create(filepath); });
+}
+
+std::shared_ptr<Model> AssetManager::LoadModel(const std::string &filepath, const ModelProgressCallback &progress)
+{
+    return Load<Model>(AssetType::Model, GetAssetPath(filepath), [&]() -> std::shared_ptr<Model> {
+        auto model = Model::Create(filepath, progress);
+        return model->IsCancelled() ? nullptr : model;
+    });
+}
+
+std::shared_ptr<Shader> AssetManager::LoadShader(const std::string &filepath)
+{
+    return Load<Shader>(AssetType::Shader, GetAssetPath(filepath), [&]() { return Shader::Create(filepath); });
+}
+
+template <typename T>
+std::shared_ptr<T> AssetManager::Load(AssetType type, const std::string &key,
+                                      const std::function<std::shared_ptr<T>()> &create)
+{
+    // 不同类型的资源可能来自同一个文件
+    std::string typedKey = fmt::format("{}:{}", static_cast<int>(type), key);
+    auto it = m_entries.find(typedKey);
+    if (it != m_entries.end())
+    {
+        it->second.LastUsedFrame = m_frame;
+        return std::static_pointer_cast<T>(it->second.Asset);
+    }
+
+    std::shared_ptr<T> asset = create();
+    if (!asset)
+        return nullptr;
+    m_entries[typedKey] = {type, asset, m_frame};
+    return asset;
+}
+
+void AssetManager::OnUpdate()
+{
+    m_frame++;
+    UpdateStats();
+    Evict(false);
+}
+
+void AssetManager::Collect()
+{
+    Evict(true);
+    UpdateStats();
+}
+
+void AssetManager::UpdateStats()
+{
+    m_stats = {};
+    for (auto &[key, entry] : m_entries)
+    {
+        // 外部仍持有引用的资源视为本帧使用过
+        if (entry.Asset.use_count() > 1)
+            entry.LastUsedFrame = m_frame;
+
+        // 异步纹理上传前大小未知，每帧重新统计；网格与模型的大小加载后不再变化
+        switch (entry.Type)
+        {
+        case AssetType::Texture:
+            entry.GPUBytes = std::static_pointer_cast<Texture2D>(entry.Asset)->GetGPUMemorySize();
+            break;
+        case AssetType::Mesh:
+            if (entry.CPUBytes == 0)
+                entry.CPUBytes = GetMeshMemorySize(*std::static_pointer_cast<Mesh>(entry.Asset));
+            entry.GPUBytes = entry.CPUBytes;
+            break;
+        case AssetType::Model:
+            if (entry.CPUBytes == 0)
+                entry.CPUBytes = GetModelMemorySize(std::static_pointer_cast<Model>(entry.Asset)->GetRootNode());
+            entry.GPUBytes = entry.CPUBytes;
+            break;
+        default:
+            break;
+        }
+
+        AssetStats &stats = m_stats[static_cast<size_t>(entry.Type)];
+        stats.Count++;
+        stats.CPUBytes += entry.CPUBytes;
+        stats.GPUBytes += entry.GPUBytes;
+    }
+}
+
+void AssetManager::Evict(bool force)
+{
+    uint64_t cpuBytes = 0;
+    uint64_t gpuBytes = 0;
+    for (const auto &stats : m_stats)
+    {
+        cpuBytes += stats.CPUBytes;
+        gpuBytes += stats.GPUBytes;
+    }
+    if (!force && cpuBytes <= m_cpuBudget && gpuBytes <= m_gpuBudget)
+        return;
+
+    // 只有缓存自身持有引用的资源可以淘汰，按最近使用的帧从旧到新
+    std::vector<std::unordered_map<std::string, Entry>::iterator> candidates;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->second.Asset.use_count() == 1)
+            candidates.push_back(it);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b) { return a->second.LastUsedFrame < b->second.LastUsedFrame; });
+
+    for (auto it : candidates)
+    {
+        if (!force && cpuBytes <= m_cpuBudget && gpuBytes <= m_gpuBudget)
+            break;
+        cpuBytes -= it->second.CPUBytes;
+        gpuBytes -= it->second.GPUBytes;
+        DOO_CORE_TRACE("Evicting asset: {0}", it->first);
+        m_entries.erase(it);
+    }
+}
+
+} // namespace Doodle
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "pch.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Singleton.h"
+#include "Texture.h"
+#include "TextureParams.h"
+
+namespace Doodle
+{
+
+class Mesh;
+class Model;
+class Shader;
+
+enum class AssetType
+{
+    Texture = 0,
+    Mesh,
+    Model,
+    Shader,
+    Count
+};
+
+struct AssetStats
+{
+    uint32_t Count = 0;
+    uint64_t CPUBytes = 0;
+    uint64_t GPUBytes = 0;
+};
+
+// 进程内共享的资源缓存，键为规范化路径加导入参数。缓存持有每个资源的一个强引用，
+// 外部不再引用的资源保留到超出 CPU/显存预算时再按最近最少使用的顺序淘汰
+class DOO_API AssetManager : public Singleton<AssetManager>
+{
+public:
+    static constexpr uint64_t DEFAULT_CPU_BUDGET = 512ull * 1024 * 1024;
+    static constexpr uint64_t DEFAULT_GPU_BUDGET = 1024ull * 1024 * 1024;
+
+    void Initialize();
+    void Deinitialize();
+
+    // async 为 true 时通过 Texture2D::CreateAsync 加载，placeholder 只在首次加载时生效
+    std::shared_ptr<Texture2D> LoadTexture(const std::string &filepath, const TextureParams &params = TextureParams(),
+                                           bool async = false, std::shared_ptr<Texture2D> placeholder = nullptr);
+    std::shared_ptr<Mesh> LoadMesh(const std::string &filepath);
+    // progress 即 ModelProgressCallback，只在首次导入时调用；取消的导入返回空指针且不进入缓存
+    std::shared_ptr<Model> LoadModel(const std::string &filepath,
+                                     const std::function<bool(float progress)> &progress = nullptr);
+    std::shared_ptr<Shader> LoadShader(const std::string &filepath);
+
+    void SetBudget(uint64_t cpuBytes, uint64_t gpuBytes)
+    {
+        m_cpuBudget = cpuBytes;
+        m_gpuBudget = gpuBytes;
+    }
+
+    uint64_t GetCPUBudget() const
+    {
+        return m_cpuBudget;
+    }
+
+    uint64_t GetGPUBudget() const
+    {
+        return m_gpuBudget;
+    }
+
+    const AssetStats &GetStats(AssetType type) const
+    {
+        return m_stats[static_cast<size_t>(type)];
+    }
+
+    // 释放所有未被外部引用的资源
+    void Collect();
+
+private:
+    struct Entry
+    {
+        AssetType Type;
+        std::shared_ptr<void> Asset;
+        uint64_t LastUsedFrame = 0;
+        uint64_t CPUBytes = 0;
+        uint64_t GPUBytes = 0;
+    };
+
+    void OnUpdate();
+    void UpdateStats();
+    void Evict(bool force);
+
+    template <typename T>
+    std::shared_ptr<T> Load(AssetType type, const std::string &key, const std::function<std::shared_ptr<T>()> &create);
+
+    std::unordered_map<std::string, Entry> m_entries;
+    std::array<AssetStats, static_cast<size_t>(AssetType::Count)> m_stats;
+    uint64_t m_frame = 0;
+    uint64_t m_cpuBudget = DEFAULT_CPU_BUDGET;
+    uint64_t m_gpuBudget = DEFAULT_GPU_BUDGET;
+};
+
+} // namespace Doodle
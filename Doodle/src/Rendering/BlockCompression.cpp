@@ -0,0 +1,310 @@
+#include "pch.h"
+#include <cmath>
+#include <cstring>
+
+#include "BlockCompression.h"
+
+namespace Doodle
+{
+
+// BC6H/BC7 的 4 位索引插值权重
+static constexpr uint32_t WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// 按位从低到高写入块
+class BlockWriter
+{
+public:
+    BlockWriter(uint8_t *data, uint32_t size) : m_data(data)
+    {
+        std::memset(m_data, 0, size);
+    }
+
+    void Write(uint32_t value, uint32_t bits)
+    {
+        for (uint32_t i = 0; i < bits; i++, m_bit++)
+        {
+            if ((value >> i) & 1u)
+                m_data[m_bit >> 3] |= static_cast<uint8_t>(1u << (m_bit & 7u));
+        }
+    }
+
+private:
+    uint8_t *m_data;
+    uint32_t m_bit = 0;
+};
+
+// 主成分方向上的包围区间作为端点
+template <int N> static void FitEndpoints(const float pixels[16][N], float endpoint0[N], float endpoint1[N])
+{
+    float mean[N] = {};
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < N; c++)
+            mean[c] += pixels[i][c] / 16.0f;
+
+    float covariance[N][N] = {};
+    for (int i = 0; i < 16; i++)
+        for (int a = 0; a < N; a++)
+            for (int b = 0; b < N; b++)
+                covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+
+    // 幂迭代求最大特征向量
+    float axis[N];
+    for (int c = 0; c < N; c++)
+        axis[c] = 1.0f;
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[N] = {};
+        for (int a = 0; a < N; a++)
+            for (int b = 0; b < N; b++)
+                next[a] += covariance[a][b] * axis[b];
+        float length = 0.0f;
+        for (int c = 0; c < N; c++)
+            length = std::max(length, std::abs(next[c]));
+        if (length < 1e-8f)
+            break;
+        for (int c = 0; c < N; c++)
+            axis[c] = next[c] / length;
+    }
+
+    float minT = FLT_MAX, maxT = -FLT_MAX;
+    for (int i = 0; i < 16; i++)
+    {
+        float t = 0.0f;
+        for (int c = 0; c < N; c++)
+            t += (pixels[i][c] - mean[c]) * axis[c];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+
+    float lengthSquared = 0.0f;
+    for (int c = 0; c < N; c++)
+        lengthSquared += axis[c] * axis[c];
+    if (lengthSquared < 1e-8f)
+        lengthSquared = 1.0f;
+    for (int c = 0; c < N; c++)
+    {
+        endpoint0[c] = mean[c] + axis[c] * minT / lengthSquared;
+        endpoint1[c] = mean[c] + axis[c] * maxT / lengthSquared;
+    }
+}
+
+void BlockCompression::EncodeBC4Block(const uint8_t values[16], uint8_t *output)
+{
+    uint8_t minValue = 255, maxValue = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+
+    BlockWriter writer(output, BC4_BLOCK_SIZE);
+    writer.Write(maxValue, 8);
+    writer.Write(minValue, 8);
+    if (maxValue == minValue)
+        return;
+
+    // red0 > red1 时为 8 级插值：0 为最大值，1 为最小值，2..7 依次从最大值过渡到最小值
+    int palette[8];
+    palette[0] = maxValue;
+    palette[1] = minValue;
+    for (int i = 2; i < 8; i++)
+        palette[i] = ((8 - i) * maxValue + (i - 1) * minValue + 3) / 7;
+
+    for (int i = 0; i < 16; i++)
+    {
+        uint32_t bestIndex = 0;
+        int bestError = INT_MAX;
+        for (uint32_t index = 0; index < 8; index++)
+        {
+            int error = std::abs(palette[index] - values[i]);
+            if (error < bestError)
+            {
+                bestError = error;
+                bestIndex = index;
+            }
+        }
+        writer.Write(bestIndex, 3);
+    }
+}
+
+void BlockCompression::EncodeBC5Block(const uint8_t red[16], const uint8_t green[16], uint8_t *output)
+{
+    EncodeBC4Block(red, output);
+    EncodeBC4Block(green, output + BC4_BLOCK_SIZE);
+}
+
+void BlockCompression::EncodeBC7Block(const uint8_t rgba[16 * 4], uint8_t *output)
+{
+    float pixels[16][4];
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 4; c++)
+            pixels[i][c] = rgba[i * 4 + c];
+
+    float endpoint0[4], endpoint1[4];
+    FitEndpoints<4>(pixels, endpoint0, endpoint1);
+
+    // 尝试 4 种 p 位组合，取误差最小的量化结果
+    uint32_t bestQuantized[2][4] = {};
+    uint32_t bestPBits[2] = {};
+    uint32_t bestIndices[16] = {};
+    uint64_t bestError = UINT64_MAX;
+    for (uint32_t pBits = 0; pBits < 4; pBits++)
+    {
+        uint32_t p[2] = {pBits & 1u, pBits >> 1};
+        uint32_t quantized[2][4];
+        int endpoints[2][4];
+        for (int c = 0; c < 4; c++)
+        {
+            quantized[0][c] = static_cast<uint32_t>(std::clamp(std::lround((endpoint0[c] - p[0]) / 2.0f), 0l, 127l));
+            quantized[1][c] = static_cast<uint32_t>(std::clamp(std::lround((endpoint1[c] - p[1]) / 2.0f), 0l, 127l));
+            endpoints[0][c] = static_cast<int>((quantized[0][c] << 1) | p[0]);
+            endpoints[1][c] = static_cast<int>((quantized[1][c] << 1) | p[1]);
+        }
+
+        int palette[16][4];
+        for (int index = 0; index < 16; index++)
+            for (int c = 0; c < 4; c++)
+                palette[index][c] =
+                    ((64 - WEIGHTS4[index]) * endpoints[0][c] + WEIGHTS4[index] * endpoints[1][c] + 32) >> 6;
+
+        uint64_t error = 0;
+        uint32_t indices[16];
+        for (int i = 0; i < 16; i++)
+        {
+            int bestPixelError = INT_MAX;
+            for (uint32_t index = 0; index < 16; index++)
+            {
+                int pixelError = 0;
+                for (int c = 0; c < 4; c++)
+                {
+                    int difference = palette[index][c] - rgba[i * 4 + c];
+                    pixelError += difference * difference;
+                }
+                if (pixelError < bestPixelError)
+                {
+                    bestPixelError = pixelError;
+                    indices[i] = index;
+                }
+            }
+            error += bestPixelError;
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            std::memcpy(bestQuantized, quantized, sizeof(quantized));
+            bestPBits[0] = p[0];
+            bestPBits[1] = p[1];
+            std::memcpy(bestIndices, indices, sizeof(indices));
+        }
+    }
+
+    // 第一个索引的最高位隐含为 0，否则交换端点并翻转索引
+    if (bestIndices[0] & 8u)
+    {
+        std::swap(bestQuantized[0], bestQuantized[1]);
+        std::swap(bestPBits[0], bestPBits[1]);
+        for (auto &index : bestIndices)
+            index = 15u - index;
+    }
+
+    BlockWriter writer(output, BC7_BLOCK_SIZE);
+    writer.Write(1u << 6, 7);
+    for (int c = 0; c < 4; c++)
+    {
+        writer.Write(bestQuantized[0][c], 7);
+        writer.Write(bestQuantized[1][c], 7);
+    }
+    writer.Write(bestPBits[0], 1);
+    writer.Write(bestPBits[1], 1);
+    writer.Write(bestIndices[0], 3);
+    for (int i = 1; i < 16; i++)
+        writer.Write(bestIndices[i], 4);
+}
+
+// 无符号 BC6H 的端点反量化，结果再乘 31/64 即为半精度浮点的位模式
+static uint32_t UnquantizeBC6H(uint32_t value)
+{
+    if (value == 0)
+        return 0;
+    if (value == 1023)
+        return 0xFFFF;
+    return ((value << 16) + 0x8000) >> 10;
+}
+
+void BlockCompression::EncodeBC6HBlock(const uint16_t rgbHalf[16 * 3], uint8_t *output)
+{
+    // 在半精度位模式对应的线性域中拟合端点，负数与 NaN 截断为 0 与最大值
+    float pixels[16][3];
+    uint32_t halves[16][3];
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            uint32_t half = rgbHalf[i * 3 + c];
+            if (half & 0x8000u)
+                half = 0;
+            half = std::min(half, 0x7BFFu);
+            halves[i][c] = half;
+            pixels[i][c] = static_cast<float>(half) * 64.0f / 31.0f;
+        }
+    }
+
+    float endpoint0[3], endpoint1[3];
+    FitEndpoints<3>(pixels, endpoint0, endpoint1);
+
+    uint32_t quantized[2][3];
+    int endpoints[2][3];
+    for (int c = 0; c < 3; c++)
+    {
+        quantized[0][c] = static_cast<uint32_t>(std::clamp(std::lround(endpoint0[c] * 1023.0f / 65535.0f), 0l, 1023l));
+        quantized[1][c] = static_cast<uint32_t>(std::clamp(std::lround(endpoint1[c] * 1023.0f / 65535.0f), 0l, 1023l));
+        endpoints[0][c] = static_cast<int>(UnquantizeBC6H(quantized[0][c]));
+        endpoints[1][c] = static_cast<int>(UnquantizeBC6H(quantized[1][c]));
+    }
+
+    int64_t palette[16][3];
+    for (int index = 0; index < 16; index++)
+        for (int c = 0; c < 3; c++)
+            palette[index][c] =
+                ((((64 - WEIGHTS4[index]) * endpoints[0][c] + WEIGHTS4[index] * endpoints[1][c] + 32) >> 6) * 31) >> 6;
+
+    // 在半精度位模式上比较误差，近似于对数域
+    uint32_t indices[16];
+    for (int i = 0; i < 16; i++)
+    {
+        int64_t bestError = INT64_MAX;
+        for (uint32_t index = 0; index < 16; index++)
+        {
+            int64_t error = 0;
+            for (int c = 0; c < 3; c++)
+            {
+                int64_t difference = palette[index][c] - static_cast<int64_t>(halves[i][c]);
+                error += difference * difference;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[i] = index;
+            }
+        }
+    }
+
+    if (indices[0] & 8u)
+    {
+        std::swap(quantized[0], quantized[1]);
+        for (auto &index : indices)
+            index = 15u - index;
+    }
+
+    BlockWriter writer(output, BC6H_BLOCK_SIZE);
+    writer.Write(0x03, 5);
+    for (int endpoint = 0; endpoint < 2; endpoint++)
+        for (int c = 0; c < 3; c++)
+            writer.Write(quantized[endpoint][c], 10);
+    writer.Write(indices[0], 3);
+    for (int i = 1; i < 16; i++)
+        writer.Write(indices[i], 4);
+}
+
+} // namespace Doodle
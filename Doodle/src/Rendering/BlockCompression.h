@@ -0,0 +1,28 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+
+namespace Doodle
+{
+
+// BC 格式的 4x4 块编码器，只在 CPU 上运行，可以在多个线程上同时调用
+class DOO_API BlockCompression
+{
+public:
+    static constexpr uint32_t BC4_BLOCK_SIZE = 8;
+    static constexpr uint32_t BC5_BLOCK_SIZE = 16;
+    static constexpr uint32_t BC6H_BLOCK_SIZE = 16;
+    static constexpr uint32_t BC7_BLOCK_SIZE = 16;
+
+    // 单通道，8 级插值
+    static void EncodeBC4Block(const uint8_t values[16], uint8_t *output);
+    // 两个独立的 BC4 通道，用于切线空间法线的 xy
+    static void EncodeBC5Block(const uint8_t red[16], const uint8_t green[16], uint8_t *output);
+    // 模式 6：单分区 RGBA，7 位端点加 p 位，4 位索引
+    static void EncodeBC7Block(const uint8_t rgba[16 * 4], uint8_t *output);
+    // 模式 11：单区域无符号半精度 RGB，10 位端点，4 位索引
+    static void EncodeBC6HBlock(const uint16_t rgbHalf[16 * 3], uint8_t *output);
+};
+
+} // namespace Doodle
@@ -0,0 +1,147 @@
+#include "pch.h"
+#include <cstring>
+#include <glad/glad.h>
+
+#include "EnvironmentCache.h"
+#include "FileSystem.h"
+#include "Log.h"
+#include "Renderer.h"
+#include "Utils.h"
+
+namespace Doodle
+{
+
+static constexpr char ENVIRONMENT_CACHE_MAGIC[4] = {'D', 'E', 'N', 'V'};
+static constexpr const char *ENVIRONMENT_CACHE_DIRECTORY = "cache/environments";
+
+struct EnvironmentCacheHeader
+{
+    char Magic[4];
+    uint32_t Version;
+    uint32_t CubemapSize;
+    uint32_t RadianceMipCount;
+};
+
+static uint64_t GetCubeLevelSize(uint32_t size, uint32_t level)
+{
+    uint64_t levelSize = std::max(size >> level, 1u);
+    return levelSize * levelSize * 6 * 4 * sizeof(uint16_t);
+}
+
+static uint64_t GetCacheSize(uint32_t cubemapSize, uint32_t radianceMipCount)
+{
+    uint64_t size = sizeof(EnvironmentCacheHeader) + sizeof(IrradianceSH::Coefficients);
+    for (uint32_t level = 0; level < radianceMipCount; level++)
+        size += GetCubeLevelSize(cubemapSize, level);
+    return size;
+}
+
+std::filesystem::path EnvironmentCache::GetCachePath(const std::string &filepath, uint32_t cubemapSize)
+{
+    // 只按路径、大小与修改时间判断源文件是否变化，避免每次启动都读取整个 HDR
+    uint32_t parameters[] = {VERSION, cubemapSize};
+    uint64_t key = HashBytes(parameters, sizeof(parameters), HashFileStamp(filepath));
+    return std::filesystem::path(ENVIRONMENT_CACHE_DIRECTORY) / fmt::format("{:016x}.denv", key);
+}
+
+Buffer EnvironmentCache::Read(const std::filesystem::path &cachePath)
+{
+    Buffer buffer = FileSystem::ReadBytes(cachePath);
+    if (!buffer)
+        return buffer;
+
+    bool valid = buffer.Size >= sizeof(EnvironmentCacheHeader);
+    if (valid)
+    {
+        const auto &header = buffer.Read<EnvironmentCacheHeader>();
+        valid = std::memcmp(header.Magic, ENVIRONMENT_CACHE_MAGIC, sizeof(header.Magic)) == 0 &&
+                header.Version == VERSION && buffer.Size == GetCacheSize(header.CubemapSize, header.RadianceMipCount);
+    }
+    if (!valid)
+    {
+        DOO_CORE_WARN("Invalid environment cache: {0}", cachePath.string());
+        buffer.Release();
+    }
+    return buffer;
+}
+
+std::shared_ptr<TextureCube> EnvironmentCache::CreateRadianceMap(const Buffer &buffer)
+{
+    const auto &header = buffer.Read<EnvironmentCacheHeader>();
+    TextureParams params;
+    params.Width = header.CubemapSize;
+    params.Height = header.CubemapSize;
+    params.Format = TextureFormat::RGBA16F;
+    params.Wrap = TextureWrap::ClampToEdge;
+    params.Filter = TextureFilter::MipmapLinear;
+    auto radianceMap = TextureCube::Create(params);
+    if (radianceMap->GetMipLevelCount() != header.RadianceMipCount)
+    {
+        DOO_CORE_WARN("Environment cache mip count mismatch");
+        return nullptr;
+    }
+    return radianceMap;
+}
+
+std::shared_ptr<IrradianceSH> EnvironmentCache::CreateIrradiance(const Buffer &buffer)
+{
+    auto irradiance = std::make_shared<IrradianceSH>();
+    std::memcpy(irradiance->Coefficients, buffer.As<std::byte>() + sizeof(EnvironmentCacheHeader),
+                sizeof(IrradianceSH::Coefficients));
+    return irradiance;
+}
+
+uint64_t EnvironmentCache::UploadRadianceFace(std::shared_ptr<TextureCube> radianceMap, const Buffer &buffer,
+                                              uint32_t level, uint32_t face)
+{
+    uint32_t cubemapSize = radianceMap->GetWidth();
+    uint64_t offset = sizeof(EnvironmentCacheHeader) + sizeof(IrradianceSH::Coefficients);
+    for (uint32_t i = 0; i < level; i++)
+        offset += GetCubeLevelSize(cubemapSize, i);
+    uint64_t faceSize = GetCubeLevelSize(cubemapSize, level) / 6;
+    offset += face * faceSize;
+
+    const auto *data = buffer.As<std::byte>() + offset;
+    Renderer::Submit([radianceMap, level, face, data]() {
+        GLsizei size = static_cast<GLsizei>(std::max(radianceMap->GetWidth() >> level, 1u));
+        glTextureSubImage3D(radianceMap->GetRendererID(), level, 0, 0, face, size, size, 1, GL_RGBA, GL_HALF_FLOAT,
+                            data);
+    });
+    return faceSize;
+}
+
+void EnvironmentCache::Save(const std::filesystem::path &cachePath, std::shared_ptr<TextureCube> radianceMap,
+                            std::shared_ptr<IrradianceSH> irradiance)
+{
+    // 球谐系数需要已经回读，或者回读命令在此之前提交
+    Renderer::Submit([cachePath, radianceMap, irradiance]() {
+        // 预过滤通过 image store 写入，回读前需要屏障
+        glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+        EnvironmentCacheHeader header = {};
+        std::memcpy(header.Magic, ENVIRONMENT_CACHE_MAGIC, sizeof(header.Magic));
+        header.Version = VERSION;
+        header.CubemapSize = radianceMap->GetWidth();
+        header.RadianceMipCount = radianceMap->GetMipLevelCount();
+
+        Buffer buffer;
+        buffer.Allocate(GetCacheSize(header.CubemapSize, header.RadianceMipCount));
+        buffer.Write(&header, sizeof(header));
+        buffer.Write(irradiance->Coefficients, sizeof(IrradianceSH::Coefficients), sizeof(header));
+
+        uint64_t offset = sizeof(EnvironmentCacheHeader) + sizeof(IrradianceSH::Coefficients);
+        for (uint32_t level = 0; level < header.RadianceMipCount; level++)
+        {
+            uint64_t levelSize = GetCubeLevelSize(header.CubemapSize, level);
+            glGetTextureImage(radianceMap->GetRendererID(), level, GL_RGBA, GL_HALF_FLOAT,
+                              static_cast<GLsizei>(levelSize), buffer.As<std::byte>() + offset);
+            offset += levelSize;
+        }
+
+        if (FileSystem::WriteBytesAtomic(cachePath, buffer))
+            DOO_CORE_TRACE("Environment cache written: {0}", cachePath.string());
+        buffer.Release();
+    });
+}
+
+} // namespace Doodle
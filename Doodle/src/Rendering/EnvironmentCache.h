@@ -0,0 +1,39 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "Buffer.h"
+#include "IrradianceSH.h"
+#include "Texture.h"
+
+namespace Doodle
+{
+
+// 预过滤环境贴图的磁盘缓存，文件名由源文件路径、大小、修改时间与预过滤参数的哈希决定，
+// 保存辐照度的球谐系数与辐射度立方体贴图的全部 mip（半精度浮点）
+class DOO_API EnvironmentCache
+{
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    static std::filesystem::path GetCachePath(const std::string &filepath, uint32_t cubemapSize);
+
+    // 读取并校验缓存文件，可以在工作线程调用，失败时返回空的 Buffer
+    static Buffer Read(const std::filesystem::path &cachePath);
+
+    // 以下在主线程调用，buffer 为 Read 的结果。只分配存储，mip 数与当前实现不一致时返回空
+    static std::shared_ptr<TextureCube> CreateRadianceMap(const Buffer &buffer);
+    static std::shared_ptr<IrradianceSH> CreateIrradiance(const Buffer &buffer);
+    // 上传一个面的一级 mip，buffer 需要保持有效直到渲染队列执行，返回上传的字节数
+    static uint64_t UploadRadianceFace(std::shared_ptr<TextureCube> radianceMap, const Buffer &buffer,
+                                       uint32_t level, uint32_t face);
+
+    // 在已提交的预过滤与球谐回读命令之后读取结果并写入缓存
+    static void Save(const std::filesystem::path &cachePath, std::shared_ptr<TextureCube> radianceMap,
+                     std::shared_ptr<IrradianceSH> irradiance);
+};
+
+} // namespace Doodle
@@ -0,0 +1,231 @@
+#include "pch.h"
+#include <glad/glad.h>
+#include <thread>
+
+#include "AssetManager.h"
+#include "EnvironmentCache.h"
+#include "EnvironmentLoader.h"
+#include "FileSystem.h"
+#include "Renderer.h"
+#include "ThreadPool.h"
+
+namespace Doodle
+{
+
+static constexpr uint32_t CONVERSION_GROUP_SIZE = 32;
+
+static TextureParams GetEquirectangularParams()
+{
+    TextureParams params;
+    params.Format = TextureFormat::RGBA16F;
+    params.Compression = TextureCompression::BC6H;
+    return params;
+}
+
+static ThreadPool &GetEnvironmentWorkers()
+{
+    // 同一时间通常只有一个环境在加载，一个线程足够
+    static ThreadPool s_Workers(1);
+    return s_Workers;
+}
+
+std::shared_ptr<EnvironmentLoader> EnvironmentLoader::Create(const std::string &filepath, uint32_t cubemapSize)
+{
+    return std::make_shared<EnvironmentLoader>(filepath, cubemapSize);
+}
+
+EnvironmentLoader::EnvironmentLoader(const std::string &filepath, uint32_t cubemapSize)
+    : m_filepath(filepath), m_cubemapSize(cubemapSize)
+{
+    m_cachePath = EnvironmentCache::GetCachePath(filepath, cubemapSize);
+    if (!FileSystem::Exists(m_cachePath))
+    {
+        StartDecoding();
+        return;
+    }
+
+    m_stage = Stage::ReadingCache;
+    m_cacheRead = std::make_shared<CacheRead>();
+    GetEnvironmentWorkers().Enqueue([cacheRead = m_cacheRead, cachePath = m_cachePath]() {
+        cacheRead->Data = EnvironmentCache::Read(cachePath);
+        cacheRead->Done.store(true, std::memory_order_release);
+    });
+}
+
+bool EnvironmentLoader::Update()
+{
+    switch (m_stage)
+    {
+    case Stage::ReadingCache:
+        if (m_cacheRead->Done.load(std::memory_order_acquire))
+            OnCacheRead();
+        break;
+    case Stage::UploadingCache:
+        UploadCache(UPLOAD_BUDGET);
+        break;
+    case Stage::Decoding:
+        if (m_equirect->IsLoaded())
+            StartConversion();
+        break;
+    case Stage::Converting:
+        SubmitConversion(CONVERSION_BUDGET);
+        break;
+    case Stage::Filtering:
+        m_prefilter->Update();
+        m_irradiance->Resolve();
+        if (m_prefilter->IsComplete() && m_irradiance->IsReady())
+            FinishFiltering();
+        break;
+    case Stage::Complete:
+        break;
+    }
+    return IsComplete();
+}
+
+void EnvironmentLoader::Flush()
+{
+    if (m_stage == Stage::ReadingCache)
+    {
+        while (!m_cacheRead->Done.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        OnCacheRead();
+    }
+    if (m_stage == Stage::UploadingCache)
+        UploadCache(UINT64_MAX);
+    if (m_stage == Stage::Decoding)
+    {
+        if (!m_equirect->IsLoaded())
+            m_equirect = Texture2D::Create(m_filepath, GetEquirectangularParams());
+        StartConversion();
+    }
+    if (m_stage == Stage::Converting)
+        SubmitConversion(UINT64_MAX);
+    if (m_stage == Stage::Filtering)
+    {
+        m_prefilter->Flush();
+        m_irradiance->Resolve(true);
+        FinishFiltering();
+    }
+}
+
+void EnvironmentLoader::StartDecoding()
+{
+    m_equirect = Texture2D::CreateAsync(m_filepath, GetEquirectangularParams());
+    m_stage = Stage::Decoding;
+}
+
+void EnvironmentLoader::OnCacheRead()
+{
+    const Buffer &buffer = m_cacheRead->Data;
+    if (buffer)
+        m_cachedRadianceMap = EnvironmentCache::CreateRadianceMap(buffer);
+    if (!m_cachedRadianceMap)
+    {
+        m_cacheRead = nullptr;
+        StartDecoding();
+        return;
+    }
+
+    m_irradiance = EnvironmentCache::CreateIrradiance(buffer);
+    for (uint32_t level = 0; level < m_cachedRadianceMap->GetMipLevelCount(); level++)
+        for (int32_t face = 0; face < 6; face++)
+            m_workItems.push_back({level, 0, face, 0});
+    m_nextItem = 0;
+    m_stage = Stage::UploadingCache;
+}
+
+void EnvironmentLoader::UploadCache(uint64_t budgetBytes)
+{
+    // 至少上传一个面，保证进度
+    uint64_t bytes = 0;
+    do
+    {
+        const WorkItem &item = m_workItems[m_nextItem++];
+        bytes += EnvironmentCache::UploadRadianceFace(m_cachedRadianceMap, m_cacheRead->Data, item.Level, item.Face);
+    } while (m_nextItem < m_workItems.size() && bytes < budgetBytes);
+    // 上传命令执行前保持数据存活
+    Renderer::Submit([cacheRead = m_cacheRead]() {});
+
+    if (m_nextItem < m_workItems.size())
+        return;
+    m_radianceMap = m_cachedRadianceMap;
+    m_cachedRadianceMap = nullptr;
+    m_cacheRead = nullptr;
+    m_workItems.clear();
+    m_stage = Stage::Complete;
+}
+
+void EnvironmentLoader::StartConversion()
+{
+    DOO_CORE_ASSERT(m_equirect->GetFormat() == TextureFormat::RGBA16F, "Texture is not HDR!");
+
+    TextureParams params;
+    params.Width = m_cubemapSize;
+    params.Height = m_cubemapSize;
+    params.Format = TextureFormat::RGBA16F;
+    params.Wrap = TextureWrap::ClampToEdge;
+    params.Filter = TextureFilter::MipmapLinear;
+    m_unfiltered = TextureCube::Create(params);
+    m_conversionShader = AssetManager::Get()->LoadShader("assets/shaders/equirectangularToCubeMap.glsl");
+
+    // 按整行工作组切成条带，每条不超过一帧的预算
+    uint32_t rows = static_cast<uint32_t>(CONVERSION_BUDGET / m_cubemapSize) / CONVERSION_GROUP_SIZE;
+    rows = std::min(std::max(rows, 1u) * CONVERSION_GROUP_SIZE, m_cubemapSize);
+    m_workItems.clear();
+    for (int32_t face = 0; face < 6; face++)
+        for (uint32_t y = 0; y < m_cubemapSize; y += rows)
+            m_workItems.push_back({0, static_cast<int32_t>(y), face, std::min(rows, m_cubemapSize - y)});
+    m_nextItem = 0;
+    m_stage = Stage::Converting;
+}
+
+void EnvironmentLoader::SubmitConversion(uint64_t budgetTexels)
+{
+    size_t begin = m_nextItem;
+    uint64_t texels = 0;
+    do
+    {
+        texels += static_cast<uint64_t>(m_workItems[m_nextItem++].Rows) * m_cubemapSize;
+    } while (m_nextItem < m_workItems.size() &&
+             texels + static_cast<uint64_t>(m_workItems[m_nextItem].Rows) * m_cubemapSize <= budgetTexels);
+
+    std::vector<WorkItem> items(m_workItems.begin() + begin, m_workItems.begin() + m_nextItem);
+    Renderer::Submit([shader = m_conversionShader, equirect = m_equirect, cubemap = m_unfiltered, items]() {
+        GLuint program = shader->GetRendererID();
+        glUseProgram(program);
+        glBindTextureUnit(0, equirect->GetRendererID());
+        glBindImageTexture(0, cubemap->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        GLuint groupsX = std::max(cubemap->GetWidth() / CONVERSION_GROUP_SIZE, 1u);
+        for (const WorkItem &item : items)
+        {
+            glProgramUniform3i(program, 0, 0, item.Y, item.Face);
+            glDispatchCompute(groupsX, std::max(item.Rows / CONVERSION_GROUP_SIZE, 1u), 1);
+        }
+        glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+    });
+
+    if (m_nextItem < m_workItems.size())
+        return;
+
+    Renderer::Submit([unfiltered = m_unfiltered]() { glGenerateTextureMipmap(unfiltered->GetRendererID()); });
+    m_equirect = nullptr;
+    m_conversionShader = nullptr;
+    m_workItems.clear();
+
+    // 先使用未过滤的 mip 链，预过滤在之后的帧中按时间预算完成后再替换
+    m_irradiance = IrradianceSH::Project(m_unfiltered);
+    m_prefilter = EnvironmentPrefilter::Create(m_unfiltered);
+    m_radianceMap = m_prefilter->GetPreviewRadianceMap();
+    m_unfiltered = nullptr;
+    m_stage = Stage::Filtering;
+}
+
+void EnvironmentLoader::FinishFiltering()
+{
+    m_radianceMap = m_prefilter->GetRadianceMap();
+    EnvironmentCache::Save(m_cachePath, m_radianceMap, m_irradiance);
+    m_prefilter = nullptr;
+    m_stage = Stage::Complete;
+}
+
+} // namespace Doodle
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "pch.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "Buffer.h"
+#include "EnvironmentPrefilter.h"
+#include "IrradianceSH.h"
+#include "Shader.h"
+#include "Texture.h"
+
+namespace Doodle
+{
+
+// 环境贴图的分帧加载：缓存文件的读取与 HDR 解码在工作线程完成，缓存数据的上传、等距柱状投影到立方体贴图的转换
+// 与 GGX 预过滤按每帧预算切片提交，球谐系数通过栅栏在之后的帧中读取，整个过程不阻塞主线程
+class DOO_API EnvironmentLoader : public std::enable_shared_from_this<EnvironmentLoader>
+{
+public:
+    static constexpr uint32_t DEFAULT_CUBEMAP_SIZE = 2048;
+    static constexpr uint64_t UPLOAD_BUDGET = 32ull * 1024 * 1024;
+    // 每帧转换的立方体贴图像素数
+    static constexpr uint64_t CONVERSION_BUDGET = 1024ull * 1024;
+
+    static std::shared_ptr<EnvironmentLoader> Create(const std::string &filepath,
+                                                     uint32_t cubemapSize = DEFAULT_CUBEMAP_SIZE);
+
+    EnvironmentLoader(const std::string &filepath, uint32_t cubemapSize);
+
+    // 推进一帧的工作，全部完成后返回 true
+    bool Update();
+    // 在本帧内提交全部剩余工作，会阻塞到解码完成，球谐系数在本帧的渲染队列中读取
+    void Flush();
+
+    bool IsComplete() const
+    {
+        return m_stage == Stage::Complete;
+    }
+
+    // 预过滤完成前为未过滤的 mip 链，还没有可用的结果时为空
+    std::shared_ptr<TextureCube> GetRadianceMap() const
+    {
+        return m_radianceMap;
+    }
+
+    // 投影开始后即返回，系数在 IsReady 之前为零
+    std::shared_ptr<IrradianceSH> GetIrradiance() const
+    {
+        return m_irradiance;
+    }
+
+private:
+    enum class Stage
+    {
+        ReadingCache,
+        UploadingCache,
+        Decoding,
+        Converting,
+        Filtering,
+        Complete
+    };
+
+    // 工作线程与上传命令共享，最后一个引用释放时才释放数据
+    struct CacheRead
+    {
+        std::atomic<bool> Done = false;
+        Buffer Data;
+
+        ~CacheRead()
+        {
+            Data.Release();
+        }
+    };
+
+    struct WorkItem
+    {
+        uint32_t Level;
+        int32_t Y, Face;
+        uint32_t Rows;
+    };
+
+    void StartDecoding();
+    void OnCacheRead();
+    void UploadCache(uint64_t budgetBytes);
+    void StartConversion();
+    void SubmitConversion(uint64_t budgetTexels);
+    void FinishFiltering();
+
+    std::string m_filepath;
+    std::filesystem::path m_cachePath;
+    uint32_t m_cubemapSize;
+    Stage m_stage = Stage::Decoding;
+
+    std::shared_ptr<CacheRead> m_cacheRead;
+    std::shared_ptr<TextureCube> m_cachedRadianceMap;
+
+    std::shared_ptr<Texture2D> m_equirect;
+    std::shared_ptr<TextureCube> m_unfiltered;
+    std::shared_ptr<Shader> m_conversionShader;
+    std::shared_ptr<EnvironmentPrefilter> m_prefilter;
+
+    std::vector<WorkItem> m_workItems;
+    size_t m_nextItem = 0;
+
+    std::shared_ptr<TextureCube> m_radianceMap;
+    std::shared_ptr<IrradianceSH> m_irradiance;
+};
+
+} // namespace Doodle
@@ -0,0 +1,144 @@
+#include "pch.h"
+#include <glad/glad.h>
+
+#include "EnvironmentPrefilter.h"
+#include "Renderer.h"
+#include "ShaderLibrary.h"
+
+namespace Doodle
+{
+
+static constexpr uint32_t GROUP_SIZE = 32;
+static constexpr uint64_t FILTER_SAMPLE_COUNT = 1024;
+// 没有计时结果前每帧提交的采样数
+static constexpr uint64_t INITIAL_SAMPLE_BUDGET = 8 * GROUP_SIZE * GROUP_SIZE * FILTER_SAMPLE_COUNT;
+
+std::shared_ptr<EnvironmentPrefilter> EnvironmentPrefilter::Create(std::shared_ptr<TextureCube> source)
+{
+    return std::make_shared<EnvironmentPrefilter>(source);
+}
+
+EnvironmentPrefilter::EnvironmentPrefilter(std::shared_ptr<TextureCube> source) : m_source(source)
+{
+    m_filterShader = ShaderLibrary::Get()->GetShader("environmentMipFilter");
+
+    TextureParams params;
+    params.Width = source->GetWidth();
+    params.Height = source->GetHeight();
+    params.Format = TextureFormat::RGBA16F;
+    params.Wrap = TextureWrap::ClampToEdge;
+    params.Filter = TextureFilter::MipmapLinear;
+    m_radianceMap = TextureCube::Create(params);
+
+    // 第 0 级即原始辐射度，直接复制
+    Renderer::Submit([source, radianceMap = m_radianceMap]() {
+        glCopyImageSubData(source->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0, radianceMap->GetRendererID(),
+                           GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0, radianceMap->GetWidth(), radianceMap->GetHeight(), 6);
+    });
+
+    uint32_t cubemapSize = source->GetWidth();
+    for (uint32_t level = 1; level < m_radianceMap->GetMipLevelCount(); level++)
+    {
+        uint32_t size = std::max(cubemapSize >> level, 1u);
+        uint32_t tileSize = std::min(size, GROUP_SIZE);
+        for (int32_t face = 0; face < 6; face++)
+            for (uint32_t y = 0; y < size; y += GROUP_SIZE)
+                for (uint32_t x = 0; x < size; x += GROUP_SIZE)
+                    m_workItems.push_back({level, static_cast<int32_t>(x), static_cast<int32_t>(y), face,
+                                           tileSize * tileSize * FILTER_SAMPLE_COUNT});
+    }
+}
+
+EnvironmentPrefilter::~EnvironmentPrefilter()
+{
+    if (m_queries[0])
+        glDeleteQueries(2, m_queries);
+}
+
+bool EnvironmentPrefilter::Update(float budgetMs)
+{
+    if (IsComplete())
+        return true;
+
+    uint64_t sampleBudget = INITIAL_SAMPLE_BUDGET;
+    if (m_nanosecondsPerSample > 0.0)
+        sampleBudget = static_cast<uint64_t>(budgetMs * 1e6 / m_nanosecondsPerSample);
+
+    // 至少提交一个切片，保证进度
+    size_t begin = m_nextItem;
+    uint64_t cost = m_workItems[m_nextItem++].Cost;
+    while (m_nextItem < m_workItems.size() && cost + m_workItems[m_nextItem].Cost <= sampleBudget)
+        cost += m_workItems[m_nextItem++].Cost;
+
+    SubmitItems(begin, m_nextItem);
+    return IsComplete();
+}
+
+void EnvironmentPrefilter::Flush()
+{
+    if (IsComplete())
+        return;
+    size_t begin = m_nextItem;
+    m_nextItem = m_workItems.size();
+    SubmitItems(begin, m_nextItem);
+}
+
+void EnvironmentPrefilter::SubmitItems(size_t begin, size_t end)
+{
+    uint64_t cost = 0;
+    for (size_t i = begin; i < end; i++)
+        cost += m_workItems[i].Cost;
+
+    Renderer::Submit([self = shared_from_this(), begin, end, cost]() {
+        if (!self->m_queries[0])
+            glCreateQueries(GL_TIME_ELAPSED, 2, self->m_queries);
+
+        // 之前切片的计时结果可用时更新单位采样耗时
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            if (self->m_queryCosts[i] == 0)
+                continue;
+            GLint available = 0;
+            glGetQueryObjectiv(self->m_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(self->m_queries[i], GL_QUERY_RESULT, &elapsed);
+            double nanosecondsPerSample = static_cast<double>(elapsed) / static_cast<double>(self->m_queryCosts[i]);
+            self->m_nanosecondsPerSample = self->m_nanosecondsPerSample > 0.0
+                                               ? 0.5 * (self->m_nanosecondsPerSample + nanosecondsPerSample)
+                                               : nanosecondsPerSample;
+            self->m_queryCosts[i] = 0;
+        }
+
+        // 上一次的结果还没读取时不复用同一个查询对象
+        bool timed = self->m_queryCosts[self->m_queryIndex] == 0;
+        if (timed)
+            glBeginQuery(GL_TIME_ELAPSED, self->m_queries[self->m_queryIndex]);
+
+        GLuint filterProgram = self->m_filterShader->GetRendererID();
+        glUseProgram(filterProgram);
+        glBindTextureUnit(0, self->m_source->GetRendererID());
+
+        const float DELTA_ROUGHNESS = 1.0f / std::max(self->m_radianceMap->GetMipLevelCount() - 1.0f, 1.0f);
+        for (size_t i = begin; i < end; i++)
+        {
+            const WorkItem &item = self->m_workItems[i];
+            glBindImageTexture(0, self->m_radianceMap->GetRendererID(), item.Level, GL_TRUE, 0, GL_WRITE_ONLY,
+                               GL_RGBA16F);
+            glProgramUniform1f(filterProgram, 0, item.Level * DELTA_ROUGHNESS);
+            glProgramUniform3i(filterProgram, 1, item.X, item.Y, item.Face);
+            glDispatchCompute(1, 1, 1);
+        }
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+        if (timed)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            self->m_queryCosts[self->m_queryIndex] = cost;
+            self->m_queryIndex = 1 - self->m_queryIndex;
+        }
+    });
+}
+
+} // namespace Doodle
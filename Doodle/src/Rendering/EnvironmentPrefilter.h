@@ -0,0 +1,71 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Shader.h"
+#include "Texture.h"
+
+namespace Doodle
+{
+
+// 环境贴图的 GGX 预过滤。工作按 32x32 的计算工作组切片，
+// 渐进模式下每帧只提交不超过时间预算的切片，单位采样的耗时由 GPU 计时查询校准
+class DOO_API EnvironmentPrefilter : public std::enable_shared_from_this<EnvironmentPrefilter>
+{
+public:
+    static constexpr float DEFAULT_BUDGET_MS = 1.0f;
+
+    static std::shared_ptr<EnvironmentPrefilter> Create(std::shared_ptr<TextureCube> source);
+
+    EnvironmentPrefilter(std::shared_ptr<TextureCube> source);
+    ~EnvironmentPrefilter();
+
+    // 提交一帧的切片，全部提交后返回 true
+    bool Update(float budgetMs = DEFAULT_BUDGET_MS);
+    // 一次提交全部剩余的切片
+    void Flush();
+
+    bool IsComplete() const
+    {
+        return m_nextItem >= m_workItems.size();
+    }
+
+    std::shared_ptr<TextureCube> GetRadianceMap() const
+    {
+        return m_radianceMap;
+    }
+
+    // 立即可用的低质量版本：未过滤的 mip 链
+    std::shared_ptr<TextureCube> GetPreviewRadianceMap() const
+    {
+        return m_source;
+    }
+
+private:
+    struct WorkItem
+    {
+        uint32_t Level;
+        int32_t X, Y, Face;
+        uint64_t Cost; // 采样数
+    };
+
+    void SubmitItems(size_t begin, size_t end);
+
+    std::shared_ptr<TextureCube> m_source;
+    std::shared_ptr<TextureCube> m_radianceMap;
+    std::shared_ptr<Shader> m_filterShader;
+
+    std::vector<WorkItem> m_workItems;
+    size_t m_nextItem = 0;
+
+    // 两个交替使用的计时查询，读取上一次切片的 GPU 耗时
+    uint32_t m_queries[2] = {0, 0};
+    uint64_t m_queryCosts[2] = {0, 0};
+    uint32_t m_queryIndex = 0;
+    double m_nanosecondsPerSample = 0.0;
+};
+
+} // namespace Doodle
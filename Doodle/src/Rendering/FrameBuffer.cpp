@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cstdint>
 #include <glad/glad.h>
 #include <vector>
 
 #include "Framebuffer.h"
+#include "GPUMemoryTracker.h"
 #include "Log.h"
 #include "Renderer.h"
 #include "RendererAPI.h"
@@ -74,6 +76,22 @@ static bool IsDepthFormat(FramebufferTextureFormat format)
     return format == FramebufferTextureFormat::DEPTH24STENCIL8;
 }
 
+static uint32_t GetBytesPerPixel(FramebufferTextureFormat format)
+{
+    switch (format)
+    {
+    case FramebufferTextureFormat::RGBA8:
+    case FramebufferTextureFormat::RED_INTEGER:
+    case FramebufferTextureFormat::DEPTH24STENCIL8:
+        return 4;
+    case FramebufferTextureFormat::RGBA16F:
+        return 8;
+    case FramebufferTextureFormat::None:
+        break;
+    }
+    return 0;
+}
+
 static GLenum GetGLFormat(FramebufferTextureFormat format)
 {
     switch (format)
@@ -106,6 +124,7 @@ public:
     }
     ~OpenGLFramebuffer()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
         Renderer::Submit([this]() {
             glDeleteFramebuffers(1, &m_rendererId);
             glDeleteTextures(m_colorAttachments.size(), m_colorAttachments.data());
@@ -297,6 +316,15 @@ private:
                         "Framebuffer is incomplete!");
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+        uint64_t bytesPerPixel = GetBytesPerPixel(m_depthAttachmentSpecification.TextureFormat);
+        for (const auto &attachment : m_colorAttachmentSpecifications)
+            bytesPerPixel += GetBytesPerPixel(attachment.TextureFormat);
+        uint64_t size = bytesPerPixel * m_specification.Width * m_specification.Height *
+                        std::max(m_specification.Samples, 1u);
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::RenderTarget,
+                                       fmt::format("FrameBuffer {}x{}", m_specification.Width, m_specification.Height),
+                                       size);
     }
 
     uint32_t m_rendererId = 0;
@@ -0,0 +1,101 @@
+#include "pch.h"
+#include <algorithm>
+
+#include "GPUMemoryTracker.h"
+
+namespace Doodle
+{
+
+const char *GPUMemoryCategoryToString(GPUMemoryCategory category)
+{
+    switch (category)
+    {
+    case GPUMemoryCategory::Texture:
+        return "Texture";
+    case GPUMemoryCategory::RenderTarget:
+        return "RenderTarget";
+    case GPUMemoryCategory::Geometry:
+        return "Geometry";
+    case GPUMemoryCategory::StorageBuffer:
+        return "StorageBuffer";
+    case GPUMemoryCategory::UniformBuffer:
+        return "UniformBuffer";
+    case GPUMemoryCategory::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+void GPUMemoryTracker::Track(const void *owner, GPUMemoryCategory category, std::string name, uint64_t size)
+{
+    if (m_destroyed)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_allocations.find(owner);
+    if (it != m_allocations.end())
+        Remove(it);
+
+    m_allocations[owner] = {std::move(name), category, size};
+    auto &stats = m_stats[static_cast<size_t>(category)];
+    stats.Count++;
+    stats.Bytes += size;
+    stats.PeakBytes = std::max(stats.PeakBytes, stats.Bytes);
+    m_totalBytes += size;
+    m_peakBytes = std::max(m_peakBytes, m_totalBytes);
+}
+
+void GPUMemoryTracker::Untrack(const void *owner)
+{
+    // 静态纹理可能在追踪器之后析构
+    if (m_destroyed)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_allocations.find(owner);
+    if (it != m_allocations.end())
+        Remove(it);
+}
+
+void GPUMemoryTracker::Remove(std::unordered_map<const void *, GPUAllocation>::iterator it)
+{
+    auto &stats = m_stats[static_cast<size_t>(it->second.Category)];
+    stats.Count--;
+    stats.Bytes -= it->second.Size;
+    m_totalBytes -= it->second.Size;
+    m_allocations.erase(it);
+}
+
+GPUMemoryStats GPUMemoryTracker::GetStats(GPUMemoryCategory category) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats[static_cast<size_t>(category)];
+}
+
+uint64_t GPUMemoryTracker::GetTotalBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_totalBytes;
+}
+
+uint64_t GPUMemoryTracker::GetPeakBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_peakBytes;
+}
+
+std::vector<GPUAllocation> GPUMemoryTracker::GetLargestAllocations(size_t count) const
+{
+    std::vector<GPUAllocation> allocations;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        allocations.reserve(m_allocations.size());
+        for (const auto &[_, allocation] : m_allocations)
+            allocations.push_back(allocation);
+    }
+    count = std::min(count, allocations.size());
+    std::partial_sort(allocations.begin(), allocations.begin() + count, allocations.end(),
+                      [](const GPUAllocation &lhs, const GPUAllocation &rhs) { return lhs.Size > rhs.Size; });
+    allocations.resize(count);
+    return allocations;
+}
+
+} // namespace Doodle
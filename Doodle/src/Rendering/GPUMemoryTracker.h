@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pch.h"
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Singleton.h"
+
+namespace Doodle
+{
+
+enum class GPUMemoryCategory
+{
+    Texture = 0,
+    RenderTarget,
+    Geometry,
+    StorageBuffer,
+    UniformBuffer,
+    Count
+};
+
+const char *GPUMemoryCategoryToString(GPUMemoryCategory category);
+
+struct GPUAllocation
+{
+    std::string Name;
+    GPUMemoryCategory Category = GPUMemoryCategory::Texture;
+    uint64_t Size = 0;
+};
+
+struct GPUMemoryStats
+{
+    uint32_t Count = 0;
+    uint64_t Bytes = 0;
+    uint64_t PeakBytes = 0;
+};
+
+// 显存占用统计：纹理、帧缓冲附件与缓冲在创建或改变大小后以自身地址为键登记分配的字节数（含 mip），销毁时注销。
+// 大小按格式估算，不含驱动的对齐与额外开销
+class DOO_API GPUMemoryTracker : public Singleton<GPUMemoryTracker>
+{
+public:
+    // 同一 owner 再次登记时替换原有记录
+    void Track(const void *owner, GPUMemoryCategory category, std::string name, uint64_t size);
+    void Untrack(const void *owner);
+
+    GPUMemoryStats GetStats(GPUMemoryCategory category) const;
+    uint64_t GetTotalBytes() const;
+    uint64_t GetPeakBytes() const;
+
+    // 按大小降序返回最大的 count 个分配
+    std::vector<GPUAllocation> GetLargestAllocations(size_t count) const;
+
+private:
+    void Remove(std::unordered_map<const void *, GPUAllocation>::iterator it);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<const void *, GPUAllocation> m_allocations;
+    std::array<GPUMemoryStats, static_cast<size_t>(GPUMemoryCategory::Count)> m_stats;
+    uint64_t m_totalBytes = 0;
+    uint64_t m_peakBytes = 0;
+};
+
+} // namespace Doodle
@@ -0,0 +1,119 @@
+#include "pch.h"
+
+#include "GPUScene.h"
+#include "MaterialTable.h"
+#include "MathUtils.h"
+#include "MeshPool.h"
+#include "RenderList.h"
+#include "Renderer.h"
+#include "ShaderLibrary.h"
+#include "StaticBatcher.h"
+
+namespace Doodle
+{
+
+GPUScene::GPUScene()
+{
+    m_cullingShader = ShaderLibrary::Get()->GetShader("gpuCulling");
+    m_standardShader = ShaderLibrary::Get()->GetShader("standard");
+    m_objectBuffer = StorageBuffer::Create(sizeof(GPUObjectData), true);
+    m_drawCommandBuffer = StorageBuffer::Create(sizeof(DrawElementsIndirectCommand));
+    m_drawCountBuffer = StorageBuffer::Create(sizeof(uint32_t));
+}
+
+void GPUScene::Update()
+{
+    m_objects.clear();
+
+    for (const auto &item : RenderList::Get()->GetMeshItems())
+    {
+        if (StaticBatcher::Get()->IsBatched(item.Entity))
+            continue;
+
+        AddObject(item.Model, item.NormalMatrix, item.Mesh->GetBoundingBox(), item.MaterialInstance,
+                  item.Mesh->GetLODRange(item.LOD), item.Mesh->GetLODRange(item.ShadowLOD));
+    }
+
+    // 静态合批的每个子网格作为独立物体参与剔除
+    for (const auto &batch : StaticBatcher::Get()->GetBatches())
+    {
+        MeshRange range = batch.Mesh->GetRange();
+        for (const auto &submesh : batch.Submeshes)
+        {
+            MeshRange submeshRange = range;
+            submeshRange.FirstIndex += submesh.FirstIndex;
+            submeshRange.IndexCount = submesh.IndexCount;
+            AddObject(glm::mat4(1.0f), glm::mat3(1.0f), submesh.Bounds, batch.MaterialInstance.get(), submeshRange,
+                      submeshRange);
+        }
+    }
+
+    Reserve(GetObjectCount());
+    m_objectBuffer->SetSubData(m_objects.data(), m_objects.size() * sizeof(GPUObjectData));
+}
+
+void GPUScene::Draw(std::shared_ptr<Shader> shader, const glm::mat4 &viewProjection,
+                    RenderObjectFlags requiredFlags, bool useShadowLOD)
+{
+    uint32_t objectCount = GetObjectCount();
+    if (objectCount == 0)
+        return;
+
+    m_objectBuffer->Bind(OBJECT_BUFFER_BINDING);
+    MaterialTable::Get()->Bind();
+    m_drawCommandBuffer->Bind(DRAW_COMMAND_BUFFER_BINDING);
+    m_drawCountBuffer->Bind(DRAW_COUNT_BUFFER_BINDING);
+    m_drawCountBuffer->Clear();
+
+    m_cullingShader->SetUniformMatrix4f("u_ViewProjection", viewProjection);
+    m_cullingShader->SetUniform1i("u_ObjectCount", static_cast<int>(objectCount));
+    m_cullingShader->SetUniform1i("u_RequiredFlags", static_cast<int>(requiredFlags));
+    m_cullingShader->SetUniform1i("u_UseShadowLOD", useShadowLOD ? 1 : 0);
+    Renderer::DispatchCompute((objectCount + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE);
+    Renderer::Barrier(BarrierFlags::ShaderStorage | BarrierFlags::Command);
+
+    shader->SetUniform1i("u_UseObjectBuffer", 1);
+    MeshPool::Get()->Bind();
+    Renderer::DrawIndexedIndirectCount(m_drawCommandBuffer, m_drawCountBuffer, objectCount);
+    shader->SetUniform1i("u_UseObjectBuffer", 0);
+}
+
+void GPUScene::AddObject(const glm::mat4 &model, const glm::mat3 &normalMatrix, const BoundingBox &bounds,
+                         MaterialInstance *material, const MeshRange &range, const MeshRange &shadowRange)
+{
+    if (range.IndexCount == 0)
+        return;
+
+    BoundingSphere sphere = BoundingSphere::FromBox(bounds, model);
+
+    RenderObjectFlags flags = RenderObjectFlags::None;
+    if (material->GetShader() == m_standardShader)
+        flags = flags | RenderObjectFlags::StandardShading;
+
+    GPUObjectData &object = m_objects.emplace_back();
+    object.Model = model;
+    object.NormalMatrix = glm::mat4(normalMatrix);
+    object.BoundingSphere = glm::vec4(sphere.Center, sphere.Radius);
+    object.MaterialIndex = material->GetMaterialSlot();
+    object.IndexCount = range.IndexCount;
+    object.FirstIndex = range.FirstIndex;
+    object.BaseVertex = range.BaseVertex;
+    object.Flags = static_cast<uint32_t>(flags);
+    object.ShadowIndexCount = shadowRange.IndexCount;
+    object.ShadowFirstIndex = shadowRange.FirstIndex;
+}
+
+void GPUScene::Reserve(uint32_t objectCount)
+{
+    auto grow = [](size_t required, size_t current) { return std::max(required, current * 2); };
+
+    size_t objectSize = objectCount * sizeof(GPUObjectData);
+    if (objectSize > m_objectBuffer->GetSize())
+    {
+        m_objectBuffer->Reserve(grow(objectSize, m_objectBuffer->GetSize()));
+        m_drawCommandBuffer->Reserve(grow(objectCount * sizeof(DrawElementsIndirectCommand),
+                                          m_drawCommandBuffer->GetSize()));
+    }
+}
+
+} // namespace Doodle
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "MaterialInstance.h"
+#include "MathUtils.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include "Singleton.h"
+#include "StorageBuffer.h"
+
+namespace Doodle
+{
+
+enum class RenderObjectFlags : uint32_t
+{
+    None = 0,
+    StandardShading = 1 << 0, // 使用 standard 着色器，可以在 ShadingPass 中间接绘制
+};
+
+inline RenderObjectFlags operator|(RenderObjectFlags lhs, RenderObjectFlags rhs)
+{
+    return static_cast<RenderObjectFlags>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+inline RenderObjectFlags operator&(RenderObjectFlags lhs, RenderObjectFlags rhs)
+{
+    return static_cast<RenderObjectFlags>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+// 以下结构与着色器中的 std430 布局一一对应
+struct GPUObjectData
+{
+    glm::mat4 Model;
+    glm::mat4 NormalMatrix;   // 只用左上 3x3，按 mat4 存放以与 std430 布局一致
+    glm::vec4 BoundingSphere; // xyz 世界空间中心, w 半径
+    uint32_t MaterialIndex;
+    uint32_t IndexCount;
+    uint32_t FirstIndex;
+    int32_t BaseVertex;
+    uint32_t Flags;
+    uint32_t ShadowIndexCount; // 阴影使用的 LOD，与主视图共用顶点
+    uint32_t ShadowFirstIndex;
+    uint32_t Padding;
+};
+
+struct DrawElementsIndirectCommand
+{
+    uint32_t Count;
+    uint32_t InstanceCount;
+    uint32_t FirstIndex;
+    int32_t BaseVertex;
+    uint32_t BaseInstance;
+};
+
+// GPU 驱动渲染：每帧上传一次物体数据（材质数据由 MaterialTable 维护），每个 Pass 通过计算着色器剔除后一次 MultiDrawIndirectCount 绘制
+class DOO_API GPUScene : public Singleton<GPUScene>
+{
+public:
+    static constexpr uint32_t OBJECT_BUFFER_BINDING = 0;
+    static constexpr uint32_t DRAW_COMMAND_BUFFER_BINDING = 2;
+    static constexpr uint32_t DRAW_COUNT_BUFFER_BINDING = 3;
+
+    GPUScene();
+
+    // 基于当帧的 RenderList 构建物体数据
+    void Update();
+    // shader 需要支持 u_UseObjectBuffer，从 ObjectBuffer 中按 gl_BaseInstanceARB 读取物体数据；
+    // useShadowLOD 时绘制 RenderItem::ShadowLOD
+    void Draw(std::shared_ptr<Shader> shader, const glm::mat4 &viewProjection,
+              RenderObjectFlags requiredFlags = RenderObjectFlags::None, bool useShadowLOD = false);
+
+    uint32_t GetObjectCount() const
+    {
+        return static_cast<uint32_t>(m_objects.size());
+    }
+
+private:
+    static constexpr uint32_t CULLING_GROUP_SIZE = 64;
+
+    std::shared_ptr<Shader> m_cullingShader;
+    std::shared_ptr<Shader> m_standardShader;
+    std::shared_ptr<StorageBuffer> m_objectBuffer;
+    std::shared_ptr<StorageBuffer> m_drawCommandBuffer;
+    std::shared_ptr<StorageBuffer> m_drawCountBuffer;
+
+    std::vector<GPUObjectData> m_objects;
+
+    void AddObject(const glm::mat4 &model, const glm::mat3 &normalMatrix, const BoundingBox &bounds,
+                   MaterialInstance *material, const MeshRange &range, const MeshRange &shadowRange);
+    void Reserve(uint32_t objectCount);
+};
+
+} // namespace Doodle
@@ -1,3 +1,4 @@
+#include "GPUMemoryTracker.h"
 #include "IndexBuffer.h"
 #include "Log.h"
 #include "Renderer.h"
@@ -16,10 +17,12 @@ public:
             glCreateBuffers(1, &m_rendererId);
             glNamedBufferData(m_rendererId, m_size, data, GL_STATIC_DRAW);
         });
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::Geometry, "IndexBuffer", m_size);
     }
 
     ~OpenGLIndexBuffer()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
         Renderer::Submit([this]() { glDeleteBuffers(1, &m_rendererId); });
     }
 
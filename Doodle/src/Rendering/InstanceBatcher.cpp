@@ -0,0 +1,95 @@
+#include "pch.h"
+
+#include "InstanceBatcher.h"
+#include "RenderList.h"
+#include "StaticBatcher.h"
+
+namespace Doodle
+{
+
+struct BatchKey
+{
+    Mesh *Mesh;
+    uint32_t LOD;
+    size_t MaterialHash;
+
+    bool operator==(const BatchKey &other) const
+    {
+        return Mesh == other.Mesh && LOD == other.LOD && MaterialHash == other.MaterialHash;
+    }
+};
+
+struct BatchKeyHash
+{
+    size_t operator()(const BatchKey &key) const
+    {
+        return std::hash<Doodle::Mesh *>{}(key.Mesh) ^ (key.MaterialHash << 1) ^ (static_cast<size_t>(key.LOD) << 2);
+    }
+};
+
+InstanceBatcher::InstanceBatcher()
+{
+    m_instanceBuffer = StorageBuffer::Create(sizeof(InstanceData), true);
+}
+
+void InstanceBatcher::Update()
+{
+    m_batches.clear();
+    m_instances.clear();
+
+    // 先按 (Mesh, LOD, 材质状态) 分组，哈希相同但状态不同的材质各自成批
+    std::unordered_map<BatchKey, std::vector<uint32_t>, BatchKeyHash> batchIndices;
+    std::vector<std::vector<InstanceData>> batchTransforms;
+
+    for (const auto &item : RenderList::Get()->GetMeshItems())
+    {
+        if (StaticBatcher::Get()->IsBatched(item.Entity))
+            continue;
+
+        auto &candidates = batchIndices[{item.Mesh, item.LOD, item.MaterialInstance->GetStateHash()}];
+        uint32_t batchIndex = UINT32_MAX;
+        for (uint32_t candidate : candidates)
+        {
+            if (m_batches[candidate].MaterialInstance->HasSameState(*item.MaterialInstance))
+            {
+                batchIndex = candidate;
+                break;
+            }
+        }
+        if (batchIndex == UINT32_MAX)
+        {
+            batchIndex = static_cast<uint32_t>(m_batches.size());
+            candidates.push_back(batchIndex);
+            m_batches.push_back({item.Mesh, item.MaterialInstance, 0, 0, item.LOD, item.ShadowLOD});
+            batchTransforms.emplace_back();
+        }
+        batchTransforms[batchIndex].push_back({item.Model, glm::mat4(item.NormalMatrix)});
+    }
+
+    // 静态合批的顶点已在世界空间，以单位矩阵作为唯一实例
+    for (const auto &staticBatch : StaticBatcher::Get()->GetBatches())
+    {
+        m_batches.push_back({staticBatch.Mesh.get(), staticBatch.MaterialInstance.get()});
+        batchTransforms.push_back({{glm::mat4(1.0f), glm::mat4(1.0f)}});
+    }
+
+    for (size_t i = 0; i < m_batches.size(); i++)
+    {
+        m_batches[i].FirstInstance = static_cast<uint32_t>(m_instances.size());
+        m_batches[i].InstanceCount = static_cast<uint32_t>(batchTransforms[i].size());
+        m_instances.insert(m_instances.end(), batchTransforms[i].begin(), batchTransforms[i].end());
+    }
+
+    size_t size = m_instances.size() * sizeof(InstanceData);
+    if (size > m_instanceBuffer->GetSize())
+        m_instanceBuffer->Reserve(std::max(size, m_instanceBuffer->GetSize() * 2));
+    if (size > 0)
+        m_instanceBuffer->SetSubData(m_instances.data(), size);
+}
+
+void InstanceBatcher::Bind() const
+{
+    m_instanceBuffer->Bind(INSTANCE_BUFFER_BINDING);
+}
+
+} // namespace Doodle
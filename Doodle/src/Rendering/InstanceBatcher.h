@@ -0,0 +1,63 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "MaterialInstance.h"
+#include "Mesh.h"
+#include "Singleton.h"
+#include "StorageBuffer.h"
+
+namespace Doodle
+{
+
+// 与着色器中 InstanceBuffer 的元素布局一致
+struct InstanceData
+{
+    glm::mat4 Model;
+    glm::mat4 NormalMatrix; // 只用左上 3x3
+};
+
+// 指针在当帧有效
+struct InstanceBatch
+{
+    Mesh *Mesh = nullptr;
+    MaterialInstance *MaterialInstance = nullptr;
+    uint32_t FirstInstance = 0;
+    uint32_t InstanceCount = 0;
+    uint32_t LOD = 0;
+    uint32_t ShadowLOD = 0;
+};
+
+// 将共享同一 Mesh、选择了同一 LOD 且材质状态相同的实体合并为一次实例化绘制
+class DOO_API InstanceBatcher : public Singleton<InstanceBatcher>
+{
+public:
+    static constexpr uint32_t INSTANCE_BUFFER_BINDING = 4;
+
+    InstanceBatcher();
+
+    // 基于当帧的 RenderList 重新分组
+    void Update();
+    // shader 需要支持 u_UseInstanceBuffer，从 InstanceBuffer 中按 gl_BaseInstanceARB + gl_InstanceID 读取 InstanceData
+    void Bind() const;
+
+    const std::vector<InstanceBatch> &GetBatches() const
+    {
+        return m_batches;
+    }
+
+    uint32_t GetInstanceCount() const
+    {
+        return static_cast<uint32_t>(m_instances.size());
+    }
+
+private:
+    std::shared_ptr<StorageBuffer> m_instanceBuffer;
+    std::vector<InstanceBatch> m_batches;
+    std::vector<InstanceData> m_instances;
+};
+
+} // namespace Doodle
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include <glad/glad.h>
+
+#include "IrradianceSH.h"
+#include "Renderer.h"
+#include "ShaderLibrary.h"
+
+namespace Doodle
+{
+
+// 3 阶球谐只保留低频，64x64 的面已足够，采样更高的 mip 只会增加耗时
+static constexpr uint32_t SOURCE_SIZE = 64;
+static constexpr uint64_t PARTIAL_SUMS_SIZE = 6 * IrradianceSH::COEFFICIENT_COUNT * sizeof(glm::vec4);
+static constexpr GLbitfield MAP_FLAGS = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+// 阻塞等待的上限，只用于非渐进的加载
+static constexpr GLuint64 WAIT_TIMEOUT_NS = 10'000'000'000ull;
+
+IrradianceSH::~IrradianceSH()
+{
+    if (m_fence)
+        glDeleteSync(static_cast<GLsync>(m_fence));
+    if (m_buffer)
+        glDeleteBuffers(1, &m_buffer);
+}
+
+std::shared_ptr<IrradianceSH> IrradianceSH::Project(std::shared_ptr<TextureCube> radianceMap)
+{
+    auto irradiance = std::make_shared<IrradianceSH>();
+    irradiance->m_ready = false;
+    auto shader = ShaderLibrary::Get()->GetShader("environmentSH");
+
+    uint32_t sourceLevel = 0;
+    while ((radianceMap->GetWidth() >> (sourceLevel + 1)) >= SOURCE_SIZE &&
+           sourceLevel + 1 < radianceMap->GetMipLevelCount())
+        sourceLevel++;
+
+    Renderer::Submit([irradiance, radianceMap, shader, sourceLevel]() {
+        glCreateBuffers(1, &irradiance->m_buffer);
+        glNamedBufferStorage(irradiance->m_buffer, PARTIAL_SUMS_SIZE, nullptr, MAP_FLAGS);
+        irradiance->m_partialSums = static_cast<const glm::vec4 *>(
+            glMapNamedBufferRange(irradiance->m_buffer, 0, PARTIAL_SUMS_SIZE, MAP_FLAGS));
+
+        GLuint program = shader->GetRendererID();
+        glUseProgram(program);
+        glBindTextureUnit(0, radianceMap->GetRendererID());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SH_BUFFER_BINDING, irradiance->m_buffer);
+        glProgramUniform1f(program, 0, static_cast<float>(sourceLevel));
+        glDispatchCompute(1, 1, 6);
+        // 映射的缓冲对 CPU 可见需要屏障，之后的栅栏保证写入完成
+        glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+        irradiance->m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    });
+    return irradiance;
+}
+
+void IrradianceSH::Resolve(bool wait)
+{
+    if (m_ready)
+        return;
+
+    Renderer::Submit([self = shared_from_this(), wait]() {
+        if (self->m_ready || !self->m_fence)
+            return;
+        GLenum status = glClientWaitSync(static_cast<GLsync>(self->m_fence), GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         wait ? WAIT_TIMEOUT_NS : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            return;
+
+        for (uint32_t i = 0; i < COEFFICIENT_COUNT; i++)
+        {
+            self->Coefficients[i] = glm::vec4(0.0f);
+            for (uint32_t face = 0; face < 6; face++)
+                self->Coefficients[i] += self->m_partialSums[face * COEFFICIENT_COUNT + i];
+        }
+
+        glDeleteSync(static_cast<GLsync>(self->m_fence));
+        self->m_fence = nullptr;
+        glUnmapNamedBuffer(self->m_buffer);
+        glDeleteBuffers(1, &self->m_buffer);
+        self->m_buffer = 0;
+        self->m_partialSums = nullptr;
+        self->m_ready = true;
+    });
+}
+
+} // namespace Doodle
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+
+#include "Texture.h"
+
+namespace Doodle
+{
+
+// 环境辐照度的 3 阶球谐系数，已乘上基函数常数与余弦卷积，着色时只需几次乘加；w 未使用
+class DOO_API IrradianceSH : public std::enable_shared_from_this<IrradianceSH>
+{
+public:
+    static constexpr uint32_t COEFFICIENT_COUNT = 9;
+    // 与 environmentSH.glsl 中的缓冲绑定点一致
+    static constexpr uint32_t SH_BUFFER_BINDING = 6;
+
+    glm::vec4 Coefficients[COEFFICIENT_COUNT] = {};
+
+    ~IrradianceSH();
+
+    // 在 GPU 上把辐射度立方体贴图投影到球谐，结果写入持久映射的缓冲，由 Resolve 在栅栏触发后读取
+    static std::shared_ptr<IrradianceSH> Project(std::shared_ptr<TextureCube> radianceMap);
+
+    // 直接填写系数的对象始终就绪
+    bool IsReady() const
+    {
+        return m_ready;
+    }
+
+    // 提交一次栅栏检查，GPU 已完成时汇总系数；wait 为 true 时阻塞到完成
+    void Resolve(bool wait = false);
+
+private:
+    bool m_ready = true;
+    uint32_t m_buffer = 0;
+    const glm::vec4 *m_partialSums = nullptr; // 每个面一组部分和
+    void *m_fence = nullptr;
+};
+
+} // namespace Doodle
@@ -0,0 +1,63 @@
+#include "pch.h"
+#include <cstring>
+
+#include "LTCTable.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "Renderer.h"
+
+namespace Doodle
+{
+
+static constexpr char LTC_TABLE_MAGIC[4] = {'D', 'L', 'T', 'C'};
+
+// 与 tools/LTCGenerator 写入的文件头一致
+struct LTCTableHeader
+{
+    char Magic[4];
+    uint32_t Version;
+    uint32_t Size;
+    uint32_t Padding;
+};
+
+bool LTCTable::Load(const std::filesystem::path &filepath, std::shared_ptr<Texture2D> &ltc1,
+                    std::shared_ptr<Texture2D> &ltc2)
+{
+    auto file = std::make_shared<MappedFile>(filepath);
+    if (!*file)
+        return false;
+
+    const uint64_t tableSize = static_cast<uint64_t>(SIZE) * SIZE * 4 * sizeof(float);
+    if (file->GetSize() != sizeof(LTCTableHeader) + 2 * tableSize)
+    {
+        DOO_CORE_ERROR("Invalid LTC table size: {0}", filepath.string());
+        return false;
+    }
+
+    LTCTableHeader header;
+    std::memcpy(&header, file->GetData(), sizeof(header));
+    if (std::memcmp(header.Magic, LTC_TABLE_MAGIC, sizeof(header.Magic)) != 0 || header.Version != VERSION ||
+        header.Size != SIZE)
+    {
+        DOO_CORE_ERROR("Invalid LTC table header: {0}", filepath.string());
+        return false;
+    }
+
+    TextureParams params;
+    params.Format = TextureFormat::RGBA32F;
+    params.Wrap = TextureWrap::ClampToEdge;
+    params.Filter = TextureFilter::Linear;
+    params.Width = SIZE;
+    params.Height = SIZE;
+    ltc1 = Texture2D::Create(params);
+    ltc2 = Texture2D::Create(params);
+
+    const std::byte *data = file->GetData() + sizeof(LTCTableHeader);
+    ltc1->SetData(data);
+    ltc2->SetData(data + tableSize);
+    // 映射在上传命令执行后随最后一个引用释放
+    Renderer::Submit([file]() {});
+    return true;
+}
+
+} // namespace Doodle
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "Texture.h"
+
+namespace Doodle
+{
+
+// 面光源使用的 LTC 查找表。二进制资源由 tools/LTCGenerator 生成：
+// 文件头之后依次是 LTC1（逆矩阵 M）与 LTC2（GGX 归一化、菲涅尔、0、球面裁剪），均为 RGBA32F
+class DOO_API LTCTable
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t SIZE = 64;
+    static constexpr const char *DEFAULT_PATH = "assets/textures/ltc.bin";
+
+    // 映射文件后直接从映射内存上传，上传完成后解除映射
+    static bool Load(const std::filesystem::path &filepath, std::shared_ptr<Texture2D> &ltc1,
+                     std::shared_ptr<Texture2D> &ltc2);
+};
+
+} // namespace Doodle
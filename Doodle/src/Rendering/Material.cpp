@@ -10,61 +10,73 @@ namespace Doodle
 void Material::SetUniform1f(const std::string &name, float value)
 {
     m_uniforms1f[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform2f(const std::string &name, glm::vec2 value)
 {
     m_uniforms2f[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform3f(const std::string &name, glm::vec3 value)
 {
     m_uniforms3f[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform4f(const std::string &name, glm::vec4 value)
 {
     m_uniforms4f[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform1i(const std::string &name, int value)
 {
     m_uniforms1i[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform2i(const std::string &name, glm::vec<2, int> value)
 {
     m_uniforms2i[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform3i(const std::string &name, glm::vec<3, int> value)
 {
     m_uniforms3i[name] = value;
+    m_version++;
 }
 
 void Material::SetUniform4i(const std::string &name, glm::vec<4, int> value)
 {
     m_uniforms4i[name] = value;
+    m_version++;
 }
 
 void Material::SetUniformMatrix4f(const std::string &name, glm::mat4 value)
 {
     m_uniforms4m[name] = value;
+    m_version++;
 }
 
 void Material::SetUniformMatrix3f(const std::string &name, glm::mat3 value)
 {
     m_uniforms3m[name] = value;
+    m_version++;
 }
 
 void Material::SetUniformTexture(const std::string &name, std::shared_ptr<Texture> value)
 {
     m_textures[name] = value;
+    m_version++;
 }
 
 void Material::SetUniformTexture(const std::string &name, uint64_t textureHandle)
 {
     m_textureHandles[name] = textureHandle;
+    m_version++;
 }
 
 float Material::GetUniform1f(const std::string &name)
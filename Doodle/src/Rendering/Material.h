@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AssetManager.h"
 #include "Shader.h"
 #include "ShaderLibrary.h"
 #include "Texture.h"
@@ -75,6 +76,11 @@ public:
         return m_shader;
     }
 
+    uint32_t GetVersion() const
+    {
+        return m_version;
+    }
+
     std::string GetShaderName() const
     {
         return m_shaderName;
@@ -88,6 +94,7 @@ public:
 private:
     std::string m_shaderName;
     std::shared_ptr<Shader> m_shader;
+    uint32_t m_version = 0;
     std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
     std::unordered_map<std::string, uint64_t> m_textureHandles;
     std::unordered_map<std::string, float> m_uniforms1f;
@@ -164,22 +171,22 @@ public:
 
     void LoadAlbedoTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetAlbedoTexture(Texture2D::Create(filepath, params));
+        SetAlbedoTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadNormalTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetNormalTexture(Texture2D::Create(filepath, params));
+        SetNormalTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadMetallicTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetMetallicTexture(Texture2D::Create(filepath, params));
+        SetMetallicTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadRoughnessTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetRoughnessTexture(Texture2D::Create(filepath, params));
+        SetRoughnessTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadAlbedoTexture(Buffer buffer, const TextureParams &params = TextureParams())
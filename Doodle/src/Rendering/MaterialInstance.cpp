@@ -1,12 +1,19 @@
 #include "MaterialInstance.h"
 #include "Log.h"
 #include <cstdint>
+#include <string_view>
 
 namespace Doodle
 {
 
 MaterialInstance::MaterialInstance(std::shared_ptr<Material> material) : m_material(material)
 {
+    m_materialSlot = MaterialTable::Get()->Allocate(this);
+}
+
+MaterialInstance::~MaterialInstance()
+{
+    MaterialTable::Get()->Free(m_materialSlot);
 }
 
 void MaterialInstance::Bind()
@@ -26,61 +33,73 @@ void MaterialInstance::Unbind()
 void MaterialInstance::SetUniform1f(const std::string &name, float value)
 {
     m_instanceUniforms1f[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform2f(const std::string &name, glm::vec2 value)
 {
     m_instanceUniforms2f[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform3f(const std::string &name, glm::vec3 value)
 {
     m_instanceUniforms3f[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform4f(const std::string &name, glm::vec4 value)
 {
     m_instanceUniforms4f[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform1i(const std::string &name, int value)
 {
     m_instanceUniforms1i[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform2i(const std::string &name, glm::ivec2 value)
 {
     m_instanceUniforms2i[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform3i(const std::string &name, glm::ivec3 value)
 {
     m_instanceUniforms3i[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniform4i(const std::string &name, glm::ivec4 value)
 {
     m_instanceUniforms4i[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniformMatrix4f(const std::string &name, glm::mat4 value)
 {
     m_instanceUniforms4m[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniformMatrix3f(const std::string &name, glm::mat3 value)
 {
     m_instanceUniforms3m[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniformTexture(const std::string &name, std::shared_ptr<Texture> value)
 {
     m_instanceTextures[name] = value;
+    m_version++;
 }
 
 void MaterialInstance::SetUniformTexture(const std::string &name, uint64_t textureHandle)
 {
     m_instanceTextureHandles[name] = textureHandle;
+    m_version++;
 }
 
 float MaterialInstance::GetUniform1f(const std::string &name)
@@ -191,6 +210,101 @@ uint64_t MaterialInstance::GetUniformTextureHandle(const std::string &name)
     return m_material->GetUniformTextureHandle(name);
 }
 
+static bool IsPerObjectUniform(const std::string &name)
+{
+    return name == "u_Model" || name == "u_NormalMatrix";
+}
+
+static void HashCombine(size_t &seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T> static size_t HashUniformValue(const T &value)
+{
+    return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char *>(&value), sizeof(T)));
+}
+
+static size_t HashUniformValue(const std::shared_ptr<Texture> &value)
+{
+    return std::hash<Texture *>{}(value.get());
+}
+
+template <typename T> static size_t HashUniforms(const std::unordered_map<std::string, T> &uniforms)
+{
+    // unordered_map 遍历顺序不确定，逐项哈希后求和，使结果与顺序无关
+    size_t hash = 0;
+    for (const auto &[name, value] : uniforms)
+    {
+        if (IsPerObjectUniform(name))
+            continue;
+        hash += std::hash<std::string>{}(name) ^ (HashUniformValue(value) << 1);
+    }
+    return hash;
+}
+
+template <typename T>
+static bool SameUniforms(const std::unordered_map<std::string, T> &lhs, const std::unordered_map<std::string, T> &rhs)
+{
+    size_t count = 0;
+    for (const auto &[name, value] : lhs)
+    {
+        if (IsPerObjectUniform(name))
+            continue;
+        auto it = rhs.find(name);
+        if (it == rhs.end() || !(it->second == value))
+            return false;
+        count++;
+    }
+    for (const auto &[name, value] : rhs)
+    {
+        if (!IsPerObjectUniform(name))
+            count--;
+    }
+    return count == 0;
+}
+
+size_t MaterialInstance::GetStateHash() const
+{
+    if (m_stateHashVersion == m_version)
+        return m_stateHash;
+
+    size_t hash = std::hash<Material *>{}(m_material.get());
+    HashCombine(hash, HashUniforms(m_instanceTextures));
+    HashCombine(hash, HashUniforms(m_instanceTextureHandles));
+    HashCombine(hash, HashUniforms(m_instanceUniforms1f));
+    HashCombine(hash, HashUniforms(m_instanceUniforms2f));
+    HashCombine(hash, HashUniforms(m_instanceUniforms3f));
+    HashCombine(hash, HashUniforms(m_instanceUniforms4f));
+    HashCombine(hash, HashUniforms(m_instanceUniforms1i));
+    HashCombine(hash, HashUniforms(m_instanceUniforms2i));
+    HashCombine(hash, HashUniforms(m_instanceUniforms3i));
+    HashCombine(hash, HashUniforms(m_instanceUniforms4i));
+    HashCombine(hash, HashUniforms(m_instanceUniforms3m));
+    HashCombine(hash, HashUniforms(m_instanceUniforms4m));
+    m_stateHash = hash;
+    m_stateHashVersion = m_version;
+    return hash;
+}
+
+bool MaterialInstance::HasSameState(const MaterialInstance &other) const
+{
+    if (this == &other)
+        return true;
+    return m_material == other.m_material && SameUniforms(m_instanceTextures, other.m_instanceTextures) &&
+           SameUniforms(m_instanceTextureHandles, other.m_instanceTextureHandles) &&
+           SameUniforms(m_instanceUniforms1f, other.m_instanceUniforms1f) &&
+           SameUniforms(m_instanceUniforms2f, other.m_instanceUniforms2f) &&
+           SameUniforms(m_instanceUniforms3f, other.m_instanceUniforms3f) &&
+           SameUniforms(m_instanceUniforms4f, other.m_instanceUniforms4f) &&
+           SameUniforms(m_instanceUniforms1i, other.m_instanceUniforms1i) &&
+           SameUniforms(m_instanceUniforms2i, other.m_instanceUniforms2i) &&
+           SameUniforms(m_instanceUniforms3i, other.m_instanceUniforms3i) &&
+           SameUniforms(m_instanceUniforms4i, other.m_instanceUniforms4i) &&
+           SameUniforms(m_instanceUniforms3m, other.m_instanceUniforms3m) &&
+           SameUniforms(m_instanceUniforms4m, other.m_instanceUniforms4m);
+}
+
 void MaterialInstance::ApplyInstanceUniforms()
 {
     for (auto &[name, texture] : m_instanceTextures)
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "AssetManager.h"
 #include "Material.h"
+#include "MaterialTable.h"
 #include "Shader.h"
 #include "UUID.h"
 #include <cstdint>
@@ -24,6 +26,10 @@ public:
     {
     }
     MaterialInstance(std::shared_ptr<Material> material);
+    ~MaterialInstance();
+
+    MaterialInstance(const MaterialInstance &) = delete;
+    MaterialInstance &operator=(const MaterialInstance &) = delete;
 
     void Bind();
     void Unbind();
@@ -55,6 +61,23 @@ public:
     std::shared_ptr<Texture> GetUniformTexture(const std::string &name);
     uint64_t GetUniformTextureHandle(const std::string &name);
 
+    // 材质状态（基础材质 + 实例统一值，不含 u_Model 等逐物体数据），用于合批
+    // 结果按实例版本号缓存，只在实例的参数或纹理被修改后重新计算
+    size_t GetStateHash() const;
+    bool HasSameState(const MaterialInstance &other) const;
+
+    // 基础材质与实例的版本号都只增不减，两者之和变化即表示参数被修改
+    uint32_t GetVersion() const
+    {
+        return m_version + (m_material ? m_material->GetVersion() : 0);
+    }
+
+    // 在 MaterialTable 中的槽位，着色器通过 u_MaterialID 索引
+    uint32_t GetMaterialSlot() const
+    {
+        return m_materialSlot;
+    }
+
     void SetAlbedoColor(const glm::vec4 &color)
     {
         SetUniform4f("u_AlbedoColor", color);
@@ -97,22 +120,22 @@ public:
 
     void LoadAlbedoTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetAlbedoTexture(Texture2D::Create(filepath, params));
+        SetAlbedoTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadNormalTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetNormalTexture(Texture2D::Create(filepath, params));
+        SetNormalTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadMetallicTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetMetallicTexture(Texture2D::Create(filepath, params));
+        SetMetallicTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadRoughnessTexture(const std::string &filepath, const TextureParams &params = TextureParams())
     {
-        SetRoughnessTexture(Texture2D::Create(filepath, params));
+        SetRoughnessTexture(AssetManager::Get()->LoadTexture(filepath, params));
     }
 
     void LoadAlbedoTexture(Buffer buffer, const TextureParams &params = TextureParams())
@@ -152,6 +175,10 @@ public:
 
 private:
     std::shared_ptr<Material> m_material;
+    uint32_t m_materialSlot = MaterialTable::INVALID_SLOT;
+    uint32_t m_version = 0;
+    mutable size_t m_stateHash = 0;
+    mutable uint32_t m_stateHashVersion = UINT32_MAX;
     std::unordered_map<std::string, std::shared_ptr<Texture>> m_instanceTextures;
     std::unordered_map<std::string, uint64_t> m_instanceTextureHandles;
     std::unordered_map<std::string, float> m_instanceUniforms1f;
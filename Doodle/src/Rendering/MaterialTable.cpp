@@ -0,0 +1,131 @@
+#include "pch.h"
+#include <glad/glad.h>
+
+#include "MaterialInstance.h"
+#include "MaterialTable.h"
+#include "Renderer.h"
+#include "Texture.h"
+
+namespace Doodle
+{
+
+struct PendingMaterial
+{
+    uint32_t Slot;
+    GPUMaterialData Data;
+    std::array<std::shared_ptr<Texture>, 4> Textures;
+};
+
+static std::shared_ptr<Texture> GetMaterialTexture(MaterialInstance &materialInstance, const std::string &name,
+                                                   const std::shared_ptr<Texture> &fallback)
+{
+    auto texture = materialInstance.GetUniformTexture(name);
+    return texture ? texture : fallback;
+}
+
+static uint32_t GetTextureVersion(const std::array<std::shared_ptr<Texture>, 4> &textures)
+{
+    // 句柄版本只增不减，求和即可发现任意一张纹理的变化
+    uint32_t version = 0;
+    for (const auto &texture : textures)
+        version += texture ? texture->GetHandleVersion() : 0;
+    return version;
+}
+
+MaterialTable::MaterialTable()
+{
+    m_materialBuffer = StorageBuffer::Create(INITIAL_CAPACITY * sizeof(GPUMaterialData), true);
+}
+
+uint32_t MaterialTable::Allocate(MaterialInstance *materialInstance)
+{
+    uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    m_slots[slot] = {materialInstance, UINT32_MAX};
+    return slot;
+}
+
+void MaterialTable::Free(uint32_t slot)
+{
+    if (m_destroyed || slot == INVALID_SLOT)
+        return;
+    m_slots[slot] = {};
+    m_freeSlots.push_back(slot);
+}
+
+void MaterialTable::Update()
+{
+    size_t size = m_slots.size() * sizeof(GPUMaterialData);
+    if (size > m_materialBuffer->GetSize())
+    {
+        // Reserve 会丢弃原有内容，所有槽位需要重新上传
+        m_materialBuffer->Reserve(std::max(size, m_materialBuffer->GetSize() * 2));
+        for (auto &slot : m_slots)
+            slot.Version = UINT32_MAX;
+    }
+
+    // 异步纹理完成上传或流式纹理切换常驻 mip 后句柄会变化，只重新填充引用了这些纹理的槽位
+    uint32_t textureHandleGeneration = Texture2D::GetTextureHandleGeneration();
+    bool texturesChanged = textureHandleGeneration != m_textureHandleGeneration;
+    m_textureHandleGeneration = textureHandleGeneration;
+
+    std::vector<PendingMaterial> pendingMaterials;
+    for (uint32_t i = 0; i < m_slots.size(); i++)
+    {
+        auto &slot = m_slots[i];
+        if (!slot.MaterialInstance)
+            continue;
+        if (slot.MaterialInstance->GetVersion() == slot.Version &&
+            (!texturesChanged || GetTextureVersion(slot.Textures) == slot.TextureVersion))
+            continue;
+        slot.Version = slot.MaterialInstance->GetVersion();
+
+        auto &materialInstance = *slot.MaterialInstance;
+        PendingMaterial &pending = pendingMaterials.emplace_back();
+        pending.Slot = i;
+        pending.Data.AlbedoColor = materialInstance.GetUniform4f("u_AlbedoColor");
+        pending.Data.Metallic = materialInstance.GetUniform1f("u_Metallic");
+        pending.Data.Roughness = materialInstance.GetUniform1f("u_Roughness");
+        pending.Data.NormalScale = materialInstance.GetUniform1f("u_NormalScale");
+        pending.Textures[0] = GetMaterialTexture(materialInstance, "u_AlbedoTexture", Texture2D::GetWhiteTexture());
+        pending.Textures[1] =
+            GetMaterialTexture(materialInstance, "u_NormalTexture", Texture2D::GetDefaultNormalTexture());
+        pending.Textures[2] = GetMaterialTexture(materialInstance, "u_MetallicTexture", Texture2D::GetWhiteTexture());
+        pending.Textures[3] = GetMaterialTexture(materialInstance, "u_RoughnessTexture", Texture2D::GetWhiteTexture());
+        slot.Textures = pending.Textures;
+        slot.TextureVersion = GetTextureVersion(slot.Textures);
+    }
+
+    if (pendingMaterials.empty())
+        return;
+
+    // 纹理句柄在纹理创建命令执行之后才有效，因此在渲染线程上填充句柄
+    Renderer::Submit([this, pendingMaterials = std::move(pendingMaterials)]() mutable {
+        uint32_t buffer = m_materialBuffer->GetRendererID();
+        for (auto &pending : pendingMaterials)
+        {
+            pending.Data.AlbedoTexture = pending.Textures[0]->GetTextureHandle();
+            pending.Data.NormalTexture = pending.Textures[1]->GetTextureHandle();
+            pending.Data.MetallicTexture = pending.Textures[2]->GetTextureHandle();
+            pending.Data.RoughnessTexture = pending.Textures[3]->GetTextureHandle();
+            glNamedBufferSubData(buffer, pending.Slot * sizeof(GPUMaterialData), sizeof(GPUMaterialData),
+                                 &pending.Data);
+        }
+    });
+}
+
+void MaterialTable::Bind() const
+{
+    m_materialBuffer->Bind(MATERIAL_BUFFER_BINDING);
+}
+
+} // namespace Doodle
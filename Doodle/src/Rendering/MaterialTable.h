@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pch.h"
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Singleton.h"
+#include "StorageBuffer.h"
+
+namespace Doodle
+{
+
+// 与着色器中 MaterialBuffer 的 std430 布局一一对应
+struct GPUMaterialData
+{
+    glm::vec4 AlbedoColor;
+    float Metallic;
+    float Roughness;
+    float NormalScale;
+    float Padding;
+    uint64_t AlbedoTexture;
+    uint64_t NormalTexture;
+    uint64_t MetallicTexture;
+    uint64_t RoughnessTexture;
+};
+
+class MaterialInstance;
+class Texture;
+// 所有材质实例的参数表，每个实例占用一个槽位，只在参数变化时重新上传
+class DOO_API MaterialTable : public Singleton<MaterialTable>
+{
+public:
+    static constexpr uint32_t MATERIAL_BUFFER_BINDING = 1;
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    MaterialTable();
+
+    uint32_t Allocate(MaterialInstance *materialInstance);
+    void Free(uint32_t slot);
+
+    void Update();
+    void Bind() const;
+
+    uint32_t GetSlotCount() const
+    {
+        return static_cast<uint32_t>(m_slots.size());
+    }
+
+private:
+    static constexpr uint32_t INITIAL_CAPACITY = 256;
+
+    struct Slot
+    {
+        MaterialInstance *MaterialInstance = nullptr;
+        uint32_t Version = UINT32_MAX;
+        std::array<std::shared_ptr<Texture>, 4> Textures;
+        uint32_t TextureVersion = 0; // 上传时各纹理句柄版本之和
+    };
+
+    std::shared_ptr<StorageBuffer> m_materialBuffer;
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    uint32_t m_textureHandleGeneration = 0;
+};
+
+} // namespace Doodle
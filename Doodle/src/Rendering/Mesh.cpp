@@ -1,18 +1,23 @@
 #include "assimp/material.h"
 #include "glm/fwd.hpp"
 #include "pch.h"
+#include <algorithm>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <cmath>
 #include <filesystem>
 #include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
 
 #include "Mesh.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshPool.h"
+#include "MeshSimplifier.h"
 #include "Texture.h"
-#include "VertexArray.h"
-#include "VertexBuffer.h"
 
 namespace Doodle
 {
@@ -41,8 +46,83 @@ struct LogStream : public Assimp::LogStream
     }
 };
 
+static glm::vec2 OctEncode(glm::vec3 v)
+{
+    float sum = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (sum == 0.0f)
+        return glm::vec2(0.0f);
+    v /= sum;
+    glm::vec2 e(v.x, v.y);
+    if (v.z < 0.0f)
+    {
+        e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) *
+            glm::vec2(e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return e;
+}
+
+static int16_t PackSnorm16(float value)
+{
+    return static_cast<int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+PackedVertex PackedVertex::Pack(const Vertex &vertex)
+{
+    PackedVertex packed;
+    packed.Position = vertex.Position;
+
+    glm::vec2 normal = OctEncode(vertex.Normal);
+    packed.Normal[0] = PackSnorm16(normal.x);
+    packed.Normal[1] = PackSnorm16(normal.y);
+
+    // 切线 y 只保留 15 位，空出的最低位存副切线符号，按 snorm 读取时的误差不超过 1/32767
+    glm::vec2 tangent = OctEncode(vertex.Tangent);
+    bool flipped = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Binormal) < 0.0f;
+    auto tangentY = static_cast<int16_t>(std::round(std::clamp(tangent.y, -1.0f, 1.0f) * 16383.0f));
+    packed.Tangent[0] = PackSnorm16(tangent.x);
+    packed.Tangent[1] = static_cast<int16_t>(tangentY * 2 | (flipped ? 1 : 0));
+
+    packed.TexCoord[0] = static_cast<uint16_t>(glm::packHalf1x16(vertex.TexCoord.x));
+    packed.TexCoord[1] = static_cast<uint16_t>(glm::packHalf1x16(vertex.TexCoord.y));
+    return packed;
+}
+
+static glm::vec3 OctDecode(glm::vec2 e)
+{
+    glm::vec3 v(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-v.z, 0.0f);
+    v.x += v.x >= 0.0f ? -t : t;
+    v.y += v.y >= 0.0f ? -t : t;
+    return glm::normalize(v);
+}
+
+static float UnpackSnorm16(int16_t value)
+{
+    return std::max(value / 32767.0f, -1.0f);
+}
+
+// 与着色器中的解码一致，副切线由法线与切线叉乘重建
+Vertex PackedVertex::Unpack() const
+{
+    Vertex vertex;
+    vertex.Position = Position;
+    vertex.Normal = OctDecode({UnpackSnorm16(Normal[0]), UnpackSnorm16(Normal[1])});
+    vertex.Tangent = OctDecode({UnpackSnorm16(Tangent[0]), UnpackSnorm16(Tangent[1])});
+    vertex.Binormal = glm::cross(vertex.Normal, vertex.Tangent) * (Tangent[1] & 1 ? -1.0f : 1.0f);
+    vertex.TexCoord = {glm::unpackHalf1x16(TexCoord[0]), glm::unpackHalf1x16(TexCoord[1])};
+    return vertex;
+}
+
 Mesh::Mesh(const std::string &filename) : m_filepath(filename)
 {
+    std::filesystem::path cachePath = MeshCache::GetCachePath(filename, ".dmesh");
+    CachedModel cached;
+    if (MeshCache::Load(cachePath, cached) && cached.Meshes.size() == 1)
+    {
+        SetData(cached.File, cached.Meshes[0]);
+        return;
+    }
+
     LogStream::Initialize();
 
     DOO_CORE_INFO("Loading mesh: {0}", filename.c_str());
@@ -51,7 +131,10 @@ Mesh::Mesh(const std::string &filename) : m_filepath(filename)
 
     const aiScene *scene = importer.ReadFile(filename, IMPORT_FLAGS);
     if (!scene || !scene->HasMeshes())
+    {
         DOO_CORE_ERROR("Failed to load mesh file: {0}", filename);
+        return;
+    }
 
     aiMesh *mesh = scene->mMeshes[0];
 
@@ -94,54 +177,127 @@ Mesh::Mesh(const std::string &filename) : m_filepath(filename)
         }
     }
 
-    aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+    MeshOptimizationResult result = MeshOptimizer::Optimize(vertices, indices);
+    DOO_CORE_DEBUG("Optimized mesh {0}: ACMR {1:.3f} -> {2:.3f}, ATVR {3:.3f} -> {4:.3f}, {5} duplicate vertices",
+                   filename, result.Before.ACMR, result.After.ACMR, result.Before.ATVR, result.After.ATVR,
+                   result.RemovedVertexCount);
+    std::vector<MeshLOD> lods = MeshSimplifier::GenerateLODs(vertices, indices);
+
+    // 下次加载直接映射缓存文件
+    ModelData model;
+    model.Meshes.push_back(MeshData::Create(vertices, std::move(indices), std::move(lods)));
+    model.Nodes.push_back({mesh->mName.C_Str(), {{mesh->mName.C_Str(), 0}}});
+    MeshCache::Write(model, cachePath);
+    SetData(std::move(model.Meshes[0]));
+}
+
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<MeshLOD> lods,
+           const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
+           const std::unordered_map<std::string, float> &uniform1f,
+           const std::unordered_map<std::string, glm::vec4> &uniform4f)
+    : m_textures(textures), m_uniform1f(uniform1f), m_uniform4f(uniform4f)
+{
+    SetData(MeshData::Create(vertices, std::move(indices), std::move(lods)));
+}
 
-    ProcessMesh(vertices, indices, {}, {}, {});
+Mesh::Mesh(MeshData &&mesh, const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
+           const std::unordered_map<std::string, float> &uniform1f,
+           const std::unordered_map<std::string, glm::vec4> &uniform4f)
+    : m_textures(textures), m_uniform1f(uniform1f), m_uniform4f(uniform4f)
+{
+    SetData(std::move(mesh));
 }
 
-Mesh::Mesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
+Mesh::Mesh(std::shared_ptr<MappedFile> file, const CachedMesh &mesh,
            const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
            const std::unordered_map<std::string, float> &uniform1f,
            const std::unordered_map<std::string, glm::vec4> &uniform4f)
+    : m_textures(textures), m_uniform1f(uniform1f), m_uniform4f(uniform4f)
+{
+    SetData(std::move(file), mesh);
+}
+
+void Mesh::SetData(MeshData &&mesh)
 {
-    ProcessMesh(vertices, indices, textures, uniform1f, uniform4f);
+    m_vertexStorage = std::move(mesh.Vertices);
+    m_vertices = m_vertexStorage;
+    m_indexStorage = std::move(mesh.Indices);
+    m_indices = m_indexStorage;
+    m_lods = std::move(mesh.LODs);
+    m_boundingBox = mesh.Bounds;
+    m_uvDensity = mesh.UVDensity;
+
+    // 所有网格共享 MeshPool 的顶点/索引缓冲，以便合批和间接绘制
+    m_range = MeshPool::Get()->Allocate(m_vertices, m_indices);
 }
 
-void Mesh::ProcessMesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-                       const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
-                       const std::unordered_map<std::string, float> &uniform1f,
-                       const std::unordered_map<std::string, glm::vec4> &uniform4f)
+void Mesh::SetData(std::shared_ptr<MappedFile> file, const CachedMesh &mesh)
 {
-    m_vertices = vertices;
-    m_indices = indices;
-    m_textures = textures;
-    m_uniform1f = uniform1f;
-    m_uniform4f = uniform4f;
+    m_file = std::move(file);
+    m_vertices = mesh.Vertices;
+    m_indices = mesh.Indices;
+    m_lods = mesh.LODs;
+    if (m_lods.empty())
+        m_lods.push_back({0, static_cast<uint32_t>(m_indices.size()), 0.0f});
+    m_boundingBox = mesh.Bounds;
+    m_uvDensity = mesh.UVDensity;
+
+    // 直接从映射的内存上传，上传前保持映射
+    m_range = MeshPool::Get()->Allocate(m_vertices, m_indices, m_file);
+}
 
-    // Create Vertex Buffer Object
-    m_vertexBuffer = VertexBuffer::Create(m_vertices.data(), m_vertices.size() * sizeof(Vertex));
-    m_vertexBuffer->PushElement("a_PositionOS", VertexDataType::Vec3);
-    m_vertexBuffer->PushElement("a_NormalOS", VertexDataType::Vec3);
-    m_vertexBuffer->PushElement("a_TangentOS", VertexDataType::Vec3);
-    m_vertexBuffer->PushElement("a_BinormalOS", VertexDataType::Vec3);
-    m_vertexBuffer->PushElement("a_TexCoord", VertexDataType::Vec2);
+BoundingBox Mesh::CalculateBoundingBox(std::span<const Vertex> vertices)
+{
+    BoundingBox boundingBox;
+    for (const auto &vertex : vertices)
+        boundingBox.Expand(vertex.Position);
+    return boundingBox;
+}
 
-    // Create Index Buffer Object
-    m_indexBuffer = IndexBuffer::Create(m_indices.data(), m_indices.size() * sizeof(uint32_t));
+float Mesh::CalculateUVDensity(std::span<const Vertex> vertices, std::span<const uint32_t> indices)
+{
+    double uvArea = 0.0, area = 0.0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const auto &v0 = vertices[indices[i]];
+        const auto &v1 = vertices[indices[i + 1]];
+        const auto &v2 = vertices[indices[i + 2]];
+        area += glm::length(glm::cross(v1.Position - v0.Position, v2.Position - v0.Position));
+        glm::vec2 uv1 = v1.TexCoord - v0.TexCoord;
+        glm::vec2 uv2 = v2.TexCoord - v0.TexCoord;
+        uvArea += std::abs(uv1.x * uv2.y - uv1.y * uv2.x);
+    }
+    return area > 0.0 && uvArea > 0.0 ? static_cast<float>(std::sqrt(uvArea / area)) : 1.0f;
+}
 
-    // Create Vertex Array Object
-    m_vertexArray = VertexArray::Create();
-    m_vertexArray->AddVertexBuffer(m_vertexBuffer);
-    m_vertexArray->SetIndexBuffer(m_indexBuffer);
+MeshRange Mesh::GetLODRange(uint32_t lod) const
+{
+    const MeshLOD &meshLOD = m_lods[std::min(lod, GetLODCount() - 1)];
+    MeshRange range = m_range;
+    if (range.IndexCount == 0)
+        return range;
+    range.FirstIndex += meshLOD.FirstIndex;
+    range.IndexCount = meshLOD.IndexCount;
+    return range;
 }
 
 Mesh::~Mesh()
 {
+    MeshPool::Get()->Free(m_range);
 }
 
 void Mesh::Render()
 {
-    m_vertexArray->Render();
+    MeshPool::Get()->Bind();
+    MeshRange range = GetRange();
+    Renderer::DrawIndexed(range.IndexCount, range.FirstIndex, range.BaseVertex);
+}
+
+void Mesh::RenderInstanced(uint32_t instanceCount, uint32_t baseInstance, uint32_t lod)
+{
+    MeshRange range = GetLODRange(lod);
+    MeshPool::Get()->Bind();
+    Renderer::DrawIndexedInstanced(range.IndexCount, instanceCount, range.FirstIndex, range.BaseVertex, baseInstance);
 }
 
 std::shared_ptr<Mesh> Mesh::GetQuad()
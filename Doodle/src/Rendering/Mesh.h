@@ -3,10 +3,13 @@
 #include "pch.h"
 #include <cstdint>
 #include <glm/glm.hpp>
+#include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
 #include "IndexBuffer.h"
+#include "MathUtils.h"
 #include "VertexArray.h"
 #include "VertexBuffer.h"
 
@@ -22,18 +25,62 @@ struct Vertex
     glm::vec3 Binormal;
     glm::vec2 TexCoord;
 };
+
+// 缓存文件与 GPU 中的紧凑顶点，56 字节压缩到 24 字节：法线与切线八面体编码为 snorm16，
+// 切线 y 的最低位存副切线的符号（着色器中由法线与切线叉乘重建副切线），纹理坐标为半精度。
+// 完整的 Vertex 只在导入时处理网格使用
+struct PackedVertex
+{
+    glm::vec3 Position;
+    int16_t Normal[2];
+    int16_t Tangent[2];
+    uint16_t TexCoord[2];
+
+    static PackedVertex Pack(const Vertex &vertex);
+    Vertex Unpack() const;
+};
 #pragma pack(pop)
 
+// 网格在 MeshPool 共享顶点/索引缓冲中的位置
+struct MeshRange
+{
+    int32_t BaseVertex = 0;
+    uint32_t VertexCount = 0;
+    uint32_t FirstIndex = 0;
+    uint32_t IndexCount = 0;
+};
+
+// 一级 LOD 在网格索引中的区间，所有 LOD 共用同一组顶点
+struct MeshLOD
+{
+    uint32_t FirstIndex = 0;
+    uint32_t IndexCount = 0;
+    float Error = 0.0f; // 相对原网格的最大误差，以包围盒对角线为单位
+};
+
 class Texture2D;
+class MappedFile;
+struct CachedMesh;
+struct MeshData;
 class DOO_API Mesh
 {
 public:
     static std::shared_ptr<Mesh> Create(const std::string &filename);
     Mesh(const std::string &filename);
-    Mesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-         const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
-         const std::unordered_map<std::string, float> &uniform1f,
-         const std::unordered_map<std::string, glm::vec4> &uniform4f);
+    // 顶点打包为 PackedVertex 后不再保留；lods 为空时整个索引数组作为唯一的 LOD
+    Mesh(std::vector<Vertex> vertices, std::vector<uint32_t> indices, std::vector<MeshLOD> lods = {},
+         const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures = {},
+         const std::unordered_map<std::string, float> &uniform1f = {},
+         const std::unordered_map<std::string, glm::vec4> &uniform4f = {});
+    // 接管导入时已经打包的顶点与索引
+    Mesh(MeshData &&mesh, const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures = {},
+         const std::unordered_map<std::string, float> &uniform1f = {},
+         const std::unordered_map<std::string, glm::vec4> &uniform4f = {});
+    // 顶点与索引直接引用映射的缓存文件，网格存活期间保持映射
+    Mesh(std::shared_ptr<MappedFile> file, const CachedMesh &mesh,
+         const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures = {},
+         const std::unordered_map<std::string, float> &uniform1f = {},
+         const std::unordered_map<std::string, glm::vec4> &uniform4f = {});
     ~Mesh();
 
     const std::string &GetPath() const
@@ -41,6 +88,8 @@ public:
         return m_filepath;
     }
     void Render();
+    // baseInstance 通过 gl_BaseInstanceARB 传给着色器，用于索引 InstanceBuffer
+    void RenderInstanced(uint32_t instanceCount, uint32_t baseInstance = 0, uint32_t lod = 0);
 
     static std::shared_ptr<Mesh> GetQuad();
     static std::shared_ptr<Mesh> GetCube();
@@ -60,31 +109,74 @@ public:
     {
         return m_uniform4f;
     }
+    std::span<const PackedVertex> GetVertices() const
+    {
+        return m_vertices;
+    }
+    // LOD 0 的索引
+    std::span<const uint32_t> GetIndices() const
+    {
+        return m_indices.subspan(0, m_lods[0].IndexCount);
+    }
     uint32_t GetVertexCount() const
     {
-        return m_vertices.size();
+        return static_cast<uint32_t>(m_vertices.size());
     }
     uint32_t GetFaceCount() const
     {
-        return m_indices.size() / 3;
+        return m_lods[0].IndexCount / 3;
+    }
+    MeshRange GetRange() const
+    {
+        return GetLODRange(0);
+    }
+    MeshRange GetLODRange(uint32_t lod) const;
+    uint32_t GetLODCount() const
+    {
+        return static_cast<uint32_t>(m_lods.size());
+    }
+    const std::vector<MeshLOD> &GetLODs() const
+    {
+        return m_lods;
     }
+    // 模型空间中的误差
+    float GetLODError(uint32_t lod) const
+    {
+        return m_lods[lod].Error * glm::length(m_boundingBox.Max - m_boundingBox.Min);
+    }
+    const BoundingBox &GetBoundingBox() const
+    {
+        return m_boundingBox;
+    }
+    // 每单位模型空间长度对应的 UV 长度，用于估计纹理流式加载需要的 mip
+    float GetUVDensity() const
+    {
+        return m_uvDensity;
+    }
+
+    static BoundingBox CalculateBoundingBox(std::span<const Vertex> vertices);
+    // UV 面积与模型空间面积之比的平方根
+    static float CalculateUVDensity(std::span<const Vertex> vertices, std::span<const uint32_t> indices);
 
 private:
     std::string m_filepath;
-    std::vector<Vertex> m_vertices;
-    std::vector<uint32_t> m_indices;
+    // 顶点与索引指向自身持有的数据或映射的缓存文件
+    std::vector<PackedVertex> m_vertexStorage;
+    std::vector<uint32_t> m_indexStorage;
+    std::shared_ptr<MappedFile> m_file;
+    std::span<const PackedVertex> m_vertices;
+    std::span<const uint32_t> m_indices; // 所有 LOD 的索引依次排列
+    std::vector<MeshLOD> m_lods = {MeshLOD{}};
     std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_textures;
     std::unordered_map<std::string, float> m_uniform1f;
     std::unordered_map<std::string, glm::vec4> m_uniform4f;
 
-    std::shared_ptr<VertexBuffer> m_vertexBuffer;
-    std::shared_ptr<IndexBuffer> m_indexBuffer;
-    std::shared_ptr<VertexArray> m_vertexArray;
+    MeshRange m_range; // 包括所有 LOD
+    BoundingBox m_boundingBox;
+    float m_uvDensity = 1.0f;
 
-    void ProcessMesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
-                     const std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures,
-                     const std::unordered_map<std::string, float> &uniform1f,
-                     const std::unordered_map<std::string, glm::vec4> &uniform4f);
+    void SetData(MeshData &&mesh);
+    void SetData(std::shared_ptr<MappedFile> file, const CachedMesh &mesh);
 };
 
 } // namespace Doodle
@@ -0,0 +1,399 @@
+#include "pch.h"
+#include <cstring>
+#include <type_traits>
+
+#include "Buffer.h"
+#include "FileSystem.h"
+#include "Log.h"
+#include "MeshCache.h"
+#include "Utils.h"
+
+namespace Doodle
+{
+
+static constexpr const char *MESH_CACHE_DIRECTORY = "cache/meshes";
+static constexpr uint32_t MESH_CACHE_MAGIC = 0x48534D44; // "DMSH"
+static constexpr uint64_t MESH_CACHE_ALIGNMENT = 16;
+
+struct MeshCacheHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t VertexSize;
+    uint32_t MeshCount;
+    uint64_t MetadataOffset;
+    uint64_t MetadataSize;
+};
+
+struct MeshCacheEntry
+{
+    uint64_t VertexOffset;
+    uint64_t IndexOffset;
+    uint32_t VertexCount;
+    uint32_t IndexCount;
+    uint32_t MaterialIndex;
+    float UVDensity;
+    glm::vec3 BoundsMin;
+    glm::vec3 BoundsMax;
+};
+
+static_assert(std::is_trivially_copyable_v<MeshCacheEntry>);
+
+static uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + MESH_CACHE_ALIGNMENT - 1) & ~(MESH_CACHE_ALIGNMENT - 1);
+}
+
+// 材质与节点按顺序写入的变长数据
+class MetadataWriter
+{
+public:
+    template <typename T> void Write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+        m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteString(const std::string &value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+        const auto *bytes = reinterpret_cast<const std::byte *>(value.data());
+        m_data.insert(m_data.end(), bytes, bytes + value.size());
+    }
+
+    const std::vector<std::byte> &GetData() const
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<std::byte> m_data;
+};
+
+// 越界时不再读取并记录失败，由调用者最后检查一次
+class MetadataReader
+{
+public:
+    MetadataReader(const std::byte *data, uint64_t size) : m_data(data), m_size(size)
+    {
+    }
+
+    template <typename T> T Read()
+    {
+        T value{};
+        if (m_failed || m_offset + sizeof(T) > m_size)
+        {
+            m_failed = true;
+            return value;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        uint32_t length = Read<uint32_t>();
+        if (m_failed || m_offset + length > m_size)
+        {
+            m_failed = true;
+            return {};
+        }
+        std::string value(reinterpret_cast<const char *>(m_data + m_offset), length);
+        m_offset += length;
+        return value;
+    }
+
+    // 读取元素个数，个数超过剩余字节数时视为损坏，避免按错误的个数分配内存
+    uint32_t ReadCount()
+    {
+        uint32_t count = Read<uint32_t>();
+        if (count > m_size - m_offset)
+            m_failed = true;
+        return m_failed ? 0 : count;
+    }
+
+    bool IsFailed() const
+    {
+        return m_failed;
+    }
+
+private:
+    const std::byte *m_data;
+    uint64_t m_size;
+    uint64_t m_offset = 0;
+    bool m_failed = false;
+};
+
+static void WriteMaterial(MetadataWriter &writer, const MaterialData &material)
+{
+    writer.Write(static_cast<uint32_t>(material.Textures.size()));
+    for (const auto &texture : material.Textures)
+    {
+        writer.WriteString(texture.Name);
+        writer.WriteString(texture.Path);
+        writer.Write(static_cast<uint32_t>(texture.Params.Format));
+        writer.Write(static_cast<uint32_t>(texture.Params.Wrap));
+        writer.Write(static_cast<uint32_t>(texture.Params.Filter));
+        writer.Write(static_cast<uint32_t>(texture.Params.Compression));
+        writer.Write(static_cast<uint32_t>(texture.Params.InvertColor));
+        writer.Write(texture.Params.SourceChannel);
+    }
+    writer.Write(static_cast<uint32_t>(material.Uniform1f.size()));
+    for (const auto &[name, value] : material.Uniform1f)
+    {
+        writer.WriteString(name);
+        writer.Write(value);
+    }
+    writer.Write(static_cast<uint32_t>(material.Uniform4f.size()));
+    for (const auto &[name, value] : material.Uniform4f)
+    {
+        writer.WriteString(name);
+        writer.Write(value);
+    }
+}
+
+static MaterialData ReadMaterial(MetadataReader &reader)
+{
+    MaterialData material;
+    material.Textures.resize(reader.ReadCount());
+    for (auto &texture : material.Textures)
+    {
+        texture.Name = reader.ReadString();
+        texture.Path = reader.ReadString();
+        texture.Params.Format = static_cast<TextureFormat>(reader.Read<uint32_t>());
+        texture.Params.Wrap = static_cast<TextureWrap>(reader.Read<uint32_t>());
+        texture.Params.Filter = static_cast<TextureFilter>(reader.Read<uint32_t>());
+        texture.Params.Compression = static_cast<TextureCompression>(reader.Read<uint32_t>());
+        texture.Params.InvertColor = reader.Read<uint32_t>() != 0;
+        texture.Params.SourceChannel = reader.Read<uint32_t>();
+    }
+    uint32_t uniform1fCount = reader.ReadCount();
+    for (uint32_t i = 0; i < uniform1fCount; i++)
+    {
+        std::string name = reader.ReadString();
+        material.Uniform1f[name] = reader.Read<float>();
+    }
+    uint32_t uniform4fCount = reader.ReadCount();
+    for (uint32_t i = 0; i < uniform4fCount; i++)
+    {
+        std::string name = reader.ReadString();
+        material.Uniform4f[name] = reader.Read<glm::vec4>();
+    }
+    return material;
+}
+
+static void WriteNode(MetadataWriter &writer, const NodeData &node)
+{
+    writer.WriteString(node.Name);
+    writer.Write(static_cast<uint32_t>(node.Meshes.size()));
+    for (const auto &[name, meshIndex] : node.Meshes)
+    {
+        writer.WriteString(name);
+        writer.Write(meshIndex);
+    }
+    writer.Write(static_cast<uint32_t>(node.Children.size()));
+    for (uint32_t child : node.Children)
+        writer.Write(child);
+}
+
+static NodeData ReadNode(MetadataReader &reader)
+{
+    NodeData node;
+    node.Name = reader.ReadString();
+    node.Meshes.resize(reader.ReadCount());
+    for (auto &[name, meshIndex] : node.Meshes)
+    {
+        name = reader.ReadString();
+        meshIndex = reader.Read<uint32_t>();
+    }
+    node.Children.resize(reader.ReadCount());
+    for (auto &child : node.Children)
+        child = reader.Read<uint32_t>();
+    return node;
+}
+
+static void WriteLODs(MetadataWriter &writer, const std::vector<MeshLOD> &lods)
+{
+    writer.Write(static_cast<uint32_t>(lods.size()));
+    for (const auto &lod : lods)
+        writer.Write(lod);
+}
+
+static std::vector<MeshLOD> ReadLODs(MetadataReader &reader, uint32_t indexCount)
+{
+    std::vector<MeshLOD> lods(reader.ReadCount());
+    for (auto &lod : lods)
+    {
+        lod = reader.Read<MeshLOD>();
+        if (static_cast<uint64_t>(lod.FirstIndex) + lod.IndexCount > indexCount)
+            return {};
+    }
+    return lods;
+}
+
+std::filesystem::path MeshCache::GetCachePath(const std::string &filepath, const std::string &extension)
+{
+    uint64_t parameters[] = {VERSION, sizeof(PackedVertex)};
+    uint64_t key = HashBytes(parameters, sizeof(parameters), HashFileStamp(filepath));
+    key = HashBytes(extension.data(), extension.size(), key);
+    return std::filesystem::path(MESH_CACHE_DIRECTORY) / fmt::format("{:016x}{}", key, extension);
+}
+
+bool MeshCache::Load(const std::filesystem::path &cachePath, CachedModel &model)
+{
+    if (!FileSystem::Exists(cachePath))
+        return false;
+    auto file = std::make_shared<MappedFile>(cachePath);
+    if (!*file || file->GetSize() < sizeof(MeshCacheHeader))
+        return false;
+
+    MeshCacheHeader header;
+    std::memcpy(&header, file->GetData(), sizeof(header));
+    uint64_t tableEnd = sizeof(MeshCacheHeader) + static_cast<uint64_t>(header.MeshCount) * sizeof(MeshCacheEntry);
+    bool valid = header.Magic == MESH_CACHE_MAGIC && header.Version == VERSION &&
+                 header.VertexSize == sizeof(PackedVertex) && tableEnd <= file->GetSize() &&
+                 header.MetadataOffset <= file->GetSize() &&
+                 header.MetadataSize <= file->GetSize() - header.MetadataOffset;
+
+    std::vector<CachedMesh> meshes(valid ? header.MeshCount : 0);
+    for (uint32_t i = 0; valid && i < header.MeshCount; i++)
+    {
+        MeshCacheEntry entry;
+        std::memcpy(&entry, file->GetData() + sizeof(MeshCacheHeader) + i * sizeof(MeshCacheEntry), sizeof(entry));
+        uint64_t vertexSize = static_cast<uint64_t>(entry.VertexCount) * sizeof(PackedVertex);
+        uint64_t indexSize = static_cast<uint64_t>(entry.IndexCount) * sizeof(uint32_t);
+        valid = entry.VertexOffset <= file->GetSize() && vertexSize <= file->GetSize() - entry.VertexOffset &&
+                entry.IndexOffset <= file->GetSize() && indexSize <= file->GetSize() - entry.IndexOffset &&
+                entry.VertexOffset % alignof(float) == 0 && entry.IndexOffset % alignof(uint32_t) == 0;
+        if (!valid)
+            break;
+
+        auto &mesh = meshes[i];
+        mesh.Vertices = {reinterpret_cast<const PackedVertex *>(file->GetData() + entry.VertexOffset),
+                         entry.VertexCount};
+        mesh.Indices = {reinterpret_cast<const uint32_t *>(file->GetData() + entry.IndexOffset), entry.IndexCount};
+        mesh.Bounds = BoundingBox(entry.BoundsMin, entry.BoundsMax);
+        mesh.UVDensity = entry.UVDensity;
+        mesh.MaterialIndex = entry.MaterialIndex;
+    }
+
+    std::vector<MaterialData> materials;
+    std::vector<NodeData> nodes;
+    if (valid)
+    {
+        MetadataReader reader(file->GetData() + header.MetadataOffset, header.MetadataSize);
+        materials.resize(reader.ReadCount());
+        for (auto &material : materials)
+            material = ReadMaterial(reader);
+        nodes.resize(reader.ReadCount());
+        for (auto &node : nodes)
+            node = ReadNode(reader);
+        for (auto &mesh : meshes)
+        {
+            mesh.LODs = ReadLODs(reader, static_cast<uint32_t>(mesh.Indices.size()));
+            valid = valid && !mesh.LODs.empty();
+        }
+        valid = valid && !reader.IsFailed() && !nodes.empty();
+    }
+    if (!valid)
+    {
+        DOO_CORE_WARN("Invalid mesh cache: {0}", cachePath.string());
+        return false;
+    }
+
+    model.File = file;
+    model.Meshes = std::move(meshes);
+    model.Materials = std::move(materials);
+    model.Nodes = std::move(nodes);
+    return true;
+}
+
+MeshData MeshData::Create(std::span<const Vertex> vertices, std::vector<uint32_t> indices, std::vector<MeshLOD> lods,
+                          uint32_t materialIndex)
+{
+    MeshData mesh;
+    mesh.Indices = std::move(indices);
+    mesh.MaterialIndex = materialIndex;
+    mesh.LODs = std::move(lods);
+    if (mesh.LODs.empty())
+        mesh.LODs.push_back({0, static_cast<uint32_t>(mesh.Indices.size()), 0.0f});
+    mesh.Bounds = Mesh::CalculateBoundingBox(vertices);
+    mesh.UVDensity = Mesh::CalculateUVDensity(vertices, std::span(mesh.Indices).first(mesh.LODs[0].IndexCount));
+    mesh.Vertices.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        mesh.Vertices[i] = PackedVertex::Pack(vertices[i]);
+    return mesh;
+}
+
+bool MeshCache::Write(const ModelData &model, const std::filesystem::path &cachePath)
+{
+    MetadataWriter writer;
+    writer.Write(static_cast<uint32_t>(model.Materials.size()));
+    for (const auto &material : model.Materials)
+        WriteMaterial(writer, material);
+    writer.Write(static_cast<uint32_t>(model.Nodes.size()));
+    for (const auto &node : model.Nodes)
+        WriteNode(writer, node);
+    for (const auto &mesh : model.Meshes)
+    {
+        if (mesh.LODs.empty())
+            WriteLODs(writer, {{0, static_cast<uint32_t>(mesh.Indices.size()), 0.0f}});
+        else
+            WriteLODs(writer, mesh.LODs);
+    }
+
+    std::vector<MeshCacheEntry> entries(model.Meshes.size());
+    uint64_t offset = sizeof(MeshCacheHeader) + entries.size() * sizeof(MeshCacheEntry);
+    for (size_t i = 0; i < model.Meshes.size(); i++)
+    {
+        const auto &mesh = model.Meshes[i];
+        auto &entry = entries[i];
+        entry.VertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+        entry.IndexCount = static_cast<uint32_t>(mesh.Indices.size());
+        entry.MaterialIndex = mesh.MaterialIndex;
+        entry.UVDensity = mesh.UVDensity;
+        entry.BoundsMin = mesh.Bounds.Min;
+        entry.BoundsMax = mesh.Bounds.Max;
+        entry.VertexOffset = AlignOffset(offset);
+        entry.IndexOffset = AlignOffset(entry.VertexOffset + mesh.Vertices.size() * sizeof(PackedVertex));
+        offset = entry.IndexOffset + mesh.Indices.size() * sizeof(uint32_t);
+    }
+
+    MeshCacheHeader header;
+    header.Magic = MESH_CACHE_MAGIC;
+    header.Version = VERSION;
+    header.VertexSize = sizeof(PackedVertex);
+    header.MeshCount = static_cast<uint32_t>(entries.size());
+    header.MetadataOffset = AlignOffset(offset);
+    header.MetadataSize = writer.GetData().size();
+
+    Buffer buffer;
+    buffer.Allocate(header.MetadataOffset + header.MetadataSize);
+    buffer.ZeroInitialize();
+    buffer.Write(&header, sizeof(header), 0);
+    if (!entries.empty())
+        buffer.Write(entries.data(), entries.size() * sizeof(MeshCacheEntry), sizeof(header));
+    for (size_t i = 0; i < model.Meshes.size(); i++)
+    {
+        const auto &mesh = model.Meshes[i];
+        if (!mesh.Vertices.empty())
+            buffer.Write(mesh.Vertices.data(), mesh.Vertices.size() * sizeof(PackedVertex), entries[i].VertexOffset);
+        if (!mesh.Indices.empty())
+            buffer.Write(mesh.Indices.data(), mesh.Indices.size() * sizeof(uint32_t), entries[i].IndexOffset);
+    }
+    if (header.MetadataSize > 0)
+        buffer.Write(writer.GetData().data(), header.MetadataSize, header.MetadataOffset);
+
+    bool written = FileSystem::WriteBytesAtomic(cachePath, buffer);
+    buffer.Release();
+    if (!written)
+    {
+        DOO_CORE_ERROR("Failed to write mesh cache: {0}", cachePath.string());
+        return false;
+    }
+    return true;
+}
+
+} // namespace Doodle
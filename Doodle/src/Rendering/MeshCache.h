@@ -0,0 +1,101 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MathUtils.h"
+#include "Mesh.h"
+#include "TextureParams.h"
+
+namespace Doodle
+{
+
+struct MaterialTextureData
+{
+    std::string Name; // 材质中的统一变量名
+    std::string Path;
+    TextureParams Params;
+};
+
+struct MaterialData
+{
+    std::vector<MaterialTextureData> Textures;
+    std::unordered_map<std::string, float> Uniform1f;
+    std::unordered_map<std::string, glm::vec4> Uniform4f;
+};
+
+struct NodeData
+{
+    std::string Name;
+    std::vector<std::pair<std::string, uint32_t>> Meshes; // 网格名与网格下标
+    std::vector<uint32_t> Children;
+};
+
+// 导入得到的网格数据，顶点只打包一次，写入缓存与创建网格共用
+struct MeshData
+{
+    std::vector<PackedVertex> Vertices;
+    std::vector<uint32_t> Indices; // 所有 LOD 的索引依次排列
+    uint32_t MaterialIndex = 0;
+    std::vector<MeshLOD> LODs;
+    BoundingBox Bounds;
+    float UVDensity = 1.0f;
+
+    // 包围盒与 UV 密度在打包前由完整精度的顶点计算；lods 为空时整个索引数组作为唯一的 LOD
+    static MeshData Create(std::span<const Vertex> vertices, std::vector<uint32_t> indices,
+                           std::vector<MeshLOD> lods = {}, uint32_t materialIndex = 0);
+};
+
+// 第 0 个节点为根节点
+struct ModelData
+{
+    std::vector<MeshData> Meshes;
+    std::vector<MaterialData> Materials;
+    std::vector<NodeData> Nodes;
+};
+
+// 缓存文件中的网格，顶点与索引直接指向映射的内存
+struct CachedMesh
+{
+    std::span<const PackedVertex> Vertices;
+    std::span<const uint32_t> Indices;
+    BoundingBox Bounds;
+    float UVDensity = 1.0f;
+    uint32_t MaterialIndex = 0;
+    std::vector<MeshLOD> LODs;
+};
+
+struct CachedModel
+{
+    std::shared_ptr<MappedFile> File;
+    std::vector<CachedMesh> Meshes;
+    std::vector<MaterialData> Materials;
+    std::vector<NodeData> Nodes;
+};
+
+// 导入后的网格与模型缓存（.dmesh/.dmodel）：头部与网格表之后是按 16 字节对齐的顶点（PackedVertex）、索引数据，
+// 最后是材质、节点层级与各网格的 LOD。加载时映射整个文件，顶点与索引不经复制直接上传
+class DOO_API MeshCache
+{
+public:
+    // 2: 网格数据经过 MeshOptimizer 优化；3: 增加 LOD；4: 纹理参数增加预乘；5: 顶点存为 PackedVertex；6: 金属度纹理改名
+    // 7: 预乘改为遮罩纹理的来源通道
+    static constexpr uint32_t VERSION = 7;
+
+    // 文件名由源文件路径、大小与修改时间的哈希决定，源文件修改后自动失效
+    static std::filesystem::path GetCachePath(const std::string &filepath, const std::string &extension);
+
+    static bool Load(const std::filesystem::path &cachePath, CachedModel &model);
+    static bool Write(const ModelData &model, const std::filesystem::path &cachePath);
+};
+
+} // namespace Doodle
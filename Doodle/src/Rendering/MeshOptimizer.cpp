@@ -0,0 +1,363 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <numeric>
+
+#include "MeshOptimizer.h"
+#include "Utils.h"
+
+namespace Doodle
+{
+
+static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+// Forsyth 算法按 LRU 缓存估算分数，大小取常见硬件缓存的上限
+static constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+
+// 用时间戳模拟 FIFO 缓存：顶点进入缓存的时刻距今不超过缓存大小时命中
+class FifoCache
+{
+public:
+    FifoCache(uint32_t vertexCount, uint32_t size) : m_timestamps(vertexCount, 0), m_size(size), m_time(size + 1)
+    {
+    }
+
+    // 未命中时返回 true
+    bool Access(uint32_t vertex)
+    {
+        if (m_time - m_timestamps[vertex] <= m_size)
+            return false;
+        m_timestamps[vertex] = m_time++;
+        return true;
+    }
+
+    void Reset()
+    {
+        m_time += m_size + 1;
+    }
+
+private:
+    std::vector<uint32_t> m_timestamps;
+    uint32_t m_size;
+    uint32_t m_time;
+};
+
+static float GetVertexScore(int32_t cachePosition, uint32_t remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        // 最近用过的三个顶点属于刚输出的三角形，给固定分数，避免总是沿着一条长条带走下去
+        if (cachePosition < 3)
+        {
+            score = 0.75f;
+        }
+        else
+        {
+            float scale = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, 1.5f);
+        }
+    }
+    // 剩余三角形越少的顶点越优先，尽早把它用完，避免最后留下零散的三角形
+    score += 2.0f * std::pow(static_cast<float>(remainingTriangles), -0.5f);
+    return score;
+}
+
+MeshOptimizationResult MeshOptimizer::Optimize(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    MeshOptimizationResult result;
+    result.Before = AnalyzeVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+    result.RemovedVertexCount = DeduplicateVertices(vertices, indices);
+    OptimizeVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+    result.After = AnalyzeVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+    return result;
+}
+
+uint32_t MeshOptimizer::DeduplicateVertices(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+    size_t tableSize = 1;
+    while (tableSize < vertices.size() * 2)
+        tableSize <<= 1;
+    size_t mask = tableSize - 1;
+
+    // 开放寻址哈希表，保存 unique 中的下标
+    std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<Vertex> unique;
+    unique.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        size_t slot = HashBytes(&vertices[i], sizeof(Vertex)) & mask;
+        while (table[slot] != INVALID_INDEX &&
+               std::memcmp(&unique[table[slot]], &vertices[i], sizeof(Vertex)) != 0)
+            slot = (slot + 1) & mask;
+
+        if (table[slot] == INVALID_INDEX)
+        {
+            table[slot] = static_cast<uint32_t>(unique.size());
+            unique.push_back(vertices[i]);
+        }
+        remap[i] = table[slot];
+    }
+
+    auto removed = static_cast<uint32_t>(vertices.size() - unique.size());
+    if (removed == 0)
+        return 0;
+
+    for (uint32_t &index : indices)
+        index = remap[index];
+    vertices = std::move(unique);
+    return removed;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // 每个顶点相邻的三角形，前 remaining[v] 个是还没有输出的
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t index : indices)
+        offsets[index + 1]++;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    std::vector<uint32_t> adjacency(indices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        uint32_t vertex = indices[i];
+        adjacency[offsets[vertex] + remaining[vertex]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++)
+        vertexScores[v] = GetVertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                            vertexScores[indices[t * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t cursor = 0;
+    size_t best = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+    while (result.size() < indices.size())
+    {
+        // 缓存中的顶点都没有剩余三角形时，从下一个还没输出的三角形重新开始
+        if (best == INVALID_INDEX)
+        {
+            while (emitted[cursor])
+                cursor++;
+            best = cursor;
+        }
+
+        uint32_t triangle[3] = {indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+        emitted[best] = true;
+        result.insert(result.end(), triangle, triangle + 3);
+
+        // 从相邻列表中移除输出的三角形
+        for (uint32_t vertex : triangle)
+        {
+            uint32_t *begin = adjacency.data() + offsets[vertex];
+            uint32_t *end = begin + remaining[vertex];
+            std::iter_swap(std::find(begin, end, static_cast<uint32_t>(best)), end - 1);
+            remaining[vertex]--;
+        }
+
+        // 三角形的顶点移到缓存最前面，其余顶点依次后移
+        newCache.clear();
+        for (uint32_t vertex : triangle)
+        {
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                newCache.push_back(vertex);
+        }
+        for (uint32_t vertex : cache)
+        {
+            if (std::find(triangle, triangle + 3, vertex) == triangle + 3)
+                newCache.push_back(vertex);
+        }
+
+        // 更新缓存中以及刚被挤出缓存的顶点的分数，同时从它们相邻的三角形中选出下一个
+        best = INVALID_INDEX;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            uint32_t vertex = newCache[i];
+            cachePositions[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+            float score = GetVertexScore(cachePositions[vertex], remaining[vertex]);
+            float delta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+
+            const uint32_t *begin = adjacency.data() + offsets[vertex];
+            for (const uint32_t *it = begin; it != begin + remaining[vertex]; ++it)
+            {
+                triangleScores[*it] += delta;
+                if (triangleScores[*it] > bestScore)
+                {
+                    bestScore = triangleScores[*it];
+                    best = *it;
+                }
+            }
+        }
+
+        if (newCache.size() > FORSYTH_CACHE_SIZE)
+            newCache.resize(FORSYTH_CACHE_SIZE);
+        std::swap(cache, newCache);
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices, float threshold)
+{
+    auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0)
+        return;
+
+    auto vertexCount = static_cast<uint32_t>(vertices.size());
+    FifoCache cache(vertexCount, CACHE_SIZE);
+    auto countMisses = [&](uint32_t triangle) {
+        return static_cast<uint32_t>(cache.Access(indices[triangle * 3])) +
+               static_cast<uint32_t>(cache.Access(indices[triangle * 3 + 1])) +
+               static_cast<uint32_t>(cache.Access(indices[triangle * 3 + 2]));
+    };
+
+    // 硬边界：三个顶点都未命中的三角形，此时缓存相当于冷启动，在这里拆开不影响 ACMR
+    std::vector<uint32_t> hardBoundaries;
+    for (uint32_t t = 0; t < triangleCount; t++)
+    {
+        if (countMisses(t) == 3 || t == 0)
+            hardBoundaries.push_back(t);
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // 软边界：从簇的起点冷启动缓存，累计 ACMR 不超过整个硬簇的 threshold 倍时在此拆开
+    std::vector<uint32_t> clusters;
+    for (size_t i = 0; i + 1 < hardBoundaries.size(); i++)
+    {
+        uint32_t start = hardBoundaries[i];
+        uint32_t end = hardBoundaries[i + 1];
+
+        cache.Reset();
+        uint32_t misses = 0;
+        for (uint32_t t = start; t < end; t++)
+            misses += countMisses(t);
+        float limit = static_cast<float>(misses) / static_cast<float>(end - start) * threshold;
+
+        cache.Reset();
+        clusters.push_back(start);
+        uint32_t clusterStart = start;
+        uint32_t clusterMisses = 0;
+        for (uint32_t t = start; t + 1 < end; t++)
+        {
+            clusterMisses += countMisses(t);
+            if (static_cast<float>(clusterMisses) <= limit * static_cast<float>(t - clusterStart + 1))
+            {
+                clusters.push_back(t + 1);
+                clusterStart = t + 1;
+                clusterMisses = 0;
+                cache.Reset();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    glm::vec3 meshCenter(0.0f);
+    for (const auto &vertex : vertices)
+        meshCenter += vertex.Position;
+    meshCenter /= static_cast<float>(std::max(vertexCount, 1u));
+
+    // 越朝外、离中心越远的簇越可能遮挡其它簇，先绘制
+    auto clusterCount = static_cast<uint32_t>(clusters.size() - 1);
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    for (uint32_t c = 0; c < clusterCount; c++)
+    {
+        glm::vec3 center(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+        {
+            const glm::vec3 &p0 = vertices[indices[t * 3]].Position;
+            const glm::vec3 &p1 = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3 &p2 = vertices[indices[t * 3 + 2]].Position;
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float triangleArea = glm::length(n);
+            center += (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal += n;
+            area += triangleArea;
+        }
+        float normalLength = glm::length(normal);
+        if (area > 0.0f && normalLength > 0.0f)
+            sortKeys[c] = glm::dot(center / area - meshCenter, normal / normalLength);
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (uint32_t c : order)
+        result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex> &vertices, std::span<uint32_t> indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+    for (uint32_t &index : indices)
+    {
+        if (remap[index] == INVALID_INDEX)
+        {
+            remap[index] = static_cast<uint32_t>(result.size());
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(result);
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount,
+                                                   uint32_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indices.size() < 3)
+        return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    uint32_t misses = 0;
+    uint32_t referencedCount = 0;
+    for (uint32_t index : indices)
+    {
+        misses += cache.Access(index) ? 1 : 0;
+        if (!referenced[index])
+        {
+            referenced[index] = true;
+            referencedCount++;
+        }
+    }
+    stats.ACMR = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.ATVR = static_cast<float>(misses) / static_cast<float>(referencedCount);
+    return stats;
+}
+
+} // namespace Doodle
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Mesh.h"
+
+namespace Doodle
+{
+
+// 用 FIFO 顶点缓存模拟得到的统计
+struct VertexCacheStats
+{
+    float ACMR = 0.0f; // 平均每个三角形的缓存未命中数，下限约 0.5
+    float ATVR = 0.0f; // 未命中数与被引用顶点数之比，1 为最优
+};
+
+struct MeshOptimizationResult
+{
+    VertexCacheStats Before;
+    VertexCacheStats After;
+    uint32_t RemovedVertexCount = 0;
+};
+
+// 导入时在 CPU 上对网格做的优化：去重顶点，按顶点缓存重排三角形（Forsyth），
+// 按朝外程度重排三角形簇以减少过度绘制（Sander 等），最后按首次使用的顺序重排顶点并重映射索引
+class DOO_API MeshOptimizer
+{
+public:
+    static constexpr uint32_t CACHE_SIZE = 16;          // 统计 ACMR/ATVR 时模拟的 FIFO 缓存大小
+    static constexpr float OVERDRAW_THRESHOLD = 1.05f; // 为减少过度绘制拆分三角形簇时允许 ACMR 变差的比例
+
+    // 依次执行下面的各个步骤，原地修改顶点与索引
+    static MeshOptimizationResult Optimize(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+    // 合并逐字节相同的顶点，返回移除的顶点数
+    static uint32_t DeduplicateVertices(std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+    static void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount);
+    // 需要在 OptimizeVertexCache 之后执行，三角形簇在缓存冷启动处划分
+    static void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices,
+                                 float threshold = OVERDRAW_THRESHOLD);
+    // 丢弃没有被引用的顶点
+    static void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::span<uint32_t> indices);
+
+    static VertexCacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount,
+                                               uint32_t cacheSize = CACHE_SIZE);
+};
+
+} // namespace Doodle
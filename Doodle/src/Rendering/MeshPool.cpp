@@ -0,0 +1,181 @@
+#include "pch.h"
+#include <algorithm>
+#include <cstddef>
+#include <glad/glad.h>
+
+#include "GPUMemoryTracker.h"
+#include "MeshPool.h"
+#include "Renderer.h"
+
+namespace Doodle
+{
+
+static uint32_t ResizeBuffer(uint32_t buffer, size_t oldSize, size_t newSize)
+{
+    uint32_t newBuffer;
+    glCreateBuffers(1, &newBuffer);
+    glNamedBufferData(newBuffer, newSize, nullptr, GL_STATIC_DRAW);
+    if (buffer)
+    {
+        if (oldSize > 0)
+            glCopyNamedBufferSubData(buffer, newBuffer, 0, 0, oldSize);
+        glDeleteBuffers(1, &buffer);
+    }
+    return newBuffer;
+}
+
+static void SetupAttribute(uint32_t vertexArray, uint32_t index, int componentCount, GLenum type, bool normalized,
+                           size_t offset)
+{
+    glEnableVertexArrayAttrib(vertexArray, index);
+    glVertexArrayAttribFormat(vertexArray, index, componentCount, type, normalized ? GL_TRUE : GL_FALSE, offset);
+    glVertexArrayAttribBinding(vertexArray, index, 0);
+}
+
+MeshPool::MeshPool()
+{
+    Renderer::Submit([this]() {
+        glCreateVertexArrays(1, &m_vertexArrayId);
+        SetupAttribute(m_vertexArrayId, 0, 3, GL_FLOAT, false, offsetof(PackedVertex, Position));
+        SetupAttribute(m_vertexArrayId, 1, 2, GL_SHORT, true, offsetof(PackedVertex, Normal));
+        SetupAttribute(m_vertexArrayId, 2, 2, GL_SHORT, true, offsetof(PackedVertex, Tangent));
+        SetupAttribute(m_vertexArrayId, 4, 2, GL_HALF_FLOAT, false, offsetof(PackedVertex, TexCoord));
+    });
+    Grow(INITIAL_VERTEX_CAPACITY, INITIAL_INDEX_CAPACITY);
+}
+
+MeshRange MeshPool::Allocate(std::span<const PackedVertex> vertices, std::span<const uint32_t> indices,
+                             std::shared_ptr<const void> source)
+{
+    MeshRange range;
+    if (vertices.empty() || indices.empty())
+        return range;
+
+    auto vertexCount = static_cast<uint32_t>(vertices.size());
+    auto indexCount = static_cast<uint32_t>(indices.size());
+
+    uint32_t vertexOffset = m_vertexAllocator.Allocate(vertexCount);
+    uint32_t indexOffset = m_indexAllocator.Allocate(indexCount);
+    if (vertexOffset == RangeAllocator::INVALID_OFFSET || indexOffset == RangeAllocator::INVALID_OFFSET)
+    {
+        m_vertexAllocator.Free(vertexOffset, vertexCount);
+        m_indexAllocator.Free(indexOffset, indexCount);
+
+        uint32_t vertexCapacity = m_vertexAllocator.GetCapacity();
+        uint32_t indexCapacity = m_indexAllocator.GetCapacity();
+        Grow(vertexCapacity + std::max(vertexCapacity, vertexCount),
+             indexCapacity + std::max(indexCapacity, indexCount));
+
+        vertexOffset = m_vertexAllocator.Allocate(vertexCount);
+        indexOffset = m_indexAllocator.Allocate(indexCount);
+    }
+    DOO_CORE_ASSERT(vertexOffset != RangeAllocator::INVALID_OFFSET && indexOffset != RangeAllocator::INVALID_OFFSET,
+                    "MeshPool allocation failed");
+
+    range.BaseVertex = static_cast<int32_t>(vertexOffset);
+    range.VertexCount = vertexCount;
+    range.FirstIndex = indexOffset;
+    range.IndexCount = indexCount;
+
+    auto upload = [this, range](std::span<const PackedVertex> vertices, std::span<const uint32_t> indices) {
+        glNamedBufferSubData(m_vertexBufferId, static_cast<size_t>(range.BaseVertex) * sizeof(PackedVertex),
+                             vertices.size_bytes(), vertices.data());
+        glNamedBufferSubData(m_indexBufferId, static_cast<size_t>(range.FirstIndex) * sizeof(uint32_t),
+                             indices.size_bytes(), indices.data());
+    };
+    if (source)
+    {
+        SubmitUpload([upload, vertices, indices, source]() { upload(vertices, indices); });
+    }
+    else
+    {
+        SubmitUpload([upload, vertices = std::vector<PackedVertex>(vertices.begin(), vertices.end()),
+                      indices = std::vector<uint32_t>(indices.begin(), indices.end())]() {
+            upload(vertices, indices);
+        });
+    }
+    return range;
+}
+
+void MeshPool::Free(const MeshRange &range)
+{
+    if (m_destroyed || range.IndexCount == 0)
+        return;
+
+    m_vertexAllocator.Free(static_cast<uint32_t>(range.BaseVertex), range.VertexCount);
+    m_indexAllocator.Free(range.FirstIndex, range.IndexCount);
+}
+
+void MeshPool::Bind() const
+{
+    Renderer::Submit([this]() { glBindVertexArray(m_vertexArrayId); });
+}
+
+void MeshPool::Reserve(uint32_t vertexCount, uint32_t indexCount)
+{
+    uint32_t vertexCapacity = m_vertexAllocator.GetCapacity();
+    uint32_t indexCapacity = m_indexAllocator.GetCapacity();
+    uint32_t vertexRequired = m_vertexAllocator.GetUsed() + vertexCount;
+    uint32_t indexRequired = m_indexAllocator.GetUsed() + indexCount;
+    if (vertexRequired <= vertexCapacity && indexRequired <= indexCapacity)
+        return;
+    Grow(std::max(vertexCapacity, vertexRequired), std::max(indexCapacity, indexRequired));
+}
+
+void MeshPool::BeginBatch()
+{
+    m_batchDepth++;
+}
+
+void MeshPool::EndBatch()
+{
+    DOO_CORE_ASSERT(m_batchDepth > 0, "MeshPool::EndBatch without BeginBatch");
+    if (--m_batchDepth > 0 || m_pendingUploads.empty())
+        return;
+    // 扩容的提交可能在批内的上传之前执行，上传时才读取缓冲 ID，因此总是写入扩容后的缓冲
+    Renderer::Submit([uploads = std::move(m_pendingUploads)]() {
+        for (const auto &upload : uploads)
+            upload();
+    });
+    m_pendingUploads.clear();
+}
+
+void MeshPool::SubmitUpload(std::function<void()> upload)
+{
+    if (m_batchDepth > 0)
+        m_pendingUploads.push_back(std::move(upload));
+    else
+        Renderer::Submit(std::move(upload));
+}
+
+void MeshPool::Grow(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    uint32_t oldVertexCapacity = m_vertexAllocator.GetCapacity();
+    uint32_t oldIndexCapacity = m_indexAllocator.GetCapacity();
+    m_vertexAllocator.Grow(vertexCapacity);
+    m_indexAllocator.Grow(indexCapacity);
+    vertexCapacity = m_vertexAllocator.GetCapacity();
+    indexCapacity = m_indexAllocator.GetCapacity();
+
+    DOO_CORE_DEBUG("MeshPool grow: vertices={0}, indices={1}", vertexCapacity, indexCapacity);
+    GPUMemoryTracker::Get()->Track(&m_vertexBufferId, GPUMemoryCategory::Geometry, "MeshPool Vertices",
+                                   static_cast<uint64_t>(vertexCapacity) * sizeof(PackedVertex));
+    GPUMemoryTracker::Get()->Track(&m_indexBufferId, GPUMemoryCategory::Geometry, "MeshPool Indices",
+                                   static_cast<uint64_t>(indexCapacity) * sizeof(uint32_t));
+    Renderer::Submit([this, oldVertexCapacity, vertexCapacity, oldIndexCapacity, indexCapacity]() {
+        if (vertexCapacity != oldVertexCapacity)
+        {
+            m_vertexBufferId = ResizeBuffer(m_vertexBufferId, oldVertexCapacity * sizeof(PackedVertex),
+                                            vertexCapacity * sizeof(PackedVertex));
+            glVertexArrayVertexBuffer(m_vertexArrayId, 0, m_vertexBufferId, 0, sizeof(PackedVertex));
+        }
+        if (indexCapacity != oldIndexCapacity)
+        {
+            m_indexBufferId = ResizeBuffer(m_indexBufferId, oldIndexCapacity * sizeof(uint32_t),
+                                           indexCapacity * sizeof(uint32_t));
+            glVertexArrayElementBuffer(m_vertexArrayId, m_indexBufferId);
+        }
+    });
+}
+
+} // namespace Doodle
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Mesh.h"
+#include "RangeAllocator.h"
+#include "Singleton.h"
+
+namespace Doodle
+{
+
+// 所有 Mesh 共用的顶点/索引缓冲与 VAO，网格只记录自己所在的区间
+class DOO_API MeshPool : public Singleton<MeshPool>
+{
+public:
+    MeshPool();
+
+    // source 为空时复制一份顶点与索引等待上传，否则上传时直接读取，source 持有数据直到上传完成
+    MeshRange Allocate(std::span<const PackedVertex> vertices, std::span<const uint32_t> indices,
+                       std::shared_ptr<const void> source = nullptr);
+    void Free(const MeshRange &range);
+    void Bind() const;
+
+    // 一次性扩容到至少能再容纳这么多顶点与索引，批量创建网格前调用以避免反复扩容复制
+    void Reserve(uint32_t vertexCount, uint32_t indexCount);
+    // BeginBatch 与 EndBatch 之间的上传合并为一次提交，可以嵌套
+    void BeginBatch();
+    void EndBatch();
+
+    uint32_t GetVertexArrayID() const
+    {
+        return m_vertexArrayId;
+    }
+    uint32_t GetVertexCapacity() const
+    {
+        return m_vertexAllocator.GetCapacity();
+    }
+    uint32_t GetIndexCapacity() const
+    {
+        return m_indexAllocator.GetCapacity();
+    }
+    uint32_t GetUsedVertexCount() const
+    {
+        return m_vertexAllocator.GetUsed();
+    }
+    uint32_t GetUsedIndexCount() const
+    {
+        return m_indexAllocator.GetUsed();
+    }
+
+private:
+    static constexpr uint32_t INITIAL_VERTEX_CAPACITY = 1 << 18;
+    static constexpr uint32_t INITIAL_INDEX_CAPACITY = 1 << 20;
+
+    RangeAllocator m_vertexAllocator;
+    RangeAllocator m_indexAllocator;
+    uint32_t m_vertexArrayId = 0;
+    uint32_t m_vertexBufferId = 0;
+    uint32_t m_indexBufferId = 0;
+    uint32_t m_batchDepth = 0;
+    std::vector<std::function<void()>> m_pendingUploads;
+
+    void SubmitUpload(std::function<void()> upload);
+    void Grow(uint32_t vertexCapacity, uint32_t indexCapacity);
+};
+
+} // namespace Doodle
@@ -0,0 +1,294 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <unordered_map>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace Doodle
+{
+
+// 对称 4x4 矩阵，只存 10 个元素；按面积加权累加平面，求值时除以总权重得到平均的距离平方
+struct Quadric
+{
+    double A2 = 0.0, B2 = 0.0, C2 = 0.0, D2 = 0.0;
+    double AB = 0.0, AC = 0.0, AD = 0.0, BC = 0.0, BD = 0.0, CD = 0.0;
+    double Weight = 0.0;
+
+    static Quadric FromPlane(const glm::dvec3 &normal, double distance, double weight)
+    {
+        Quadric q;
+        q.A2 = normal.x * normal.x * weight;
+        q.B2 = normal.y * normal.y * weight;
+        q.C2 = normal.z * normal.z * weight;
+        q.D2 = distance * distance * weight;
+        q.AB = normal.x * normal.y * weight;
+        q.AC = normal.x * normal.z * weight;
+        q.AD = normal.x * distance * weight;
+        q.BC = normal.y * normal.z * weight;
+        q.BD = normal.y * distance * weight;
+        q.CD = normal.z * distance * weight;
+        q.Weight = weight;
+        return q;
+    }
+
+    Quadric &operator+=(const Quadric &other)
+    {
+        A2 += other.A2;
+        B2 += other.B2;
+        C2 += other.C2;
+        D2 += other.D2;
+        AB += other.AB;
+        AC += other.AC;
+        AD += other.AD;
+        BC += other.BC;
+        BD += other.BD;
+        CD += other.CD;
+        Weight += other.Weight;
+        return *this;
+    }
+
+    double Evaluate(const glm::vec3 &point) const
+    {
+        double x = point.x, y = point.y, z = point.z;
+        double error = A2 * x * x + B2 * y * y + C2 * z * z + D2 +
+                       2.0 * (AB * x * y + AC * x * z + BC * y * z + AD * x + BD * y + CD * z);
+        return Weight > 0.0 ? std::max(error, 0.0) / Weight : 0.0;
+    }
+};
+
+struct Collapse
+{
+    uint32_t From; // 顶点下标，折叠后引用 From 的索引改为 To
+    uint32_t To;
+    double Error;
+};
+
+struct PositionHash
+{
+    size_t operator()(const glm::vec3 &position) const
+    {
+        uint32_t bits[3];
+        std::memcpy(bits, &position, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+std::vector<uint32_t> MeshSimplifier::Simplify(std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+                                               size_t targetIndexCount, float targetError, float *resultError)
+{
+    std::vector<uint32_t> result(indices.begin(), indices.end());
+    if (resultError)
+        *resultError = 0.0f;
+    auto vertexCount = static_cast<uint32_t>(vertices.size());
+    if (result.size() <= targetIndexCount || vertexCount == 0)
+        return result;
+
+    // 归一化到包围盒对角线为 1，误差直接是相对值
+    BoundingBox bounds = Mesh::CalculateBoundingBox(vertices);
+    float scale = glm::length(bounds.Max - bounds.Min);
+    scale = scale > 0.0f ? 1.0f / scale : 1.0f;
+    std::vector<glm::vec3> positions(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++)
+        positions[i] = (vertices[i].Position - bounds.Min) * scale;
+
+    // 位置相同的顶点（UV 接缝、法线硬边）共用一个位置编号与二次误差，编号取第一个顶点的下标
+    std::vector<uint32_t> positionIds(vertexCount);
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> firstVertices;
+    for (uint32_t i = 0; i < vertexCount; i++)
+        positionIds[i] = firstVertices.try_emplace(vertices[i].Position, i).first->second;
+
+    // 同一位置上被引用的顶点多于一个时位于接缝上；只被一个三角形引用或多于两个三角形共用的边视为边界
+    std::vector<uint32_t> wedgeCounts(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    std::vector<bool> locked(vertexCount, false);
+    std::unordered_map<uint64_t, uint32_t> edgeCounts;
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i + 2 < result.size(); i += 3)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            uint32_t vertex = result[i + k];
+            if (!referenced[vertex])
+            {
+                referenced[vertex] = true;
+                wedgeCounts[positionIds[vertex]]++;
+            }
+            uint32_t a = positionIds[vertex];
+            uint32_t b = positionIds[result[i + (k + 1) % 3]];
+            if (a != b)
+                edgeCounts[static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b)]++;
+        }
+
+        glm::dvec3 p0(positions[result[i]]);
+        glm::dvec3 p1(positions[result[i + 1]]);
+        glm::dvec3 p2(positions[result[i + 2]]);
+        glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+        double area = glm::length(normal);
+        if (area <= 0.0)
+            continue;
+        normal /= area;
+        Quadric quadric = Quadric::FromPlane(normal, -glm::dot(normal, p0), area);
+        for (size_t k = 0; k < 3; k++)
+            quadrics[positionIds[result[i + k]]] += quadric;
+    }
+    for (const auto &[edge, count] : edgeCounts)
+    {
+        if (count != 2)
+        {
+            locked[static_cast<uint32_t>(edge >> 32)] = true;
+            locked[static_cast<uint32_t>(edge & 0xFFFFFFFFu)] = true;
+        }
+    }
+    auto isCollapsible = [&](uint32_t positionId) { return wedgeCounts[positionId] == 1 && !locked[positionId]; };
+
+    double errorLimit = static_cast<double>(targetError) * targetError;
+    double maxError = 0.0;
+    std::vector<uint32_t> offsets(vertexCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<bool> touched(vertexCount);
+    std::vector<Collapse> collapses;
+    // 每一轮按误差从小到大折叠互不相邻的边，直到数量达标或者没有可以折叠的边
+    while (result.size() > targetIndexCount)
+    {
+        // 每个位置相邻的三角形
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (uint32_t vertex : result)
+            offsets[positionIds[vertex] + 1]++;
+        for (uint32_t i = 0; i < vertexCount; i++)
+            offsets[i + 1] += offsets[i];
+        adjacency.resize(result.size());
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < result.size(); i++)
+            adjacency[fill[positionIds[result[i]]]++] = static_cast<uint32_t>(i / 3);
+
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            uint32_t a = result[i];
+            uint32_t b = result[i - i % 3 + (i + 1) % 3];
+            uint32_t idA = positionIds[a];
+            uint32_t idB = positionIds[b];
+            if (idA == idB)
+                continue;
+            Quadric quadric = quadrics[idA];
+            quadric += quadrics[idB];
+            if (isCollapsible(idA))
+                collapses.push_back({a, b, quadric.Evaluate(positions[b])});
+            if (isCollapsible(idB))
+                collapses.push_back({b, a, quadric.Evaluate(positions[a])});
+        }
+        std::erase_if(collapses, [&](const Collapse &collapse) { return collapse.Error > errorLimit; });
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse &a, const Collapse &b) { return a.Error < b.Error; });
+
+        for (uint32_t i = 0; i < vertexCount; i++)
+            remap[i] = i;
+        std::fill(touched.begin(), touched.end(), false);
+        size_t removeGoal = (result.size() - targetIndexCount) / 3 + 1;
+        size_t removed = 0;
+        size_t collapseCount = 0;
+        for (const auto &collapse : collapses)
+        {
+            uint32_t idFrom = positionIds[collapse.From];
+            uint32_t idTo = positionIds[collapse.To];
+            if (touched[idFrom] || touched[idTo])
+                continue;
+
+            // 移动后朝向翻转的三角形会造成折痕，放弃这次折叠
+            bool flipped = false;
+            size_t sharedCount = 0;
+            for (uint32_t j = offsets[idFrom]; j < offsets[idFrom + 1] && !flipped; j++)
+            {
+                const uint32_t *triangle = &result[adjacency[j] * 3];
+                glm::vec3 before[3];
+                glm::vec3 after[3];
+                bool shared = false;
+                for (size_t k = 0; k < 3; k++)
+                {
+                    before[k] = positions[triangle[k]];
+                    after[k] = positionIds[triangle[k]] == idFrom ? positions[collapse.To] : before[k];
+                    shared |= positionIds[triangle[k]] == idTo;
+                }
+                if (shared)
+                {
+                    sharedCount++;
+                    continue;
+                }
+                glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                flipped = glm::dot(normalBefore, normalAfter) <= 0.0f;
+            }
+            if (flipped)
+                continue;
+
+            remap[collapse.From] = collapse.To;
+            quadrics[idTo] += quadrics[idFrom];
+            maxError = std::max(maxError, collapse.Error);
+            collapseCount++;
+            removed += sharedCount;
+
+            // 一环邻域的三角形已经改变，本轮不再参与折叠
+            for (uint32_t j = offsets[idFrom]; j < offsets[idFrom + 1]; j++)
+            {
+                for (size_t k = 0; k < 3; k++)
+                    touched[positionIds[result[adjacency[j] * 3 + k]]] = true;
+            }
+            if (removed >= removeGoal)
+                break;
+        }
+        if (collapseCount == 0)
+            break;
+
+        size_t count = 0;
+        for (size_t i = 0; i + 2 < result.size(); i += 3)
+        {
+            uint32_t a = remap[result[i]];
+            uint32_t b = remap[result[i + 1]];
+            uint32_t c = remap[result[i + 2]];
+            if (positionIds[a] == positionIds[b] || positionIds[b] == positionIds[c] ||
+                positionIds[a] == positionIds[c])
+                continue;
+            result[count++] = a;
+            result[count++] = b;
+            result[count++] = c;
+        }
+        result.resize(count);
+    }
+
+    if (resultError)
+        *resultError = static_cast<float>(std::sqrt(maxError));
+    return result;
+}
+
+std::vector<MeshLOD> MeshSimplifier::GenerateLODs(std::span<const Vertex> vertices, std::vector<uint32_t> &indices)
+{
+    std::vector<MeshLOD> lods;
+    lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+
+    // 每一级从上一级简化，误差逐级累加
+    std::vector<uint32_t> previous = indices;
+    float error = 0.0f;
+    while (lods.size() < MAX_LOD_COUNT && previous.size() / 3 >= MIN_LOD_TRIANGLES * 2)
+    {
+        float levelError = 0.0f;
+        std::vector<uint32_t> simplified =
+            Simplify(vertices, previous, previous.size() / 2, LOD_ERROR_LIMIT, &levelError);
+        // 接缝与边界太多时简化不下去，更粗的级别也不会更好
+        if (simplified.size() > previous.size() * 3 / 4)
+            break;
+
+        MeshOptimizer::OptimizeVertexCache(simplified, static_cast<uint32_t>(vertices.size()));
+        error += levelError;
+        lods.push_back({static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(simplified.size()), error});
+        indices.insert(indices.end(), simplified.begin(), simplified.end());
+        previous = std::move(simplified);
+    }
+    return lods;
+}
+
+} // namespace Doodle
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Mesh.h"
+
+namespace Doodle
+{
+
+// 基于二次误差度量（QEM）的边折叠简化。顶点只折叠到相邻的已有顶点上，结果仍然引用原来的顶点数组，
+// 因此各级 LOD 共用同一份顶点；UV 接缝、开放边界与非流形边上的顶点保持不动
+class DOO_API MeshSimplifier
+{
+public:
+    static constexpr uint32_t MAX_LOD_COUNT = 4;      // 包括原网格
+    static constexpr uint32_t MIN_LOD_TRIANGLES = 64; // 上一级少于两倍这个数时不再生成更粗的 LOD
+    static constexpr float LOD_ERROR_LIMIT = 0.05f;   // 每一级允许的误差，相对包围盒对角线
+
+    // 简化到不超过 targetIndexCount 个索引，或者再折叠就会超过 targetError（相对包围盒对角线）为止；
+    // resultError 返回实际的最大误差
+    static std::vector<uint32_t> Simplify(std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+                                          size_t targetIndexCount, float targetError, float *resultError = nullptr);
+
+    // indices 中原有的三角形作为 LOD 0，更粗的各级每次减半三角形，依次追加在后面
+    static std::vector<MeshLOD> GenerateLODs(std::span<const Vertex> vertices, std::vector<uint32_t> &indices);
+};
+
+} // namespace Doodle
@@ -1,20 +1,32 @@
+#include <algorithm>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
+#include <assimp/ProgressHandler.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "AssetManager.h"
 #include "Entity.h"
 #include "Log.h"
 #include "Mesh.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshPool.h"
+#include "MeshSimplifier.h"
 #include "Model.h"
 #include "Texture.h"
 #include "TextureParams.h"
+#include "TextureStreamer.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 #include "assimp/material.h"
 #include "assimp/mesh.h"
@@ -40,40 +52,69 @@ struct LogStream : public Assimp::LogStream
 namespace Doodle
 {
 
-void Model::LoadTexture(std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures, aiMaterial *material,
-                        std::string name, aiTextureType type, int index, TextureParams params)
+static constexpr float PARSE_PROGRESS = 0.5f;
+static constexpr float EXTRACT_PROGRESS = 0.9f;
+
+// 把 Assimp 的解析进度映射到导入的前半段，回调返回 false 时中止解析
+class ImportProgressHandler : public Assimp::ProgressHandler
 {
-    if (textures.contains(name))
-        return;
+public:
+    explicit ImportProgressHandler(const ModelProgressCallback &callback) : m_callback(callback)
+    {
+    }
+
+    bool Update(float percentage) override
+    {
+        if (m_callback && !m_cancelled && !m_callback(PARSE_PROGRESS * std::clamp(percentage, 0.0f, 1.0f)))
+            m_cancelled = true;
+        return !m_cancelled;
+    }
+
+    bool IsCancelled() const
+    {
+        return m_cancelled;
+    }
+
+private:
+    const ModelProgressCallback &m_callback;
+    bool m_cancelled = false;
+};
+
+static ThreadPool &GetImportThreadPool()
+{
+    static ThreadPool s_Workers;
+    return s_Workers;
+}
+
+void Model::FindTexture(MaterialData &materialData, aiMaterial *material, std::string name, aiTextureType type,
+                        int index, TextureParams params)
+{
+    for (const auto &texture : materialData.Textures)
+    {
+        if (texture.Name == name)
+            return;
+    }
     aiString str;
     aiReturn result = material->GetTexture(type, index, &str);
     if (result != aiReturn_SUCCESS)
         return;
     std::filesystem::path texturePath = std::filesystem::path(m_directory) / str.C_Str();
-    DOO_CORE_INFO("Loading texture: {0}", texturePath.string());
-    if (m_loadedTextures.contains(texturePath.string()))
-    {
-        textures[name] = m_loadedTextures[texturePath.string()];
-        return;
-    }
-    textures[name] = Texture2D::Create(texturePath.string(), params);
-    m_loadedTextures[texturePath.string()] = textures[name];
+    materialData.Textures.push_back({name, texturePath.string(), params});
 }
 
-std::shared_ptr<Mesh> Model::LoadMesh(const aiMesh *mesh, const aiScene *scene)
+static MeshData ExtractMesh(const aiMesh *mesh)
 {
     DOO_CORE_ASSERT(mesh->HasPositions(), "Meshes require positions.");
     DOO_CORE_ASSERT(mesh->HasNormals(), "Meshes require normals.");
     DOO_CORE_ASSERT(mesh->HasTangentsAndBitangents(), "Meshes require tangents and bitangents.");
     DOO_CORE_ASSERT(mesh->HasTextureCoords(0), "Meshes require texture coordinates.");
 
-    std::vector<Vertex> vertices;
-    vertices.reserve(mesh->mNumVertices);
+    std::vector<Vertex> vertices(mesh->mNumVertices);
 
     // Extract vertices from model
     for (size_t i = 0; i < mesh->mNumVertices; i++)
     {
-        Vertex vertex;
+        Vertex &vertex = vertices[i];
         vertex.Position = {mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z};
         vertex.Normal = {mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z};
 
@@ -85,40 +126,73 @@ std::shared_ptr<Mesh> Model::LoadMesh(const aiMesh *mesh, const aiScene *scene)
 
         if (mesh->HasTextureCoords(0))
             vertex.TexCoord = {mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y};
-
-        vertices.push_back(vertex);
     }
 
-    std::vector<uint32_t> indices;
     // Extract indices from model
-    indices.reserve(mesh->mNumFaces * 3); // Each face has 3 indices
+    std::vector<uint32_t> indices(static_cast<size_t>(mesh->mNumFaces) * 3); // Each face has 3 indices
     for (size_t i = 0; i < mesh->mNumFaces; i++)
     {
         DOO_CORE_ASSERT(mesh->mFaces[i].mNumIndices == 3, "Must have 3 indices.");
-        for (unsigned int j = 0; j < mesh->mFaces[i].mNumIndices; j++)
-        {
-            indices.push_back(mesh->mFaces[i].mIndices[j]);
-        }
+        const unsigned int *faceIndices = mesh->mFaces[i].mIndices;
+        indices[i * 3] = faceIndices[0];
+        indices[i * 3 + 1] = faceIndices[1];
+        indices[i * 3 + 2] = faceIndices[2];
     }
 
-    // process the mesh
-    aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
+    // 优化与生成 LOD 的结果写入缓存，之后的加载不再重复
+    MeshOptimizationResult result = MeshOptimizer::Optimize(vertices, indices);
+    DOO_CORE_DEBUG("Optimized mesh {0}: ACMR {1:.3f} -> {2:.3f}, ATVR {3:.3f} -> {4:.3f}, {5} duplicate vertices",
+                   mesh->mName.C_Str(), result.Before.ACMR, result.After.ACMR, result.Before.ATVR, result.After.ATVR,
+                   result.RemovedVertexCount);
+    std::vector<MeshLOD> lods = MeshSimplifier::GenerateLODs(vertices, indices);
+    // 在工作线程上打包，写入缓存与创建网格共用打包后的顶点
+    return MeshData::Create(vertices, std::move(indices), std::move(lods), mesh->mMaterialIndex);
+}
 
-    std::unordered_map<std::string, std::shared_ptr<Texture2D>> textures;
+MaterialData Model::ProcessMaterial(aiMaterial *material)
+{
+    MaterialData materialData;
+    // 按用途选择块压缩格式，首次加载后在后台烘焙
     TextureParams srgbParams;
     srgbParams.Format = TextureFormat::SRGB8ALPHA8;
-    LoadTexture(textures, material, "u_AlbedoTexture", AI_MATKEY_BASE_COLOR_TEXTURE, srgbParams);
-    LoadTexture(textures, material, "u_AlbedoTexture", aiTextureType_DIFFUSE, 0, srgbParams);
-    LoadTexture(textures, material, "u_NormalTexture", aiTextureType_NORMALS);
-    LoadTexture(textures, material, "u_MetalnessTexture", AI_MATKEY_METALLIC_TEXTURE);
-    LoadTexture(textures, material, "u_RoughnessTexture", AI_MATKEY_ROUGHNESS_TEXTURE);
+    srgbParams.Compression = TextureCompression::BC7;
+    srgbParams.Filter = TextureFilter::MipmapLinear;
+    TextureParams normalParams;
+    normalParams.Compression = TextureCompression::BC5;
+    normalParams.Filter = TextureFilter::MipmapLinear;
+    TextureParams maskParams;
+    maskParams.Compression = TextureCompression::BC4;
+    maskParams.Filter = TextureFilter::MipmapLinear;
+    FindTexture(materialData, material, "u_AlbedoTexture", AI_MATKEY_BASE_COLOR_TEXTURE, srgbParams);
+    FindTexture(materialData, material, "u_AlbedoTexture", aiTextureType_DIFFUSE, 0, srgbParams);
+    FindTexture(materialData, material, "u_NormalTexture", aiTextureType_NORMALS, 0, normalParams);
+    FindTexture(materialData, material, "u_MetallicTexture", AI_MATKEY_METALLIC_TEXTURE, maskParams);
+    FindTexture(materialData, material, "u_RoughnessTexture", AI_MATKEY_ROUGHNESS_TEXTURE, maskParams);
     TextureParams invertParams;
     invertParams.InvertColor = true;
-    LoadTexture(textures, material, "u_RoughnessTexture", aiTextureType_SPECULAR, 0, invertParams);
-    LoadTexture(textures, material, "u_RoughnessTexture", aiTextureType_SHININESS, 0, invertParams);
+    invertParams.Compression = TextureCompression::BC4;
+    invertParams.Filter = TextureFilter::MipmapLinear;
+    FindTexture(materialData, material, "u_RoughnessTexture", aiTextureType_SPECULAR, 0, invertParams);
+    FindTexture(materialData, material, "u_RoughnessTexture", aiTextureType_SHININESS, 0, invertParams);
 
-    std::unordered_map<std::string, float> uniform1f;
-    std::unordered_map<std::string, glm::vec4> uniform4f;
+    auto findTexture = [&](const std::string &name) -> MaterialTextureData * {
+        auto it = std::find_if(materialData.Textures.begin(), materialData.Textures.end(),
+                               [&](const MaterialTextureData &texture) { return texture.Name == name; });
+        return it != materialData.Textures.end() ? &*it : nullptr;
+    };
+    // glTF 把粗糙度与金属度打包在同一张纹理的 G、B 通道，导入时拆到各自纹理的 R 通道
+    MaterialTextureData *metallicTexture = findTexture("u_MetallicTexture");
+    MaterialTextureData *roughnessTexture = findTexture("u_RoughnessTexture");
+    if (metallicTexture && roughnessTexture && metallicTexture->Path == roughnessTexture->Path &&
+        !roughnessTexture->Params.InvertColor)
+    {
+        metallicTexture->Params.SourceChannel = 2;
+        roughnessTexture->Params.SourceChannel = 1;
+    }
+
+    auto hasTexture = [&](const std::string &name) { return findTexture(name) != nullptr; };
+    auto &uniform1f = materialData.Uniform1f;
+    auto &uniform4f = materialData.Uniform4f;
 
     aiColor3D color(1.0f);
     float alpha = 1.0f;
@@ -140,70 +214,241 @@ std::shared_ptr<Mesh> Model::LoadMesh(const aiMesh *mesh, const aiScene *scene)
     {
         uniform1f["u_Metallic"] = metallic;
     }
-    if (textures.contains("u_AlbedoTexture"))
+    if (hasTexture("u_AlbedoTexture"))
     {
         uniform4f["u_AlbedoColor"] = {1.0f, 1.0f, 1.0f, alpha};
     }
-    if (textures.contains("u_RoughnessTexture"))
+    if (hasTexture("u_RoughnessTexture"))
     {
         uniform1f["u_Roughness"] = 1.0f;
     }
-    if (textures.contains("u_MetalnessTexture"))
+    if (hasTexture("u_MetallicTexture"))
     {
         uniform1f["u_Metallic"] = 1.0f;
     }
-
-    return std::make_shared<Mesh>(vertices, indices, textures, uniform1f, uniform4f);
+    return materialData;
 }
 
-ModelNode Model::ProcessNode(aiNode *node, const aiScene *scene)
+void Model::ProcessNode(aiNode *node, const aiScene *scene, ModelData &model, uint32_t nodeIndex)
 {
-    ModelNode modelNode{node->mName.C_Str()};
+    model.Nodes[nodeIndex].Name = node->mName.C_Str();
     // process all the node's meshes (if any)
     for (unsigned int i = 0; i < node->mNumMeshes; i++)
     {
         aiMesh *mesh = scene->mMeshes[node->mMeshes[i]];
         aiMaterial *material = scene->mMaterials[mesh->mMaterialIndex];
         std::string name = material->GetName().C_Str();
-        if (modelNode.Meshes.contains(name))
+        auto &meshes = model.Nodes[nodeIndex].Meshes;
+        if (std::any_of(meshes.begin(), meshes.end(), [&](const auto &entry) { return entry.first == name; }))
         {
             name += std::string("_") + std::to_string(i);
         }
-        modelNode.Meshes[name] = LoadMesh(mesh, scene);
+        meshes.emplace_back(name, node->mMeshes[i]);
     }
     // then do the same for each of its children
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        auto child = ProcessNode(node->mChildren[i], scene);
-        modelNode.Children.push_back(child);
+        auto childIndex = static_cast<uint32_t>(model.Nodes.size());
+        model.Nodes[nodeIndex].Children.push_back(childIndex);
+        model.Nodes.emplace_back();
+        ProcessNode(node->mChildren[i], scene, model, childIndex);
+    }
+}
+
+ModelNode Model::BuildNode(const std::vector<NodeData> &nodes, uint32_t nodeIndex,
+                           const std::vector<std::shared_ptr<Mesh>> &meshes)
+{
+    const auto &node = nodes[nodeIndex];
+    ModelNode modelNode{node.Name};
+    for (const auto &[name, meshIndex] : node.Meshes)
+    {
+        if (meshIndex < meshes.size())
+            modelNode.Meshes[name] = meshes[meshIndex];
+    }
+    for (uint32_t child : node.Children)
+    {
+        if (child > nodeIndex && child < nodes.size())
+            modelNode.Children.push_back(BuildNode(nodes, child, meshes));
     }
     return modelNode;
 }
 
-std::shared_ptr<Model> Model::Create(const std::string &filepath)
+// 各网格的顶点与索引在工作线程上并行提取，主线程等待并汇报进度；取消后跳过还未开始的网格
+static bool ExtractMeshes(const aiScene *scene, std::vector<MeshData> &meshes, const ModelProgressCallback &progress)
+{
+    struct ExtractionState
+    {
+        std::mutex Mutex;
+        std::condition_variable Condition;
+        uint32_t Completed = 0;
+        std::atomic<bool> Cancelled = false;
+    };
+    auto state = std::make_shared<ExtractionState>();
+    uint32_t meshCount = scene->mNumMeshes;
+    meshes.resize(meshCount);
+    for (uint32_t i = 0; i < meshCount; i++)
+    {
+        GetImportThreadPool().Enqueue([state, scene, &meshes, i]() {
+            if (!state->Cancelled)
+                meshes[i] = ExtractMesh(scene->mMeshes[i]);
+            std::lock_guard<std::mutex> lock(state->Mutex);
+            state->Completed++;
+            state->Condition.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(state->Mutex);
+    uint32_t reported = 0;
+    while (state->Completed < meshCount)
+    {
+        state->Condition.wait(lock, [&]() { return state->Completed != reported; });
+        reported = state->Completed;
+        if (!progress || state->Cancelled)
+            continue;
+        // 回调不持有锁，避免阻塞工作线程
+        lock.unlock();
+        float fraction = static_cast<float>(reported) / static_cast<float>(meshCount);
+        if (!progress(PARSE_PROGRESS + (EXTRACT_PROGRESS - PARSE_PROGRESS) * fraction))
+            state->Cancelled = true;
+        lock.lock();
+    }
+    return !state->Cancelled;
+}
+
+// 所有材质的纹理在提取网格之前发起异步加载，解码与网格提取并行；相同文件与参数只加载一次。
+// 上传完成前以不影响着色结果的默认纹理占位；同一文件在模型之间由 AssetManager 共享
+static std::vector<std::unordered_map<std::string, std::shared_ptr<Texture2D>>> LoadMaterialTextures(
+    const std::vector<MaterialData> &materials)
 {
-    return std::make_shared<Model>(filepath);
+    std::unordered_map<std::string, std::shared_ptr<Texture2D>> loaded;
+    std::vector<std::unordered_map<std::string, std::shared_ptr<Texture2D>>> textures(materials.size());
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        for (const auto &texture : materials[i].Textures)
+        {
+            TextureParams params = texture.Params;
+            params.Streamable = TextureStreamer::IsStreamedTexture(texture.Name);
+            auto &loadedTexture = loaded[GetTextureKey(texture.Path, params)];
+            if (!loadedTexture)
+            {
+                DOO_CORE_INFO("Loading texture: {0}", texture.Path);
+                auto placeholder = texture.Name == "u_NormalTexture" ? Texture2D::GetDefaultNormalTexture()
+                                                                     : Texture2D::GetWhiteTexture();
+                loadedTexture = AssetManager::Get()->LoadTexture(texture.Path, params, true, placeholder);
+            }
+            textures[i][texture.Name] = loadedTexture;
+        }
+    }
+    return textures;
 }
 
-Model::Model(const std::string &filepath)
+std::shared_ptr<Model> Model::Create(const std::string &filepath, const ModelProgressCallback &progress)
+{
+    return std::make_shared<Model>(filepath, progress);
+}
+
+// 导入分为几个阶段：Assimp 解析，发起纹理的异步解码，工作线程上并行提取网格，最后在主线程上创建网格并批量上传
+Model::Model(const std::string &filepath, const ModelProgressCallback &progress)
 {
-    LogStream::Initialize();
     DOO_CORE_INFO("Loading model: {0}", filepath.c_str());
+    // retrieve the directory path of the filepath
+    m_filepath = NormalizePath(filepath);
+    m_directory = GetDirectory(m_filepath);
+
+    std::filesystem::path cachePath = MeshCache::GetCachePath(m_filepath, ".dmodel");
+    CachedModel cached;
+    if (MeshCache::Load(cachePath, cached))
+    {
+        auto textures = LoadMaterialTextures(cached.Materials);
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        for (const auto &mesh : cached.Meshes)
+        {
+            vertexCount += static_cast<uint32_t>(mesh.Vertices.size());
+            indexCount += static_cast<uint32_t>(mesh.Indices.size());
+        }
+        MeshPool::Get()->Reserve(vertexCount, indexCount);
+
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        MeshPool::Get()->BeginBatch();
+        for (const auto &mesh : cached.Meshes)
+        {
+            if (mesh.MaterialIndex >= cached.Materials.size())
+            {
+                meshes.push_back(std::make_shared<Mesh>(cached.File, mesh));
+                continue;
+            }
+            const auto &material = cached.Materials[mesh.MaterialIndex];
+            meshes.push_back(std::make_shared<Mesh>(cached.File, mesh, textures[mesh.MaterialIndex],
+                                                    material.Uniform1f, material.Uniform4f));
+        }
+        MeshPool::Get()->EndBatch();
+        m_root = BuildNode(cached.Nodes, 0, meshes);
+        m_valid = true;
+        if (progress)
+            progress(1.0f);
+        return;
+    }
+
+    LogStream::Initialize();
     Assimp::Importer importer;
+    // importer 析构时释放进度处理器
+    auto *progressHandler = new ImportProgressHandler(progress);
+    importer.SetProgressHandler(progressHandler);
     const aiScene *scene =
         importer.ReadFile(filepath, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace);
+    if (progressHandler->IsCancelled())
+    {
+        DOO_CORE_INFO("Model import cancelled: {0}", filepath);
+        m_cancelled = true;
+        return;
+    }
     // check for errors
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
     {
         DOO_CORE_ERROR("ERROR::ASSIMP::{0}", importer.GetErrorString());
         return;
     }
-    // retrieve the directory path of the filepath
-    m_filepath = NormalizePath(filepath);
-    m_directory = GetDirectory(m_filepath);
 
+    ModelData model;
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++)
+        model.Materials.push_back(ProcessMaterial(scene->mMaterials[i]));
     // process ASSIMP's root node recursively
-    m_root = ProcessNode(scene->mRootNode, scene);
+    model.Nodes.emplace_back();
+    ProcessNode(scene->mRootNode, scene, model, 0);
+    auto textures = LoadMaterialTextures(model.Materials);
+    if (!ExtractMeshes(scene, model.Meshes, progress))
+    {
+        DOO_CORE_INFO("Model import cancelled: {0}", filepath);
+        m_cancelled = true;
+        return;
+    }
+    // 下次加载直接映射缓存文件，跳过 Assimp 导入
+    MeshCache::Write(model, cachePath);
+
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    for (const auto &mesh : model.Meshes)
+    {
+        vertexCount += static_cast<uint32_t>(mesh.Vertices.size());
+        indexCount += static_cast<uint32_t>(mesh.Indices.size());
+    }
+    MeshPool::Get()->Reserve(vertexCount, indexCount);
+
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    MeshPool::Get()->BeginBatch();
+    for (auto &mesh : model.Meshes)
+    {
+        uint32_t materialIndex = mesh.MaterialIndex;
+        const auto &material = model.Materials[materialIndex];
+        meshes.push_back(std::make_shared<Mesh>(std::move(mesh), textures[materialIndex], material.Uniform1f,
+                                                material.Uniform4f));
+    }
+    MeshPool::Get()->EndBatch();
+    m_root = BuildNode(model.Nodes, 0, meshes);
+    m_valid = true;
+    if (progress)
+        progress(1.0f);
 }
 
-} // namespace Doodle
\ No newline at end of file
+} // namespace Doodle
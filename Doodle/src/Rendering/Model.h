@@ -2,6 +2,7 @@
 
 #include "TextureParams.h"
 #include "pch.h"
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,6 +19,9 @@ enum aiTextureType; // NOLINT
 namespace Doodle
 {
 class Entity;
+struct MaterialData;
+struct ModelData;
+struct NodeData;
 
 struct ModelNode
 {
@@ -26,27 +30,43 @@ struct ModelNode
     std::vector<ModelNode> Children;
 };
 
+// 导入进度回调，progress 在 [0, 1] 之间，在调用导入的线程上执行；返回 false 取消导入，得到空模型
+using ModelProgressCallback = std::function<bool(float progress)>;
+
 class DOO_API Model
 {
 public:
-    static std::shared_ptr<Model> Create(const std::string &filepath);
-    Model(const std::string &filepath);
+    static std::shared_ptr<Model> Create(const std::string &filepath, const ModelProgressCallback &progress = nullptr);
+    Model(const std::string &filepath, const ModelProgressCallback &progress = nullptr);
     ModelNode GetRootNode() const
     {
         return m_root;
     }
 
+    // 导入失败或被取消时为空模型
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    bool IsCancelled() const
+    {
+        return m_cancelled;
+    }
+
 private:
     std::string m_filepath;
     std::string m_directory;
     ModelNode m_root;
-    std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_loadedTextures;
-
-    ModelNode ProcessNode(aiNode *node, const aiScene *scene);
+    bool m_valid = false;
+    bool m_cancelled = false;
 
-    void LoadTexture(std::unordered_map<std::string, std::shared_ptr<Texture2D>> &textures, aiMaterial *material,
-                     std::string name, aiTextureType type, int index = 0, TextureParams params = TextureParams());
+    void ProcessNode(aiNode *node, const aiScene *scene, ModelData &model, uint32_t nodeIndex);
+    MaterialData ProcessMaterial(aiMaterial *material);
+    void FindTexture(MaterialData &materialData, aiMaterial *material, std::string name, aiTextureType type,
+                     int index = 0, TextureParams params = TextureParams());
 
-    std::shared_ptr<Mesh> LoadMesh(const aiMesh *mesh, const aiScene *scene);
+    ModelNode BuildNode(const std::vector<NodeData> &nodes, uint32_t nodeIndex,
+                        const std::vector<std::shared_ptr<Mesh>> &meshes);
 };
 } // namespace Doodle
\ No newline at end of file
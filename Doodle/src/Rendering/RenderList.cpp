@@ -0,0 +1,70 @@
+#include "pch.h"
+#include <algorithm>
+
+#include "Component.h"
+#include "RenderList.h"
+#include "Scene.h"
+
+namespace Doodle
+{
+
+static RenderItem CreateRenderItem(entt::entity entity, const TransformComponent &transform,
+                                   const MaterialComponent &material)
+{
+    RenderItem item;
+    item.Model = transform.GetTransformMatrix();
+    item.NormalMatrix = glm::transpose(glm::inverse(glm::mat3(item.Model)));
+    item.MaterialInstance = material.MaterialInstance.get();
+    item.Entity = entity;
+    if (transform.Static)
+        item.Flags = item.Flags | RenderItemFlags::Static;
+    return item;
+}
+
+void RenderList::Extract(Scene *scene, uint32_t viewportHeight)
+{
+    m_meshItems.clear();
+    m_vertexArrayItems.clear();
+
+    const auto &camera = scene->GetData().CameraData;
+    bool perspective = camera.Projection[3][3] == 0.0f;
+    // 距离为 1 处世界空间单位长度对应的像素数，正交投影与距离无关
+    float pixelsPerUnitScale = camera.Projection[1][1] * static_cast<float>(viewportHeight) * 0.5f;
+
+    auto meshView = scene->View<TransformComponent, MeshComponent, MaterialComponent>();
+    for (auto entity : meshView)
+    {
+        const auto &transform = meshView.get<TransformComponent>(entity);
+        auto &mesh = meshView.get<MeshComponent>(entity);
+        const auto &material = meshView.get<MaterialComponent>(entity);
+
+        RenderItem &item = m_meshItems.emplace_back(CreateRenderItem(entity, transform, material));
+        item.Mesh = mesh.Mesh.get();
+        item.WorldBounds = mesh.Mesh->GetBoundingBox().Transform(item.Model);
+
+        float maxScale = std::max({glm::length(glm::vec3(item.Model[0])), glm::length(glm::vec3(item.Model[1])),
+                                   glm::length(glm::vec3(item.Model[2]))});
+        float pixelsPerUnit = pixelsPerUnitScale * maxScale;
+        if (perspective && item.WorldBounds.IsValid())
+        {
+            float radius = glm::length(item.WorldBounds.GetExtents());
+            float distance = std::max(glm::length(item.WorldBounds.GetCenter() - camera.Position) - radius, 0.1f);
+            pixelsPerUnit /= distance;
+        }
+        item.LOD = mesh.SelectLOD(pixelsPerUnit, m_lodPixelError);
+        item.ShadowLOD = std::min(item.LOD + m_shadowLODBias, mesh.Mesh->GetLODCount() - 1);
+    }
+
+    auto vaoView = scene->View<TransformComponent, VAOComponent, MaterialComponent>();
+    for (auto entity : vaoView)
+    {
+        const auto &transform = vaoView.get<TransformComponent>(entity);
+        const auto &vao = vaoView.get<VAOComponent>(entity);
+        const auto &material = vaoView.get<MaterialComponent>(entity);
+
+        RenderItem &item = m_vertexArrayItems.emplace_back(CreateRenderItem(entity, transform, material));
+        item.VertexArray = vao.VAO.get();
+    }
+}
+
+} // namespace Doodle
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "MathUtils.h"
+#include "Singleton.h"
+
+namespace Doodle
+{
+
+enum class RenderItemFlags : uint32_t
+{
+    None = 0,
+    Static = 1 << 0,
+};
+
+inline RenderItemFlags operator|(RenderItemFlags lhs, RenderItemFlags rhs)
+{
+    return static_cast<RenderItemFlags>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+
+inline RenderItemFlags operator&(RenderItemFlags lhs, RenderItemFlags rhs)
+{
+    return static_cast<RenderItemFlags>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+}
+
+class Mesh;
+class VertexArray;
+class MaterialInstance;
+// 指针在提取所在的帧内有效，资源由场景中的组件持有
+struct RenderItem
+{
+    glm::mat4 Model;
+    glm::mat3 NormalMatrix;
+    BoundingBox WorldBounds;
+    Mesh *Mesh = nullptr;
+    VertexArray *VertexArray = nullptr;
+    MaterialInstance *MaterialInstance = nullptr;
+    entt::entity Entity = entt::null;
+    RenderItemFlags Flags = RenderItemFlags::None;
+    uint32_t LOD = 0;
+    uint32_t ShadowLOD = 0;
+
+    bool IsStatic() const
+    {
+        return (Flags & RenderItemFlags::Static) != RenderItemFlags::None;
+    }
+};
+
+class Scene;
+// 每帧从场景中提取一次可渲染物体，所有 Pass 共享同一份列表而不再各自遍历 ECS
+class DOO_API RenderList : public Singleton<RenderList>
+{
+public:
+    // viewportHeight 用于把 LOD 误差换算为像素
+    void Extract(Scene *scene, uint32_t viewportHeight);
+
+    const std::vector<RenderItem> &GetMeshItems() const
+    {
+        return m_meshItems;
+    }
+
+    const std::vector<RenderItem> &GetVertexArrayItems() const
+    {
+        return m_vertexArrayItems;
+    }
+
+    // 选择 LOD 时允许的屏幕空间误差（像素）
+    float GetLODPixelError() const
+    {
+        return m_lodPixelError;
+    }
+    void SetLODPixelError(float pixelError)
+    {
+        m_lodPixelError = pixelError;
+    }
+    // 阴影贴图分辨率低，在主视图的 LOD 上再粗几级
+    uint32_t GetShadowLODBias() const
+    {
+        return m_shadowLODBias;
+    }
+    void SetShadowLODBias(uint32_t bias)
+    {
+        m_shadowLODBias = bias;
+    }
+
+private:
+    std::vector<RenderItem> m_meshItems;
+    std::vector<RenderItem> m_vertexArrayItems;
+    float m_lodPixelError = 1.0f;
+    uint32_t m_shadowLODBias = 1;
+};
+
+} // namespace Doodle
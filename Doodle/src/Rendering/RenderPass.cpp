@@ -3,4 +3,14 @@
 namespace Doodle
 {
 
+void RenderPass::SetViewData(const UBOView &viewData)
+{
+    if (!m_viewUniformBuffer)
+        m_viewUniformBuffer = UniformBuffer::Create(sizeof(UBOView), true);
+
+    m_viewData = viewData;
+    m_viewUniformBuffer->SetSubData(&m_viewData, sizeof(UBOView));
+    m_viewUniformBuffer->Bind(VIEW_UNIFORM_BINDING);
+}
+
 } // namespace Doodle
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Framebuffer.h"
 #include "RenderPipeline.h"
 #include "Scene.h"
+#include "UniformBuffer.h"
+#include "ViewData.h"
 
 namespace Doodle
 {
@@ -23,6 +25,8 @@ class DOO_API RenderPass
     friend class RenderPipeline;
 
 public:
+    static constexpr uint32_t VIEW_UNIFORM_BINDING = 4;
+
     RenderPass(const RenderPassSpecification &specification) : m_specification(specification)
     {
     }
@@ -58,9 +62,16 @@ public:
     }
 
 protected:
+    // 每个 Pass 上传一次视图常量并绑定到 VIEW_UNIFORM_BINDING，数据保存在 Pass 中直到渲染命令执行
+    void SetViewData(const UBOView &viewData);
+
     RenderPassSpecification m_specification;
     std::unordered_map<std::string, RenderPassInput> m_inputs;
     Scene *m_scene = nullptr;
+
+private:
+    UBOView m_viewData;
+    std::shared_ptr<UniformBuffer> m_viewUniformBuffer;
 };
 
 } // namespace Doodle
\ No newline at end of file
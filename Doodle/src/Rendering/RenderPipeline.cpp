@@ -1,13 +1,22 @@
 #include "RenderPipeline.h"
 #include "BloomPass.h"
+#include "GPUScene.h"
+#include "InstanceBatcher.h"
+#include "MaterialTable.h"
 #include "GeometryPass.h"
 #include "OcclusionPass.h"
 #include "PreDepthPass.h"
+#include "RenderList.h"
 #include "SceneRenderer.h"
+#include "StaticBatcher.h"
 #include "ShadingPass.h"
 #include "ShadowPass.h"
 #include "SkyboxPass.h"
+#include "TextureStreamer.h"
+#include "UpscalePass.h"
 #include "Utils.h"
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
 #include <unordered_map>
 
 namespace Doodle
@@ -20,11 +29,14 @@ RenderPipeline::RenderPipeline()
     m_uniformBuffers["SpotLightData"] = UniformBuffer::Create(sizeof(UBOSpotLights), true);
     m_uniformBuffers["AreaLightData"] = UniformBuffer::Create(sizeof(UBOAreaLights), true);
 
+    m_frameBuffers["SceneColor"] = FrameBuffer::Create(
+        {1920, 1080, {FramebufferTextureFormat::RGBA16F, FramebufferTextureFormat::DEPTH24STENCIL8}});
     m_frameBuffers["PreDepthMap"] = FrameBuffer::Create({1920, 1080, {FramebufferTextureFormat::Depth}});
     m_frameBuffers["GBuffer"] = FrameBuffer::Create(
         {1920,
          1080,
-         {FramebufferTextureFormat::RGBA16F, FramebufferTextureFormat::RGBA16F, FramebufferTextureFormat::Depth}});
+         {FramebufferTextureFormat::RGBA16F, FramebufferTextureFormat::RGBA16F, FramebufferTextureFormat::RGBA16F,
+          FramebufferTextureFormat::Depth}});
     m_frameBuffers["ShadowMap"] = FrameBuffer::Create({8192, 8192, {FramebufferTextureFormat::Depth}});
 
     m_frameBuffers["OcclusionMap"] = FrameBuffer::Create({1920, 1080, {FramebufferTextureFormat::RGBA8}});
@@ -32,13 +44,16 @@ RenderPipeline::RenderPipeline()
 
 void RenderPipeline::RegisterRenderPasses()
 {
-    CreateRenderPass<SkyboxPass>("SkyboxPass", {m_targetFrameBuffer});
-    CreateRenderPass<PreDepthPass>("PreDepthPass", {m_targetFrameBuffer});
+    // 场景 Pass 渲染到渲染分辨率的 SceneColor，最后由 UpscalePass 输出到目标分辨率
+    auto sceneColor = m_frameBuffers["SceneColor"];
+    CreateRenderPass<SkyboxPass>("SkyboxPass", {sceneColor});
+    CreateRenderPass<PreDepthPass>("PreDepthPass", {sceneColor});
     CreateRenderPass<GeometryPass>("GeometryPass", {m_frameBuffers["GBuffer"]});
     CreateRenderPass<OcclusionPass>("OcclusionPass", {m_frameBuffers["OcclusionMap"]});
     CreateRenderPass<ShadowPass>("ShadowPass", {m_frameBuffers["ShadowMap"]});
-    CreateRenderPass<ShadingPass>("ShadingPass", {m_targetFrameBuffer});
-    CreateRenderPass<BloomPass>("BloomPass", {m_targetFrameBuffer});
+    CreateRenderPass<ShadingPass>("ShadingPass", {sceneColor});
+    CreateRenderPass<BloomPass>("BloomPass", {sceneColor});
+    CreateRenderPass<UpscalePass>("UpscalePass", {m_targetFrameBuffer});
 }
 
 std::unordered_map<std::string, std::shared_ptr<RenderPass>> RenderPipeline::GetRenderPasses()
@@ -53,17 +68,21 @@ std::unordered_map<std::string, std::shared_ptr<FrameBuffer>> RenderPipeline::Ge
 
 void RenderPipeline::AddRenderPass(const std::string &name, std::shared_ptr<RenderPass> renderPass)
 {
+    // 按注册顺序执行
+    if (!m_renderPasses.contains(name))
+        m_renderPassOrder.push_back(name);
     m_renderPasses[name] = renderPass;
 }
 
 template <typename T>
 void RenderPipeline::CreateRenderPass(const std::string &name, const RenderPassSpecification &specification)
 {
-    m_renderPasses[name] = std::make_shared<T>(specification);
+    AddRenderPass(name, std::make_shared<T>(specification));
 }
 void RenderPipeline::RemoveRenderPass(const std::string &name)
 {
     m_renderPasses.erase(name);
+    std::erase(m_renderPassOrder, name);
 }
 std::shared_ptr<RenderPass> RenderPipeline::GetRenderPass(const std::string &name)
 {
@@ -72,22 +91,39 @@ std::shared_ptr<RenderPass> RenderPipeline::GetRenderPass(const std::string &nam
 void RenderPipeline::BeginScene(Scene *scene)
 {
     m_scene = scene;
-    for (const auto &[name, renderPass] : m_renderPasses)
+    m_previousViewProjectionValid = false;
+    for (const auto &name : m_renderPassOrder)
     {
+        auto &renderPass = m_renderPasses[name];
         renderPass->m_scene = scene;
         renderPass->BeginScene();
     }
 }
 void RenderPipeline::EndScene()
 {
-    for (const auto &[name, renderPass] : m_renderPasses)
+    for (const auto &name : m_renderPassOrder)
     {
-        renderPass->EndScene();
+        m_renderPasses[name]->EndScene();
     }
 }
 void RenderPipeline::Execute()
 {
     auto &sceneData = m_scene->GetData();
+    UpdateRenderResolution();
+    auto sceneColor = m_frameBuffers["SceneColor"];
+
+    // 抖动只作用于本帧的场景 Pass，执行完毕后恢复相机矩阵；运动矢量使用未抖动的矩阵计算
+    const glm::mat4 projection = sceneData.CameraData.Projection;
+    const glm::mat4 viewProjection = sceneData.CameraData.ViewProjection;
+    glm::vec2 jitter = m_upscaleMode == UpscaleMode::Temporal ? NextJitter() : glm::vec2(0.0f);
+    glm::vec2 jitterNDC = jitter * 2.0f / glm::vec2(sceneColor->GetWidth(), sceneColor->GetHeight());
+    sceneData.CameraData.Projection = glm::translate(glm::mat4(1.0f), glm::vec3(jitterNDC, 0.0f)) * projection;
+    sceneData.CameraData.ViewProjection = sceneData.CameraData.Projection * sceneData.CameraData.View;
+    SetUniform2f("u_Jitter", jitter);
+    SetUniformMatrix4f("u_UnjitteredViewProjection", viewProjection);
+    SetUniformMatrix4f("u_PreviousViewProjection",
+                       m_previousViewProjectionValid ? m_previousViewProjection : viewProjection);
+
     {
         static UBOScene s_UboScene = {};
         // 赋值directional light
@@ -100,7 +136,10 @@ void RenderPipeline::Execute()
         s_UboScene.EnvironmentRotation = sceneData.EnvironmentData.Rotation;
         s_UboScene.ShadowBias = sceneData.ShadowBias;
         s_UboScene.ShadowNormalBias = sceneData.ShadowNormalBias;
-        s_UboScene.Resolution = {m_targetFrameBuffer->GetWidth(), m_targetFrameBuffer->GetHeight()};
+        s_UboScene.Resolution = {sceneColor->GetWidth(), sceneColor->GetHeight()};
+        const auto &irradiance = sceneData.EnvironmentData.Irradiance;
+        for (uint32_t i = 0; i < IrradianceSH::COEFFICIENT_COUNT; i++)
+            s_UboScene.IrradianceSH[i] = irradiance ? irradiance->Coefficients[i] : glm::vec4(0.0f);
         m_uniformBuffers["SceneData"]->SetSubData(&s_UboScene, sizeof(UBOScene));
 
         static UBOPointLights s_UboPointLights = {};
@@ -122,12 +161,60 @@ void RenderPipeline::Execute()
         m_uniformBuffers["AreaLightData"]->SetSubData(&s_UboAreaLights, sizeof(UBOAreaLights));
     }
 
-    for (const auto &[name, renderPass] : m_renderPasses)
+    // 每帧只遍历一次场景，后续的合批与各个 Pass 都读取 RenderList
+    RenderList::Get()->Extract(m_scene, sceneColor->GetHeight());
+    // 流式纹理切换常驻 mip 会改变句柄，需要在材质表更新之前
+    TextureStreamer::Get()->Update(sceneData.CameraData.Position, projection, sceneColor->GetHeight());
+    MaterialTable::Get()->Update();
+    StaticBatcher::Get()->Update(m_scene);
+    InstanceBatcher::Get()->Update();
+    if (m_gpuDriven)
+        GPUScene::Get()->Update();
+
+    sceneColor->Bind();
+    Renderer::Clear();
+    sceneColor->Unbind();
+
+    for (const auto &name : m_renderPassOrder)
     {
+        auto &renderPass = m_renderPasses[name];
         renderPass->GetSpecification().TargetFrameBuffer->Bind();
         renderPass->Execute();
         renderPass->GetSpecification().TargetFrameBuffer->Unbind();
     }
+
+    sceneData.CameraData.Projection = projection;
+    sceneData.CameraData.ViewProjection = viewProjection;
+    m_previousViewProjection = viewProjection;
+    m_previousViewProjectionValid = true;
+}
+
+void RenderPipeline::UpdateRenderResolution()
+{
+    auto width = static_cast<uint32_t>(std::round(m_targetFrameBuffer->GetWidth() * m_renderScale));
+    auto height = static_cast<uint32_t>(std::round(m_targetFrameBuffer->GetHeight() * m_renderScale));
+    m_frameBuffers["SceneColor"]->Resize(std::max(width, 1u), std::max(height, 1u));
+}
+
+static float Halton(uint32_t index, uint32_t base)
+{
+    float result = 0.0f;
+    float fraction = 1.0f;
+    while (index > 0)
+    {
+        fraction /= static_cast<float>(base);
+        result += fraction * static_cast<float>(index % base);
+        index /= base;
+    }
+    return result;
+}
+
+glm::vec2 RenderPipeline::NextJitter()
+{
+    // Halton(2, 3) 序列，单位为渲染分辨率的像素；渲染分辨率越低，需要越多的相位覆盖每个输出像素
+    auto phaseCount = static_cast<uint32_t>(std::ceil(8.0f / (m_renderScale * m_renderScale)));
+    m_jitterIndex = (m_jitterIndex + 1) % phaseCount;
+    return {Halton(m_jitterIndex + 1, 2) - 0.5f, Halton(m_jitterIndex + 1, 3) - 0.5f};
 }
 
 void RenderPipeline::SetTargetFrameBuffer(std::shared_ptr<FrameBuffer> targetFrameBuffer)
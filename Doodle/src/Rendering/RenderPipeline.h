@@ -7,6 +7,7 @@
 #include "Light.h"
 #include "Singleton.h"
 #include "UniformBuffer.h"
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +16,14 @@ namespace Doodle
 
 class RenderPass;
 class RenderPassSpecification;
+
+enum class UpscaleMode
+{
+    None = 0,
+    Temporal,
+    Spatial
+};
+
 class DOO_API RenderPipeline : public Singleton<RenderPipeline>
 {
 public:
@@ -24,6 +33,10 @@ public:
 
     std::unordered_map<std::string, std::shared_ptr<RenderPass>> GetRenderPasses();
     std::unordered_map<std::string, std::shared_ptr<FrameBuffer>> GetFrameBuffers();
+    const std::vector<std::string> &GetRenderPassOrder() const
+    {
+        return m_renderPassOrder;
+    }
 
     void AddRenderPass(const std::string &name, std::shared_ptr<RenderPass> renderPass);
 
@@ -41,6 +54,36 @@ public:
 
     void SetTargetFrameBuffer(std::shared_ptr<FrameBuffer> targetFrameBuffer);
 
+    bool IsGPUDriven() const
+    {
+        return m_gpuDriven;
+    }
+
+    void SetGPUDriven(bool gpuDriven)
+    {
+        m_gpuDriven = gpuDriven;
+    }
+
+    float GetRenderScale() const
+    {
+        return m_renderScale;
+    }
+
+    void SetRenderScale(float renderScale)
+    {
+        m_renderScale = std::clamp(renderScale, MIN_RENDER_SCALE, 1.0f);
+    }
+
+    UpscaleMode GetUpscaleMode() const
+    {
+        return m_upscaleMode;
+    }
+
+    void SetUpscaleMode(UpscaleMode upscaleMode)
+    {
+        m_upscaleMode = upscaleMode;
+    }
+
     void SetUniformBuffer(const std::string &name, std::shared_ptr<UniformBuffer> uniformBuffer);
     void SetFrameBuffer(const std::string &name, std::shared_ptr<FrameBuffer> frameBuffer);
     void SetUniform1f(const std::string &name, float value);
@@ -69,10 +112,23 @@ public:
     glm::mat4 GetUniformMatrix4f(const std::string &name);
     std::shared_ptr<Texture> GetUniformTexture(const std::string &name);
 
+    static constexpr float MIN_RENDER_SCALE = 0.25f;
+
 private:
+    // 场景 Pass 在 SceneColor 中以 m_renderScale 渲染，时间上采样时对投影施加子像素抖动
+    void UpdateRenderResolution();
+    glm::vec2 NextJitter();
+
     Scene *m_scene;
+    bool m_gpuDriven = false;
+    float m_renderScale = 1.0f;
+    UpscaleMode m_upscaleMode = UpscaleMode::None;
+    uint32_t m_jitterIndex = 0;
+    bool m_previousViewProjectionValid = false;
+    glm::mat4 m_previousViewProjection{1.0f};
     std::shared_ptr<FrameBuffer> m_targetFrameBuffer;
     std::unordered_map<std::string, std::shared_ptr<RenderPass>> m_renderPasses;
+    std::vector<std::string> m_renderPassOrder;
     std::unordered_map<std::string, std::shared_ptr<UniformBuffer>> m_uniformBuffers;
     std::unordered_map<std::string, std::shared_ptr<FrameBuffer>> m_frameBuffers;
     std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
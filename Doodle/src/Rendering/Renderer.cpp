@@ -8,6 +8,8 @@
 #include "Renderer.h"
 #include "Shader.h"
 #include "ShaderLibrary.h"
+#include "StorageBuffer.h"
+#include "Texture.h"
 
 namespace Doodle
 {
@@ -28,6 +30,7 @@ void Renderer::Deinitialize()
 
 void Renderer::BeginFrame()
 {
+    Texture2D::UploadAsyncTextures();
 }
 
 void Renderer::EndFrame()
@@ -50,6 +53,39 @@ void Renderer::DrawIndexed(unsigned int count)
     Renderer::Submit([count]() { RendererAPI::DrawIndexed(count); });
 }
 
+void Renderer::DrawIndexed(unsigned int count, unsigned int firstIndex, int baseVertex)
+{
+    Renderer::Submit(
+        [count, firstIndex, baseVertex]() { RendererAPI::DrawIndexed(count, firstIndex, baseVertex); });
+}
+
+void Renderer::DrawIndexedInstanced(unsigned int count, unsigned int instanceCount, unsigned int firstIndex,
+                                    int baseVertex, unsigned int baseInstance)
+{
+    Renderer::Submit([count, instanceCount, firstIndex, baseVertex, baseInstance]() {
+        RendererAPI::DrawIndexedInstanced(count, instanceCount, firstIndex, baseVertex, baseInstance);
+    });
+}
+
+void Renderer::DrawIndexedIndirectCount(std::shared_ptr<StorageBuffer> commandBuffer,
+                                        std::shared_ptr<StorageBuffer> countBuffer, uint32_t maxDrawCount)
+{
+    Renderer::Submit([commandBuffer, countBuffer, maxDrawCount]() {
+        RendererAPI::DrawIndexedIndirectCount(commandBuffer->GetRendererID(), countBuffer->GetRendererID(),
+                                              maxDrawCount);
+    });
+}
+
+void Renderer::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    Renderer::Submit([groupsX, groupsY, groupsZ]() { RendererAPI::DispatchCompute(groupsX, groupsY, groupsZ); });
+}
+
+void Renderer::Barrier(BarrierFlags flags)
+{
+    Renderer::Submit([flags]() { RendererAPI::Barrier(flags); });
+}
+
 void Renderer::Draw(unsigned int count, PrimitiveType type)
 {
     Renderer::Submit([count, type]() { RendererAPI::Draw(count, type); });
@@ -14,6 +14,7 @@ namespace Doodle
 class Shader;
 class Texture;
 class FrameBuffer;
+class StorageBuffer;
 class DOO_API Renderer : public Singleton<Renderer>
 {
 public:
@@ -37,8 +38,16 @@ public:
     static void Clear(BufferFlags bufferFlags = BufferFlags::All);
     static void SetClearColor(float r, float g, float b, float a = 1.0f);
     static void DrawIndexed(unsigned int count);
+    static void DrawIndexed(unsigned int count, unsigned int firstIndex, int baseVertex);
+    static void DrawIndexedInstanced(unsigned int count, unsigned int instanceCount, unsigned int firstIndex,
+                                     int baseVertex, unsigned int baseInstance);
+    static void DrawIndexedIndirectCount(std::shared_ptr<StorageBuffer> commandBuffer,
+                                         std::shared_ptr<StorageBuffer> countBuffer, uint32_t maxDrawCount);
     static void Draw(unsigned int count, PrimitiveType type);
 
+    static void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1);
+    static void Barrier(BarrierFlags flags);
+
     static void RenderFullscreenQuad(std::shared_ptr<Texture> texture, std::shared_ptr<Shader> shader = nullptr);
     static void RenderFullscreenQuad(uint32_t textureID, std::shared_ptr<Shader> shader = nullptr);
     static void RenderFullscreenQuad(std::shared_ptr<FrameBuffer> framebuffer,
@@ -82,6 +82,52 @@ void RendererAPI::DrawIndexed(unsigned int count)
     glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
 }
 
+void RendererAPI::DrawIndexed(unsigned int count, unsigned int firstIndex, int baseVertex)
+{
+    glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT,
+                             reinterpret_cast<void *>(static_cast<uintptr_t>(firstIndex) * sizeof(uint32_t)),
+                             baseVertex);
+}
+
+void RendererAPI::DrawIndexedInstanced(unsigned int count, unsigned int instanceCount, unsigned int firstIndex,
+                                       int baseVertex, unsigned int baseInstance)
+{
+    glDrawElementsInstancedBaseVertexBaseInstance(
+        GL_TRIANGLES, count, GL_UNSIGNED_INT,
+        reinterpret_cast<void *>(static_cast<uintptr_t>(firstIndex) * sizeof(uint32_t)), instanceCount, baseVertex,
+        baseInstance);
+}
+
+void RendererAPI::DrawIndexedIndirectCount(uint32_t commandBuffer, uint32_t countBuffer, uint32_t maxDrawCount)
+{
+    // DrawElementsIndirectCommand 紧密排列，stride 传 0
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBindBuffer(GL_PARAMETER_BUFFER_ARB, countBuffer);
+    glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, 0, maxDrawCount, 0);
+    glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void RendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void RendererAPI::Barrier(BarrierFlags flags)
+{
+    GLbitfield barriers = 0;
+    if ((flags & BarrierFlags::ShaderStorage) != BarrierFlags::None)
+        barriers |= GL_SHADER_STORAGE_BARRIER_BIT;
+    if ((flags & BarrierFlags::Command) != BarrierFlags::None)
+        barriers |= GL_COMMAND_BARRIER_BIT;
+    if ((flags & BarrierFlags::ShaderImageAccess) != BarrierFlags::None)
+        barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    if ((flags & BarrierFlags::TextureFetch) != BarrierFlags::None)
+        barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+    if (barriers)
+        glMemoryBarrier(barriers);
+}
+
 void RendererAPI::Draw(unsigned int count, PrimitiveType type)
 {
     GLenum glType;
@@ -53,6 +53,26 @@ inline std::ostream &operator<<(std::ostream &os, BufferFlags type)
     return os;
 }
 
+enum class BarrierFlags
+{
+    None = 0,
+    ShaderStorage = 1 << 0,
+    Command = 1 << 1,
+    ShaderImageAccess = 1 << 2,
+    TextureFetch = 1 << 3,
+    All = ShaderStorage | Command | ShaderImageAccess | TextureFetch
+};
+
+inline BarrierFlags operator|(BarrierFlags lhs, BarrierFlags rhs)
+{
+    return static_cast<BarrierFlags>(static_cast<int>(lhs) | static_cast<int>(rhs));
+}
+
+inline BarrierFlags operator&(BarrierFlags lhs, BarrierFlags rhs)
+{
+    return static_cast<BarrierFlags>(static_cast<int>(lhs) & static_cast<int>(rhs));
+}
+
 enum class DepthTestType
 {
     Never,
@@ -141,8 +161,15 @@ public:
     static void SetClearColor(float r, float g, float b, float a);
 
     static void DrawIndexed(unsigned int count);
+    static void DrawIndexed(unsigned int count, unsigned int firstIndex, int baseVertex);
+    static void DrawIndexedInstanced(unsigned int count, unsigned int instanceCount, unsigned int firstIndex,
+                                     int baseVertex, unsigned int baseInstance);
+    static void DrawIndexedIndirectCount(uint32_t commandBuffer, uint32_t countBuffer, uint32_t maxDrawCount);
     static void Draw(unsigned int count, PrimitiveType type);
 
+    static void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ);
+    static void Barrier(BarrierFlags flags);
+
     static void SetDepthWrite(bool write);
     static void SetDepthTest(DepthTestType type);
     static void SetCullFace(CullFaceType type);
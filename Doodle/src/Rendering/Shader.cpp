@@ -401,6 +401,11 @@ private:
         SetUniform(name, glUniform1i, v);
     }
 
+    void SetUniform1ui(const std::string &name, uint32_t v) override
+    {
+        SetUniform(name, glUniform1ui, v);
+    }
+
     void SetUniform2i(const std::string &name, int v1, int v2) override
     {
         SetUniform(name, glUniform2i, v1, v2);
@@ -502,7 +507,11 @@ private:
 
     void SetUniformTexture(const std::string &name, std::shared_ptr<Texture> texture) override
     {
-        SetUniform(name, glUniformHandleui64ARB, texture->GetTextureHandle());
+        // 句柄在命令执行时读取：异步纹理的上传与流式纹理的重建都在同一队列中更换句柄并删除旧纹理
+        std::function<void(GLint)> func = [texture](GLint location) {
+            glUniformHandleui64ARB(location, texture->GetTextureHandle());
+        };
+        SetUniform(name, func);
     }
 
     void SetUniformTexture(const std::string &name, uint64_t textureHandle) override
@@ -64,6 +64,7 @@ public:
     }
 
     virtual void SetUniform1i(const std::string &name, int v) = 0;
+    virtual void SetUniform1ui(const std::string &name, uint32_t v) = 0;
     virtual void SetUniform2i(const std::string &name, int v1, int v2) = 0;
     virtual void SetUniform3i(const std::string &name, int v1, int v2, int v3) = 0;
     virtual void SetUniform4i(const std::string &name, int v1, int v2, int v3, int v4) = 0;
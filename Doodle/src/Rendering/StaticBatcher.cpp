@@ -0,0 +1,110 @@
+#include "pch.h"
+
+#include "Component.h"
+#include "RenderList.h"
+#include "Scene.h"
+#include "StaticBatcher.h"
+
+namespace Doodle
+{
+
+void StaticBatcher::Update(Scene *scene)
+{
+    if (scene == m_scene && scene->GetStaticVersion() == m_staticVersion)
+        return;
+    m_scene = scene;
+    m_staticVersion = scene->GetStaticVersion();
+    Rebuild(scene);
+}
+
+void StaticBatcher::Rebuild(Scene *scene)
+{
+    m_batches.clear();
+    m_batchedEntities.clear();
+
+    struct BatchSource
+    {
+        std::shared_ptr<MaterialInstance> MaterialInstance;
+        std::vector<const RenderItem *> Items;
+    };
+
+    std::unordered_map<size_t, std::vector<uint32_t>> sourceIndices;
+    std::vector<BatchSource> sources;
+
+    auto materialView = scene->View<MaterialComponent>();
+    for (const auto &item : RenderList::Get()->GetMeshItems())
+    {
+        if (!item.IsStatic())
+            continue;
+
+        auto &candidates = sourceIndices[item.MaterialInstance->GetStateHash()];
+        uint32_t sourceIndex = UINT32_MAX;
+        for (uint32_t candidate : candidates)
+        {
+            if (sources[candidate].MaterialInstance->HasSameState(*item.MaterialInstance))
+            {
+                sourceIndex = candidate;
+                break;
+            }
+        }
+        if (sourceIndex == UINT32_MAX)
+        {
+            sourceIndex = static_cast<uint32_t>(sources.size());
+            candidates.push_back(sourceIndex);
+            // 合批跨帧存在，需要持有材质实例
+            sources.push_back({materialView.get<MaterialComponent>(item.Entity).MaterialInstance});
+        }
+        sources[sourceIndex].Items.push_back(&item);
+    }
+
+    for (auto &source : sources)
+    {
+        // 单个实体合并没有收益，仍走实例化路径
+        if (source.Items.size() < 2)
+            continue;
+
+        StaticBatch batch;
+        batch.MaterialInstance = source.MaterialInstance;
+
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        for (const RenderItem *item : source.Items)
+        {
+            const Mesh *mesh = item->Mesh;
+            const glm::mat4 &model = item->Model;
+            const glm::mat3 linearModel(model);
+            const glm::mat3 &normalModel = item->NormalMatrix;
+
+            StaticSubmesh &submesh = batch.Submeshes.emplace_back();
+            submesh.FirstIndex = static_cast<uint32_t>(indices.size());
+            submesh.IndexCount = static_cast<uint32_t>(mesh->GetIndices().size());
+
+            uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
+            for (const PackedVertex &packed : mesh->GetVertices())
+            {
+                Vertex vertex = packed.Unpack();
+                vertex.Position = glm::vec3(model * glm::vec4(vertex.Position, 1.0f));
+                // 只有法线用逆转置矩阵，切线沿表面方向，直接用模型矩阵变换；非均匀缩放后重新正交化
+                vertex.Normal = glm::normalize(normalModel * vertex.Normal);
+                glm::vec3 tangent = linearModel * vertex.Tangent;
+                vertex.Tangent = glm::normalize(tangent - vertex.Normal * glm::dot(vertex.Normal, tangent));
+                glm::vec3 binormal = glm::cross(vertex.Normal, vertex.Tangent);
+                vertex.Binormal = glm::dot(binormal, linearModel * vertex.Binormal) < 0.0f ? -binormal : binormal;
+                submesh.Bounds.Expand(vertex.Position);
+                vertices.push_back(vertex);
+            }
+            for (uint32_t index : mesh->GetIndices())
+            {
+                indices.push_back(baseVertex + index);
+            }
+            m_batchedEntities.insert(item->Entity);
+        }
+
+        batch.Mesh = std::make_shared<Mesh>(std::move(vertices), std::move(indices));
+        m_batches.push_back(std::move(batch));
+    }
+
+    DOO_CORE_INFO("Static batching: {0} entities merged into {1} batches", m_batchedEntities.size(), m_batches.size());
+}
+
+} // namespace Doodle
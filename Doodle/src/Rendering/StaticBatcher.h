@@ -0,0 +1,58 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <unordered_set>
+#include <vector>
+
+#include "MaterialInstance.h"
+#include "MathUtils.h"
+#include "Mesh.h"
+#include "Singleton.h"
+
+namespace Doodle
+{
+
+// 合并网格中的一段子网格，索引相对于合并网格的 MeshRange
+struct StaticSubmesh
+{
+    uint32_t FirstIndex = 0;
+    uint32_t IndexCount = 0;
+    BoundingBox Bounds; // 世界空间
+};
+
+struct StaticBatch
+{
+    std::shared_ptr<Mesh> Mesh; // 顶点已变换到世界空间
+    std::shared_ptr<MaterialInstance> MaterialInstance;
+    std::vector<StaticSubmesh> Submeshes;
+};
+
+class Scene;
+// 将标记为 Static 且材质状态相同的网格实体合并为一个预变换的网格，依赖当帧的 RenderList
+class DOO_API StaticBatcher : public Singleton<StaticBatcher>
+{
+public:
+    void Update(Scene *scene);
+
+    bool IsBatched(entt::entity entity) const
+    {
+        return m_batchedEntities.contains(entity);
+    }
+
+    const std::vector<StaticBatch> &GetBatches() const
+    {
+        return m_batches;
+    }
+
+private:
+    Scene *m_scene = nullptr;
+    uint32_t m_staticVersion = UINT32_MAX;
+    std::vector<StaticBatch> m_batches;
+    std::unordered_set<entt::entity> m_batchedEntities;
+
+    void Rebuild(Scene *scene);
+};
+
+} // namespace Doodle
@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <glad/glad.h>
+#include <vector>
+
+#include "GPUMemoryTracker.h"
+#include "Log.h"
+#include "Renderer.h"
+#include "StorageBuffer.h"
+
+namespace Doodle
+{
+
+class OpenGLStorageBuffer : public StorageBuffer
+{
+public:
+    OpenGLStorageBuffer(size_t size, bool dynamic)
+    {
+        m_size = size;
+        m_dynamic = dynamic;
+        Renderer::Submit([this]() {
+            glCreateBuffers(1, &m_rendererId);
+            glNamedBufferData(m_rendererId, m_size, nullptr, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            DOO_CORE_DEBUG("SSBO <{0}> created: size={1}, dynamic={2}", m_rendererId, m_size, m_dynamic);
+        });
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::StorageBuffer, "StorageBuffer", m_size);
+    }
+
+    ~OpenGLStorageBuffer()
+    {
+        GPUMemoryTracker::Get()->Untrack(this);
+        Renderer::Submit([this]() { glDeleteBuffers(1, &m_rendererId); });
+    }
+
+    void SetSubData(const void *data, size_t size, size_t offset) override
+    {
+        if (size == 0)
+            return;
+        if (offset + size > m_size)
+        {
+            DOO_CORE_ERROR("SSBO <{0}> size exceeded", m_rendererId);
+            return;
+        }
+
+        const auto *bytes = static_cast<const std::byte *>(data);
+        std::vector<std::byte> copy(bytes, bytes + size);
+        Renderer::Submit([this, copy, offset]() {
+            glNamedBufferSubData(m_rendererId, offset, copy.size(), copy.data());
+        });
+    }
+
+    void Reserve(size_t size) override
+    {
+        if (size <= m_size)
+            return;
+
+        m_size = size;
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::StorageBuffer, "StorageBuffer", m_size);
+        Renderer::Submit([this, size]() {
+            glNamedBufferData(m_rendererId, size, nullptr, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            DOO_CORE_DEBUG("SSBO <{0}> resized: size={1}", m_rendererId, size);
+        });
+    }
+
+    void Clear() override
+    {
+        Renderer::Submit([this]() {
+            uint32_t zero = 0;
+            glClearNamedBufferData(m_rendererId, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        });
+    }
+
+    void Bind(uint32_t slot) override
+    {
+        m_binding = slot;
+        Renderer::Submit([this, slot]() { glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, m_rendererId); });
+    }
+
+    void Unbind() const override
+    {
+        Renderer::Submit([this]() { glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_binding, 0); });
+    }
+
+    uint32_t GetRendererID() const override
+    {
+        return m_rendererId;
+    }
+
+    uint32_t GetBinding() const override
+    {
+        return m_binding;
+    }
+
+    size_t GetSize() const override
+    {
+        return m_size;
+    }
+
+    bool IsDynamic() const override
+    {
+        return m_dynamic;
+    }
+
+private:
+    uint32_t m_rendererId = 0;
+    size_t m_size = 0;
+    uint32_t m_binding = 0;
+    bool m_dynamic = false;
+};
+
+std::shared_ptr<StorageBuffer> StorageBuffer::Create(size_t size, bool dynamic)
+{
+    return std::make_shared<OpenGLStorageBuffer>(size, dynamic);
+}
+
+} // namespace Doodle
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Log.h"
+#include "pch.h"
+#include <cstdint>
+
+#include "Renderer.h"
+
+namespace Doodle
+{
+
+class DOO_API StorageBuffer
+{
+public:
+    static std::shared_ptr<StorageBuffer> Create(size_t size, bool dynamic = false);
+
+    virtual ~StorageBuffer() = default;
+
+    // 数据会被拷贝进渲染命令，调用方无需保证 data 在渲染前有效
+    virtual void SetSubData(const void *data, size_t size, size_t offset) = 0;
+    void SetSubData(const void *data, size_t size)
+    {
+        SetSubData(data, size, 0);
+    }
+    // 容量不足时会重新分配，原有内容不保留
+    virtual void Reserve(size_t size) = 0;
+    virtual void Clear() = 0;
+    virtual void Bind(uint32_t slot) = 0;
+    virtual void Unbind() const = 0;
+    virtual uint32_t GetRendererID() const = 0;
+    virtual uint32_t GetBinding() const = 0;
+    virtual size_t GetSize() const = 0;
+    virtual bool IsDynamic() const = 0;
+};
+
+using SSBO = StorageBuffer;
+
+} // namespace Doodle
@@ -1,15 +1,20 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <stb_image.h>
 #include <vector>
 
 #include "Buffer.h"
+#include "GPUMemoryTracker.h"
+#include "ImageKernels.h"
 #include "Log.h"
 #include "Renderer.h"
 #include "Texture.h"
+#include "TextureCooker.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 namespace Doodle
@@ -111,98 +116,186 @@ static int CalculateMipMapCount(int width, int height)
     return static_cast<int>(glm::floor(glm::log2(static_cast<float>(glm::min(width, height))))) + 1;
 }
 
-class OpenGLTexture2D : public Texture2D
+static bool IsHalfFloatFormat(TextureFormat format)
 {
-public:
-    OpenGLTexture2D(const std::string &filepath, const TextureParams &params)
-        : m_filepath(filepath), m_data(nullptr), m_params(params)
+    return format == TextureFormat::RGB16F || format == TextureFormat::RGBA16F;
+}
+
+static GLenum GetCompressedInternalFormat(TextureCompression compression, bool srgb)
+{
+    switch (compression)
     {
-        stbi_set_flip_vertically_on_load(true);
-        m_hdr = stbi_is_hdr(m_filepath.c_str());
+    case TextureCompression::BC4:
+        return GL_COMPRESSED_RED_RGTC1;
+    case TextureCompression::BC5:
+        return GL_COMPRESSED_RG_RGTC2;
+    case TextureCompression::BC6H:
+        return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case TextureCompression::BC7:
+        return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default:
+        DOO_CORE_ERROR("Unsupported texture compression: {0}", TextureCompressionToString(compression));
+        return GL_NONE;
+    }
+}
 
-        int width, height, channels, desiredChannels = 0;
-        switch (m_params.Format)
-        {
-        case TextureFormat::RGB8:
-        case TextureFormat::RGB16F:
-        case TextureFormat::RGB32F:
-        case TextureFormat::SRGB8:
-            desiredChannels = STBI_rgb;
-            break;
-        case TextureFormat::RGBA8:
-        case TextureFormat::RGBA16F:
-        case TextureFormat::RGBA32F:
-        case TextureFormat::SRGB8ALPHA8:
-            desiredChannels = STBI_rgb_alpha;
-            break;
-        case TextureFormat::DEPTH32F:
-        case TextureFormat::DEPTH24STENCIL8:
-            desiredChannels = STBI_grey;
-            break;
-        default:
-            DOO_CORE_WARN("Texture format not specified");
-            break;
-        }
-        if (m_hdr)
-        {
-            m_data = reinterpret_cast<std::byte *>(
-                stbi_loadf(m_filepath.c_str(), &width, &height, &channels, desiredChannels));
-        }
-        else
-        {
-            m_data = reinterpret_cast<std::byte *>(
-                stbi_load(m_filepath.c_str(), &width, &height, &channels, desiredChannels));
-        }
+static uint64_t GetMipChainMemorySize(TextureFormat format, uint32_t width, uint32_t height, uint32_t levels)
+{
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < levels; level++)
+        size += GetMemorySize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+    return size;
+}
 
-        if (m_params.InvertColor)
-        {
-            auto size = GetMemorySize(m_params.Format, width, height);
-            if (size == width * height * channels)
-            {
-                unsigned char *revertData = static_cast<unsigned char *>(malloc(width * height * channels));
-                if (revertData == nullptr)
-                {
-                    DOO_CORE_ERROR("Error allocating memory\n");
-                    stbi_image_free(m_data);
-                    return;
-                }
+struct DecodedImage
+{
+    std::byte *Data = nullptr;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint64_t Size = 0;
+    bool Hdr = false;
+    bool HalfFloat = false; // 浮点数据已转换为半精度
+    // 块压缩纹理的数据直接指向映射的 DDS 文件，包含全部 mip
+    CookedImage Cooked;
+};
 
-                // 反色处理
-                for (int y = 0; y < height; y++)
-                {
-                    for (int x = 0; x < width; x++)
-                    {
-                        int invertChannels = std::min(channels, 3);
-                        for (int c = 0; c < channels; c++)
-                        {
-                            if (c < invertChannels)
-                            {
-                                revertData[(y * width + x) * channels + c] =
-                                    255 - static_cast<unsigned char>(m_data[(y * width + x) * channels + c]);
-                            }
-                            else
-                            {
-                                revertData[(y * width + x) * channels + c] =
-                                    static_cast<unsigned char>(m_data[(y * width + x) * channels + c]);
-                            }
-                        }
-                    }
-                }
-                stbi_image_free(m_data);
-                m_data = reinterpret_cast<std::byte *>(revertData);
-            }
-        }
+static void FreeImage(DecodedImage &image)
+{
+    if (image.Cooked.File)
+        image.Cooked = {};
+    else
+        stbi_image_free(image.Data);
+    image.Data = nullptr;
+}
 
-        if (!m_data)
-        {
-            DOO_CORE_ERROR("Failed to load texture: {0}", m_filepath);
-            return;
-        }
+static DecodedImage GetCookedImage(const CookedImage &cooked)
+{
+    DecodedImage image;
+    image.Data = const_cast<std::byte *>(cooked.Data);
+    image.Width = cooked.Width;
+    image.Height = cooked.Height;
+    image.Hdr = cooked.Compression == TextureCompression::BC6H;
+    image.Cooked = cooked;
+    for (uint32_t level = 0; level < cooked.MipCount; level++)
+        image.Size += TextureCooker::GetLevelSize(cooked.Compression, cooked.Width, cooked.Height, level);
+    return image;
+}
 
-        m_params.Width = width;
-        m_params.Height = height;
-        LoadTexture();
-        Renderer::Submit([this]() { stbi_image_free(m_data); }); // Free the image data
+// 解码图像文件，不调用 GL，可以在工作线程上执行；数据用 FreeImage 释放。
+// 要求块压缩时优先读取烘焙好的 DDS，没有则按原图解码并在后台烘焙，下次加载生效
+static DecodedImage DecodeImage(const std::string &filepath, const TextureParams &params)
+{
+    DecodedImage image;
+    CookedImage cooked;
+    if (std::filesystem::path(filepath).extension() == ".dds")
+    {
+        if (TextureCooker::Load(filepath, cooked))
+            return GetCookedImage(cooked);
+        DOO_CORE_ERROR("Failed to load texture: {0}", filepath);
+        return {};
+    }
+    std::filesystem::path cookedPath;
+    if (params.Compression != TextureCompression::None)
+    {
+        cookedPath = TextureCooker::GetCookedPath(filepath, params);
+        if (TextureCooker::Load(cookedPath, cooked))
+            return GetCookedImage(cooked);
+    }
+
+    stbi_set_flip_vertically_on_load_thread(true);
+    image.Hdr = stbi_is_hdr(filepath.c_str());
+
+    int width, height, channels, desiredChannels = 0;
+    switch (params.Format)
+    {
+    case TextureFormat::RGB8:
+    case TextureFormat::RGB16F:
+    case TextureFormat::RGB32F:
+    case TextureFormat::SRGB8:
+        desiredChannels = STBI_rgb;
+        break;
+    case TextureFormat::RGBA8:
+    case TextureFormat::RGBA16F:
+    case TextureFormat::RGBA32F:
+    case TextureFormat::SRGB8ALPHA8:
+        desiredChannels = STBI_rgb_alpha;
+        break;
+    case TextureFormat::DEPTH32F:
+    case TextureFormat::DEPTH24STENCIL8:
+        desiredChannels = STBI_grey;
+        break;
+    default:
+        DOO_CORE_WARN("Texture format not specified");
+        break;
+    }
+    std::byte *data = nullptr;
+    if (image.Hdr)
+    {
+        data = reinterpret_cast<std::byte *>(stbi_loadf(filepath.c_str(), &width, &height, &channels, desiredChannels));
+    }
+    else
+    {
+        data = reinterpret_cast<std::byte *>(stbi_load(filepath.c_str(), &width, &height, &channels, desiredChannels));
+    }
+
+    int dataChannels = desiredChannels ? desiredChannels : channels;
+    if (data && params.InvertColor && !image.Hdr)
+    {
+        // 反色处理，透明度不变
+        ImageKernels::InvertChannels(reinterpret_cast<uint8_t *>(data), static_cast<size_t>(width) * height,
+                                     dataChannels, std::min(dataChannels, 3));
+    }
+    if (data && params.SourceChannel != 0 && !image.Hdr && params.SourceChannel < static_cast<uint32_t>(dataChannels))
+    {
+        // 打包的遮罩纹理：把指定通道复制到 RGB，着色器与 BC4 烘焙都只读取 R 通道
+        int32_t channel = static_cast<int32_t>(params.SourceChannel);
+        const int32_t channelMap[] = {channel, channel, channel, 3};
+        ImageKernels::SwizzleChannels(reinterpret_cast<const uint8_t *>(data), dataChannels,
+                                      reinterpret_cast<uint8_t *>(data), dataChannels, channelMap,
+                                      static_cast<size_t>(width) * height);
+    }
+
+    if (!data)
+    {
+        DOO_CORE_ERROR("Failed to load texture: {0}", filepath);
+        return {};
+    }
+
+    image.Data = data;
+    image.Width = width;
+    image.Height = height;
+    image.Size = GetMemorySize(params.Format, width, height);
+    if (!cookedPath.empty())
+        TextureCooker::CookAsync(data, width, height, dataChannels, image.Hdr, params, cookedPath);
+
+    // 半精度格式在 CPU 上原地转换，上传量减半，也省去驱动的转换
+    if (image.Hdr && IsHalfFloatFormat(params.Format))
+    {
+        ImageKernels::ConvertFloatToHalf(reinterpret_cast<const float *>(data), reinterpret_cast<uint16_t *>(data),
+                                         static_cast<size_t>(width) * height * dataChannels);
+        image.HalfFloat = true;
+    }
+    return image;
+}
+
+// 只在主线程上修改与读取
+static uint32_t s_TextureHandleGeneration = 0;
+
+class OpenGLTexture2D : public Texture2D
+{
+public:
+    OpenGLTexture2D(const std::string &filepath, const TextureParams &params)
+        : m_filepath(filepath), m_data(nullptr), m_params(params)
+    {
+        DecodedImage image = DecodeImage(m_filepath, m_params);
+        if (image.Data)
+            SetImage(image);
+    }
+
+    // 异步加载：解码完成之前使用占位纹理的句柄
+    OpenGLTexture2D(const std::string &filepath, const TextureParams &params, std::shared_ptr<Texture2D> placeholder)
+        : m_filepath(filepath), m_params(params), m_placeholder(placeholder)
+    {
     }
 
     OpenGLTexture2D(Buffer buffer, const TextureParams &params) : m_params(params)
@@ -221,16 +314,53 @@ public:
         LoadTexture();
     }
 
+    OpenGLTexture2D(const TextureParams &params) : m_params(params)
+    {
+        LoadTexture();
+    }
+
     ~OpenGLTexture2D()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
+        if (!m_rendererId)
+            return;
         glMakeTextureHandleNonResidentARB(m_textureHandle);
         glDeleteTextures(1, &m_rendererId);
     }
 
+    // 接管解码后的数据，创建纹理并上传，上传后释放数据
+    void SetImage(const DecodedImage &image)
+    {
+        m_hdr = image.Hdr;
+        m_halfFloat = image.HalfFloat;
+        m_data = image.Data;
+        m_params.Width = image.Width;
+        m_params.Height = image.Height;
+        if (image.Cooked.File)
+        {
+            m_cooked = image.Cooked;
+            m_compressedFormat = GetCompressedInternalFormat(m_cooked.Compression, m_cooked.Srgb);
+            // 流式纹理保留文件映射，之后从中读取更精细的 mip，首次只上传最粗的几级
+            if (m_params.Streamable)
+                m_residentLevel = GetMaxResidentMipLevel();
+        }
+        LoadTexture();
+        m_handleVersion++;
+        Renderer::Submit([this, image]() mutable {
+            FreeImage(image); // Free the image data
+            m_data = nullptr;
+            if (!m_params.Streamable)
+            {
+                m_cooked.File = nullptr;
+                m_cooked.Data = nullptr;
+            }
+        });
+    }
+
     void Bind(uint32_t slot) override
     {
         m_binding = slot;
-        Renderer::Submit([this]() { glBindTextureUnit(m_binding, m_rendererId); });
+        Renderer::Submit([this]() { glBindTextureUnit(m_binding, GetRendererID()); });
     }
 
     void Unbind() const override
@@ -238,6 +368,24 @@ public:
         Renderer::Submit([this]() { glBindTextureUnit(m_binding, 0); });
     }
 
+    void BindImage(uint32_t slot, uint32_t level) override
+    {
+        Renderer::Submit([this, slot, level]() {
+            glBindImageTexture(slot, m_rendererId, level, GL_FALSE, 0, GL_READ_WRITE,
+                               GetInternalFormat(m_params.Format));
+        });
+    }
+
+    void SetData(const void *data) override
+    {
+        Renderer::Submit([this, data]() {
+            GLenum internalFormat = GetInternalFormat(m_params.Format);
+            auto [format, type] = GetFormatAndType(internalFormat);
+            glTextureSubImage2D(m_rendererId, 0, 0, 0, m_params.Width, m_params.Height, format, type, data);
+            glGenerateTextureMipmap(m_rendererId);
+        });
+    }
+
     std::string GetPath() const
     {
         return m_filepath;
@@ -253,102 +401,270 @@ public:
     }
     uint32_t GetRendererID() const override
     {
-        return m_rendererId;
+        return m_rendererId || !m_placeholder ? m_rendererId : m_placeholder->GetRendererID();
     }
     uint64_t GetTextureHandle() const override
     {
-        return m_textureHandle;
+        return m_textureHandle || !m_placeholder ? m_textureHandle : m_placeholder->GetTextureHandle();
+    }
+    uint32_t GetHandleVersion() const override
+    {
+        return m_handleVersion;
     }
     uint32_t GetTarget() const override
     {
         return GL_TEXTURE_2D;
     }
+    bool IsLoaded() const override
+    {
+        return m_textureHandle != 0;
+    }
+    uint64_t GetGPUMemorySize() const override
+    {
+        if (!m_rendererId)
+            return 0;
+        if (m_compressedFormat)
+            return GetResidentMemorySize(m_residentLevel);
+        return GetMipChainMemorySize(m_params.Format, m_params.Width, m_params.Height, GetMipLevelCount());
+    }
     TextureFormat GetFormat() const override
     {
         return m_params.Format;
     }
     uint32_t GetMipLevelCount() const override
     {
+        if (m_compressedFormat)
+            return m_cooked.MipCount;
         return CalculateMipMapCount(m_params.Width, m_params.Height);
     }
 
+    bool IsStreamable() const override
+    {
+        return m_params.Streamable && m_cooked.File != nullptr;
+    }
+    uint32_t GetResidentMipLevel() const override
+    {
+        return m_residentLevel;
+    }
+    uint32_t GetMaxResidentMipLevel() const override
+    {
+        uint32_t level = 0;
+        while (level + 1 < m_cooked.MipCount &&
+               std::max(m_params.Width >> level, m_params.Height >> level) > STREAMING_MIN_RESIDENT_SIZE)
+            level++;
+        return level;
+    }
+    uint64_t GetResidentMemorySize(uint32_t level) const override
+    {
+        if (!m_compressedFormat)
+            return GetGPUMemorySize();
+        uint64_t size = 0;
+        for (uint32_t mip = level; mip < m_cooked.MipCount; mip++)
+            size += TextureCooker::GetLevelSize(m_cooked.Compression, m_params.Width, m_params.Height, mip);
+        return size;
+    }
+
+    void SetResidentMipLevel(uint32_t level) override
+    {
+        level = std::min(level, GetMaxResidentMipLevel());
+        if (!IsStreamable() || level == m_residentLevel)
+            return;
+
+        // 句柄创建后纹理状态不可修改，因此新建一个只包含所需 mip 的纹理替换原纹理
+        uint32_t oldLevel = m_residentLevel;
+        Renderer::Submit([this, oldLevel, level]() {
+            uint32_t rendererId;
+            glCreateTextures(GL_TEXTURE_2D, 1, &rendererId);
+            CreateCompressedStorage(rendererId, level);
+
+            // 新旧纹理都有的 mip 直接在显存中复制，新增的 mip 从映射的文件上传
+            uint32_t copyLevel = std::max(oldLevel, level);
+            for (uint32_t mip = copyLevel; mip < m_cooked.MipCount; mip++)
+            {
+                GLsizei width = static_cast<GLsizei>(std::max(m_params.Width >> mip, 1u));
+                GLsizei height = static_cast<GLsizei>(std::max(m_params.Height >> mip, 1u));
+                glCopyImageSubData(m_rendererId, GL_TEXTURE_2D, mip - oldLevel, 0, 0, 0, rendererId, GL_TEXTURE_2D,
+                                   mip - level, 0, 0, 0, width, height, 1);
+            }
+            UploadCompressedLevels(rendererId, level, copyLevel);
+            ApplyParameters(rendererId);
+
+            uint64_t textureHandle = glGetTextureHandleARB(rendererId);
+            glMakeTextureHandleResidentARB(textureHandle);
+            glMakeTextureHandleNonResidentARB(m_textureHandle);
+            glDeleteTextures(1, &m_rendererId);
+            m_rendererId = rendererId;
+            m_textureHandle = textureHandle;
+            TrackMemory();
+        });
+        m_residentLevel = level;
+        m_handleVersion++;
+        s_TextureHandleGeneration++;
+    }
+
 private:
+    void TrackMemory()
+    {
+        std::string name = m_filepath;
+        if (name.empty())
+        {
+            name = fmt::format("Texture2D {}x{} {}", m_params.Width, m_params.Height,
+                               TextureFormatToString(m_params.Format));
+        }
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::Texture, std::move(name), GetGPUMemorySize());
+    }
+
+    // 纹理的第 0 级对应常驻的最精细 mip
+    void CreateCompressedStorage(uint32_t rendererId, uint32_t residentLevel)
+    {
+        GLsizei width = static_cast<GLsizei>(std::max(m_params.Width >> residentLevel, 1u));
+        GLsizei height = static_cast<GLsizei>(std::max(m_params.Height >> residentLevel, 1u));
+        glTextureStorage2D(rendererId, m_cooked.MipCount - residentLevel, m_compressedFormat, width, height);
+    }
+
+    // 上传 [residentLevel, endLevel) 范围内预先生成的压缩 mip
+    void UploadCompressedLevels(uint32_t rendererId, uint32_t residentLevel, uint32_t endLevel)
+    {
+        const std::byte *data = m_cooked.Data;
+        for (uint32_t level = 0; level < endLevel; level++)
+        {
+            uint64_t size = TextureCooker::GetLevelSize(m_cooked.Compression, m_params.Width, m_params.Height, level);
+            if (level >= residentLevel)
+            {
+                GLsizei width = static_cast<GLsizei>(std::max(m_params.Width >> level, 1u));
+                GLsizei height = static_cast<GLsizei>(std::max(m_params.Height >> level, 1u));
+                glCompressedTextureSubImage2D(rendererId, level - residentLevel, 0, 0, width, height,
+                                              m_compressedFormat, static_cast<GLsizei>(size), data);
+            }
+            data += size;
+        }
+    }
+
+    void ApplyParameters(uint32_t rendererId)
+    {
+        // Set texture parameters
+        switch (m_params.Wrap)
+        {
+        case TextureWrap::Repeat:
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            break;
+        case TextureWrap::MirroredRepeat:
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+            break;
+        case TextureWrap::Clamp:
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            break;
+        case TextureWrap::ClampToEdge:
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteri(rendererId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            break;
+        case TextureWrap::None:
+            DOO_CORE_WARN("Texture wrap mode not specified");
+            break;
+        }
+
+        switch (m_params.Filter)
+        {
+        case TextureFilter::Nearest:
+            glTextureParameteri(rendererId, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTextureParameteri(rendererId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case TextureFilter::Linear:
+            glTextureParameteri(rendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(rendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            break;
+        case TextureFilter::MipmapNearest:
+            glTextureParameteri(rendererId, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            glTextureParameteri(rendererId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case TextureFilter::MipmapLinear:
+            glTextureParameteri(rendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTextureParameteri(rendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            break;
+        case TextureFilter::None:
+            DOO_CORE_WARN("Texture filter mode not specified");
+            break;
+        }
+    }
+
     void LoadTexture()
     {
         auto width = m_params.Width;
         auto height = m_params.Height;
-        Renderer::Submit([this, width, height]() {
+        auto residentLevel = m_residentLevel;
+        Renderer::Submit([this, width, height, residentLevel]() {
             glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererId);
 
-            GLenum internalFormat = GetInternalFormat(m_params.Format);
-            GLenum format = std::get<0>(GetFormatAndType(internalFormat));
-            GLenum type = std::get<1>(GetFormatAndType(internalFormat));
-            uint32_t levels = GetMipLevelCount();
-            glTextureStorage2D(m_rendererId, levels, internalFormat, width, height);
-            if (m_data != nullptr)
-                glTextureSubImage2D(m_rendererId, 0, 0, 0, width, height, format, type, m_data);
-            glGenerateTextureMipmap(m_rendererId);
-
-            // Set texture parameters
-            switch (m_params.Wrap)
+            if (m_compressedFormat)
             {
-            case TextureWrap::Repeat:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_T, GL_REPEAT);
-                break;
-            case TextureWrap::MirroredRepeat:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-                break;
-            case TextureWrap::Clamp:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                break;
-            case TextureWrap::ClampToEdge:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                break;
-            case TextureWrap::None:
-                DOO_CORE_WARN("Texture wrap mode not specified");
-                break;
+                CreateCompressedStorage(m_rendererId, residentLevel);
+                UploadCompressedLevels(m_rendererId, residentLevel, m_cooked.MipCount);
             }
-
-            switch (m_params.Filter)
+            else
             {
-            case TextureFilter::Nearest:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                break;
-            case TextureFilter::Linear:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                break;
-            case TextureFilter::MipmapNearest:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                break;
-            case TextureFilter::MipmapLinear:
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glTextureParameteri(m_rendererId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                break;
-            case TextureFilter::None:
-                DOO_CORE_WARN("Texture filter mode not specified");
-                break;
+                GLenum internalFormat = GetInternalFormat(m_params.Format);
+                GLenum format = std::get<0>(GetFormatAndType(internalFormat));
+                GLenum type = m_halfFloat ? GL_HALF_FLOAT : std::get<1>(GetFormatAndType(internalFormat));
+                uint32_t levels = GetMipLevelCount();
+                glTextureStorage2D(m_rendererId, levels, internalFormat, width, height);
+                if (m_data != nullptr)
+                    glTextureSubImage2D(m_rendererId, 0, 0, 0, width, height, format, type, m_data);
+                glGenerateTextureMipmap(m_rendererId);
             }
 
+            ApplyParameters(m_rendererId);
+
             m_textureHandle = glGetTextureHandleARB(m_rendererId);
             glMakeTextureHandleResidentARB(m_textureHandle);
+            TrackMemory();
         });
     }
     TextureParams m_params;
-    uint32_t m_rendererId;
-    uint64_t m_textureHandle;
+    uint32_t m_rendererId = 0;
+    uint64_t m_textureHandle = 0;
     std::string m_filepath;
     std::byte *m_data = nullptr;
-    bool m_hdr;
-    uint32_t m_binding;
+    bool m_hdr = false;
+    bool m_halfFloat = false;
+    uint32_t m_binding = 0;
+    std::shared_ptr<Texture2D> m_placeholder;
+    CookedImage m_cooked;
+    GLenum m_compressedFormat = 0;
+    uint32_t m_residentLevel = 0;
+    uint32_t m_handleVersion = 0;
 };
 
+struct AsyncTextureLoad
+{
+    std::weak_ptr<OpenGLTexture2D> Texture;
+    DecodedImage Image;
+};
+
+// 异步纹理的解码线程与待上传队列
+struct AsyncTextureLoader
+{
+    std::mutex Mutex;
+    std::deque<AsyncTextureLoad> Decoded;
+    std::unique_ptr<ThreadPool> Workers = std::make_unique<ThreadPool>();
+
+    ~AsyncTextureLoader()
+    {
+        // 先等待工作线程退出，再释放还没有上传的数据
+        Workers.reset();
+        for (auto &load : Decoded)
+            FreeImage(load.Image);
+    }
+};
+
+static AsyncTextureLoader &GetAsyncTextureLoader()
+{
+    static AsyncTextureLoader s_Loader;
+    return s_Loader;
+}
+
 std::shared_ptr<Texture2D> Texture2D::Create(const std::string &filepath, const TextureParams &params)
 {
     return std::make_shared<OpenGLTexture2D>(filepath, params);
@@ -359,6 +675,67 @@ std::shared_ptr<Texture2D> Texture2D::Create(Buffer buffer, const TextureParams
     return std::make_shared<OpenGLTexture2D>(buffer, params);
 }
 
+std::shared_ptr<Texture2D> Texture2D::CreateAsync(const std::string &filepath, const TextureParams &params,
+                                                  std::shared_ptr<Texture2D> placeholder)
+{
+    auto texture = std::make_shared<OpenGLTexture2D>(filepath, params, placeholder ? placeholder : GetWhiteTexture());
+    std::weak_ptr<OpenGLTexture2D> weakTexture = texture;
+    GetAsyncTextureLoader().Workers->Enqueue([weakTexture, filepath, params]() {
+        // 纹理在开始解码前已被释放则跳过
+        if (weakTexture.expired())
+            return;
+        DecodedImage image = DecodeImage(filepath, params);
+        if (!image.Data)
+            return;
+        auto &loader = GetAsyncTextureLoader();
+        std::lock_guard<std::mutex> lock(loader.Mutex);
+        loader.Decoded.push_back({weakTexture, image});
+    });
+    return texture;
+}
+
+void Texture2D::UploadAsyncTextures(uint64_t budgetBytes)
+{
+    auto &loader = GetAsyncTextureLoader();
+    std::vector<AsyncTextureLoad> uploads;
+    {
+        std::lock_guard<std::mutex> lock(loader.Mutex);
+        uint64_t bytes = 0;
+        // 至少上传一张，避免大纹理永远超出预算
+        while (!loader.Decoded.empty() &&
+               (uploads.empty() || bytes + loader.Decoded.front().Image.Size <= budgetBytes))
+        {
+            bytes += loader.Decoded.front().Image.Size;
+            uploads.push_back(loader.Decoded.front());
+            loader.Decoded.pop_front();
+        }
+    }
+
+    for (auto &load : uploads)
+    {
+        auto texture = load.Texture.lock();
+        if (!texture)
+        {
+            FreeImage(load.Image);
+            continue;
+        }
+        texture->SetImage(load.Image);
+        // 上传命令执行前保持纹理存活
+        Renderer::Submit([texture]() {});
+        s_TextureHandleGeneration++;
+    }
+}
+
+uint32_t Texture2D::GetTextureHandleGeneration()
+{
+    return s_TextureHandleGeneration;
+}
+
+std::shared_ptr<Texture2D> Texture2D::Create(const TextureParams &params)
+{
+    return std::make_shared<OpenGLTexture2D>(params);
+}
+
 std::shared_ptr<Texture2D> Texture2D::GetWhiteTexture()
 {
     static std::shared_ptr<Texture2D> s_WhiteTexture = nullptr;
@@ -467,7 +844,14 @@ public:
                 DOO_CORE_ERROR("Failed to load cube texture face: {0}", m_facePaths[i]);
                 return;
             }
+            if (m_hdr && IsHalfFloatFormat(m_params.Format))
+            {
+                size_t count = static_cast<size_t>(width) * height * (desiredChannels ? desiredChannels : channels);
+                ImageKernels::ConvertFloatToHalf(reinterpret_cast<const float *>(m_faceData[i]),
+                                                 reinterpret_cast<uint16_t *>(m_faceData[i]), count);
+            }
         }
+        m_halfFloat = m_hdr && IsHalfFloatFormat(m_params.Format);
 
         m_params.Width = width;
         m_params.Height = height;
@@ -498,6 +882,7 @@ public:
 
     ~OpenGLTextureCube()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
         glMakeTextureHandleNonResidentARB(m_textureHandle);
         glDeleteTextures(1, &m_rendererId);
     }
@@ -538,6 +923,10 @@ public:
     {
         return GL_TEXTURE_CUBE_MAP;
     }
+    uint64_t GetGPUMemorySize() const override
+    {
+        return 6 * GetMipChainMemorySize(m_params.Format, m_params.Width, m_params.Height, GetMipLevelCount());
+    }
     TextureFormat GetFormat() const override
     {
         return m_params.Format;
@@ -557,7 +946,7 @@ private:
 
             GLenum internalFormat = GetInternalFormat(m_params.Format);
             GLenum format = std::get<0>(GetFormatAndType(internalFormat));
-            GLenum type = std::get<1>(GetFormatAndType(internalFormat));
+            GLenum type = m_halfFloat ? GL_HALF_FLOAT : std::get<1>(GetFormatAndType(internalFormat));
             uint32_t levels = GetMipLevelCount();
             glTextureStorage2D(m_rendererId, levels, internalFormat, width, height);
 
@@ -629,6 +1018,11 @@ private:
 
             m_textureHandle = glGetTextureHandleARB(m_rendererId);
             glMakeTextureHandleResidentARB(m_textureHandle);
+
+            std::string name = m_facePaths[0];
+            if (name.empty())
+                name = fmt::format("TextureCube {}x{} {}", width, height, TextureFormatToString(m_params.Format));
+            GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::Texture, std::move(name), GetGPUMemorySize());
         });
     }
 
@@ -639,6 +1033,7 @@ private:
     std::array<std::byte *, 6> m_faceData = {nullptr};
     uint32_t m_binding;
     bool m_hdr;
+    bool m_halfFloat = false;
 };
 
 std::shared_ptr<TextureCube> TextureCube::Create(const std::array<std::string, 6> &facePaths,
@@ -26,9 +26,16 @@ public:
     virtual uint32_t GetHeight() const = 0;
     virtual uint32_t GetRendererID() const = 0;
     virtual uint64_t GetTextureHandle() const = 0;
+    // 句柄每次变化都递增，缓存了句柄的地方据此只刷新受影响的纹理
+    virtual uint32_t GetHandleVersion() const
+    {
+        return 0;
+    }
     virtual uint32_t GetTarget() const = 0;
     virtual TextureFormat GetFormat() const = 0;
     virtual uint32_t GetMipLevelCount() const = 0;
+    // 包含全部 mip 的显存占用估计，存储尚未分配时为 0
+    virtual uint64_t GetGPUMemorySize() const = 0;
 };
 
 class DOO_API Texture2D : public Texture
@@ -39,6 +46,14 @@ public:
 
     static std::shared_ptr<Texture2D> Create(Buffer buffer, const TextureParams &params = TextureParams());
 
+    // 在工作线程上解码，立即返回以占位纹理（默认白色）显示的纹理，解码完成后在 UploadAsyncTextures 中上传
+    static std::shared_ptr<Texture2D> CreateAsync(const std::string &filepath,
+                                                  const TextureParams &params = TextureParams(),
+                                                  std::shared_ptr<Texture2D> placeholder = nullptr);
+
+    // 只分配存储（包含完整 mip 链），不上传数据，用于计算着色器的输出
+    static std::shared_ptr<Texture2D> Create(const TextureParams &params);
+
     static std::shared_ptr<Texture2D> GetWhiteTexture();
 
     static std::shared_ptr<Texture2D> GetBlackTexture();
@@ -48,6 +63,34 @@ public:
     static std::shared_ptr<Texture2D> GetCheckerboardTexture();
 
     std::string GetPath() const;
+
+    static constexpr uint64_t ASYNC_UPLOAD_BUDGET = 32ull * 1024 * 1024;
+    // 流式纹理始终常驻的最粗 mip 的尺寸上限，首次加载时只上传这些 mip
+    static constexpr uint32_t STREAMING_MIN_RESIDENT_SIZE = 64;
+
+    // 每帧调用一次，在预算内上传已解码的异步纹理
+    static void UploadAsyncTextures(uint64_t budgetBytes = ASYNC_UPLOAD_BUDGET);
+    // 纹理句柄每次变化（异步纹理完成上传、流式纹理切换常驻 mip）都递增，缓存了纹理句柄的地方据此刷新
+    static uint32_t GetTextureHandleGeneration();
+
+    // 纹理数据是否已经上传，异步纹理在此之前返回占位纹理的句柄
+    virtual bool IsLoaded() const = 0;
+
+    // 以读写方式绑定某一级 mip 到 image 单元
+    virtual void BindImage(uint32_t slot, uint32_t level) = 0;
+
+    // 上传第 0 级数据并重新生成 mip，不做拷贝，data 需要保持有效直到渲染队列执行
+    virtual void SetData(const void *data) = 0;
+
+    // 以 Streamable 参数加载、数据源包含完整 mip 链（烘焙的 DDS）的纹理支持流式加载，显存中只保留从常驻 mip 开始的各级
+    virtual bool IsStreamable() const = 0;
+    virtual uint32_t GetResidentMipLevel() const = 0;
+    // 常驻 mip 最粗可以到哪一级
+    virtual uint32_t GetMaxResidentMipLevel() const = 0;
+    // 常驻从 level 开始的 mip 时的显存占用
+    virtual uint64_t GetResidentMemorySize(uint32_t level) const = 0;
+    // 重建纹理对象并更换句柄，新句柄在渲染队列执行后生效
+    virtual void SetResidentMipLevel(uint32_t level) = 0;
 };
 
 class DOO_API TextureCube : public Texture
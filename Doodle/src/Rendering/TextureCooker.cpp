@@ -0,0 +1,430 @@
+#include "pch.h"
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "BlockCompression.h"
+#include "Buffer.h"
+#include "FileSystem.h"
+#include "Log.h"
+#include "TextureCooker.h"
+#include "ThreadPool.h"
+#include "Utils.h"
+
+namespace Doodle
+{
+
+static constexpr const char *TEXTURE_CACHE_DIRECTORY = "cache/textures";
+static constexpr uint32_t DDS_MAGIC = 0x20534444;       // "DDS "
+static constexpr uint32_t DDS_FOURCC_DX10 = 0x30315844; // "DX10"
+
+// 布局与 DirectX 的 DDS_PIXELFORMAT、DDS_HEADER、DDS_HEADER_DXT10 相同
+struct DDSPixelFormat
+{
+    uint32_t Size;
+    uint32_t Flags;
+    uint32_t FourCC;
+    uint32_t RGBBitCount;
+    uint32_t RBitMask;
+    uint32_t GBitMask;
+    uint32_t BBitMask;
+    uint32_t ABitMask;
+};
+
+struct DDSHeader
+{
+    uint32_t Size;
+    uint32_t Flags;
+    uint32_t Height;
+    uint32_t Width;
+    uint32_t PitchOrLinearSize;
+    uint32_t Depth;
+    uint32_t MipMapCount;
+    uint32_t Reserved1[11];
+    DDSPixelFormat PixelFormat;
+    uint32_t Caps;
+    uint32_t Caps2;
+    uint32_t Caps3;
+    uint32_t Caps4;
+    uint32_t Reserved2;
+};
+
+struct DDSHeaderDX10
+{
+    uint32_t DXGIFormat;
+    uint32_t ResourceDimension;
+    uint32_t MiscFlag;
+    uint32_t ArraySize;
+    uint32_t MiscFlags2;
+};
+
+static_assert(sizeof(DDSHeader) == 124 && sizeof(DDSHeaderDX10) == 20);
+
+static constexpr uint64_t DDS_DATA_OFFSET = sizeof(uint32_t) + sizeof(DDSHeader) + sizeof(DDSHeaderDX10);
+
+enum DXGIFormat : uint32_t
+{
+    DXGI_FORMAT_BC4_UNORM = 80,
+    DXGI_FORMAT_BC5_UNORM = 83,
+    DXGI_FORMAT_BC6H_UF16 = 95,
+    DXGI_FORMAT_BC7_UNORM = 98,
+    DXGI_FORMAT_BC7_UNORM_SRGB = 99,
+};
+
+static uint32_t GetDXGIFormat(TextureCompression compression, bool srgb)
+{
+    switch (compression)
+    {
+    case TextureCompression::BC4:
+        return DXGI_FORMAT_BC4_UNORM;
+    case TextureCompression::BC5:
+        return DXGI_FORMAT_BC5_UNORM;
+    case TextureCompression::BC6H:
+        return DXGI_FORMAT_BC6H_UF16;
+    case TextureCompression::BC7:
+        return srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+    default:
+        return 0;
+    }
+}
+
+static TextureCompression GetCompression(uint32_t dxgiFormat, bool &srgb)
+{
+    srgb = dxgiFormat == DXGI_FORMAT_BC7_UNORM_SRGB;
+    switch (dxgiFormat)
+    {
+    case DXGI_FORMAT_BC4_UNORM:
+        return TextureCompression::BC4;
+    case DXGI_FORMAT_BC5_UNORM:
+        return TextureCompression::BC5;
+    case DXGI_FORMAT_BC6H_UF16:
+        return TextureCompression::BC6H;
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        return TextureCompression::BC7;
+    default:
+        return TextureCompression::None;
+    }
+}
+
+static float SrgbToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSrgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t ToUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+// mip 在线性空间的 RGBA 浮点像素上生成
+struct MipLevel
+{
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    std::vector<glm::vec4> Pixels;
+};
+
+static MipLevel ConvertPixels(const void *pixels, uint32_t width, uint32_t height, uint32_t channelCount, bool hdr,
+                              bool srgb)
+{
+    MipLevel level;
+    level.Width = width;
+    level.Height = height;
+    level.Pixels.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < level.Pixels.size(); i++)
+    {
+        glm::vec4 pixel(0.0f, 0.0f, 0.0f, 1.0f);
+        for (uint32_t c = 0; c < std::min(channelCount, 4u); c++)
+        {
+            float value = hdr ? static_cast<const float *>(pixels)[i * channelCount + c]
+                              : static_cast<const uint8_t *>(pixels)[i * channelCount + c] / 255.0f;
+            pixel[c] = srgb && c < 3 ? SrgbToLinear(value) : value;
+        }
+        // 灰度图（可能带透明度）复制到 RGB
+        if (channelCount <= 2)
+        {
+            pixel.a = channelCount == 2 ? pixel.g : 1.0f;
+            pixel.g = pixel.b = pixel.r;
+        }
+        level.Pixels[i] = pixel;
+    }
+    return level;
+}
+
+// 2x2 盒式滤波，奇数尺寸时边缘像素重复使用；法线贴图平均后重新归一化
+static MipLevel Downsample(const MipLevel &source, bool normalMap)
+{
+    MipLevel level;
+    level.Width = std::max(source.Width / 2, 1u);
+    level.Height = std::max(source.Height / 2, 1u);
+    level.Pixels.resize(static_cast<size_t>(level.Width) * level.Height);
+    for (uint32_t y = 0; y < level.Height; y++)
+    {
+        uint32_t y0 = std::min(y * 2, source.Height - 1);
+        uint32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+        for (uint32_t x = 0; x < level.Width; x++)
+        {
+            uint32_t x0 = std::min(x * 2, source.Width - 1);
+            uint32_t x1 = std::min(x * 2 + 1, source.Width - 1);
+            glm::vec4 pixel = (source.Pixels[y0 * source.Width + x0] + source.Pixels[y0 * source.Width + x1] +
+                               source.Pixels[y1 * source.Width + x0] + source.Pixels[y1 * source.Width + x1]) *
+                              0.25f;
+            if (normalMap)
+            {
+                glm::vec3 normal = glm::vec3(pixel) * 2.0f - 1.0f;
+                if (glm::dot(normal, normal) > 1e-8f)
+                    pixel = glm::vec4(glm::normalize(normal) * 0.5f + 0.5f, pixel.a);
+            }
+            level.Pixels[y * level.Width + x] = pixel;
+        }
+    }
+    return level;
+}
+
+static uint32_t GetBlockSize(TextureCompression compression)
+{
+    return compression == TextureCompression::BC4 ? BlockCompression::BC4_BLOCK_SIZE
+                                                  : BlockCompression::BC7_BLOCK_SIZE;
+}
+
+static void EncodeLevel(const MipLevel &level, TextureCompression compression, bool srgb, std::byte *output)
+{
+    uint32_t blocksX = (level.Width + 3) / 4;
+    uint32_t blocksY = (level.Height + 3) / 4;
+    uint32_t blockSize = GetBlockSize(compression);
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+    {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+        {
+            // 不足 4x4 的块用边缘像素补齐
+            glm::vec4 block[16];
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                uint32_t x = std::min(blockX * 4 + i % 4, level.Width - 1);
+                uint32_t y = std::min(blockY * 4 + i / 4, level.Height - 1);
+                block[i] = level.Pixels[y * level.Width + x];
+            }
+
+            auto *blockOutput = reinterpret_cast<uint8_t *>(output);
+            switch (compression)
+            {
+            case TextureCompression::BC4: {
+                uint8_t red[16];
+                for (uint32_t i = 0; i < 16; i++)
+                    red[i] = ToUnorm8(block[i].r);
+                BlockCompression::EncodeBC4Block(red, blockOutput);
+                break;
+            }
+            case TextureCompression::BC5: {
+                uint8_t red[16], green[16];
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    red[i] = ToUnorm8(block[i].r);
+                    green[i] = ToUnorm8(block[i].g);
+                }
+                BlockCompression::EncodeBC5Block(red, green, blockOutput);
+                break;
+            }
+            case TextureCompression::BC6H: {
+                uint16_t rgb[16 * 3];
+                for (uint32_t i = 0; i < 16; i++)
+                    for (uint32_t c = 0; c < 3; c++)
+                        rgb[i * 3 + c] = glm::packHalf1x16(std::max(block[i][c], 0.0f));
+                BlockCompression::EncodeBC6HBlock(rgb, blockOutput);
+                break;
+            }
+            case TextureCompression::BC7: {
+                uint8_t rgba[16 * 4];
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    for (uint32_t c = 0; c < 3; c++)
+                        rgba[i * 4 + c] = ToUnorm8(srgb ? LinearToSrgb(block[i][c]) : block[i][c]);
+                    rgba[i * 4 + 3] = ToUnorm8(block[i].a);
+                }
+                BlockCompression::EncodeBC7Block(rgba, blockOutput);
+                break;
+            }
+            default:
+                break;
+            }
+            output += blockSize;
+        }
+    }
+}
+
+uint32_t TextureCooker::GetMipCount(uint32_t width, uint32_t height)
+{
+    // 与未压缩纹理的 mip 数量一致，直到较短边为 1
+    uint32_t count = 1;
+    for (uint32_t size = std::min(width, height); size > 1; size >>= 1)
+        count++;
+    return count;
+}
+
+uint64_t TextureCooker::GetLevelSize(TextureCompression compression, uint32_t width, uint32_t height, uint32_t level)
+{
+    uint64_t blocksX = (std::max(width >> level, 1u) + 3) / 4;
+    uint64_t blocksY = (std::max(height >> level, 1u) + 3) / 4;
+    return blocksX * blocksY * GetBlockSize(compression);
+}
+
+std::filesystem::path TextureCooker::GetCookedPath(const std::string &filepath, const TextureParams &params)
+{
+    uint64_t parameters[] = {VERSION,
+                             static_cast<uint64_t>(params.Compression),
+                             static_cast<uint64_t>(params.Format),
+                             params.InvertColor,
+                             params.SourceChannel};
+    uint64_t key = HashBytes(parameters, sizeof(parameters), HashFileStamp(filepath));
+    return std::filesystem::path(TEXTURE_CACHE_DIRECTORY) / fmt::format("{:016x}.dds", key);
+}
+
+bool TextureCooker::Load(const std::filesystem::path &cookedPath, CookedImage &image)
+{
+    if (!FileSystem::Exists(cookedPath))
+        return false;
+    auto file = std::make_shared<MappedFile>(cookedPath);
+    if (!*file || file->GetSize() < DDS_DATA_OFFSET)
+        return false;
+
+    uint32_t magic;
+    DDSHeader header;
+    DDSHeaderDX10 headerDX10;
+    std::memcpy(&magic, file->GetData(), sizeof(magic));
+    std::memcpy(&header, file->GetData() + sizeof(magic), sizeof(header));
+    std::memcpy(&headerDX10, file->GetData() + sizeof(magic) + sizeof(header), sizeof(headerDX10));
+
+    bool srgb = false;
+    TextureCompression compression = GetCompression(headerDX10.DXGIFormat, srgb);
+    bool valid = magic == DDS_MAGIC && header.Size == sizeof(DDSHeader) &&
+                 header.PixelFormat.FourCC == DDS_FOURCC_DX10 && headerDX10.ResourceDimension == 3 &&
+                 headerDX10.ArraySize == 1 && compression != TextureCompression::None && header.Width > 0 &&
+                 header.Height > 0;
+    uint32_t mipCount = std::max(header.MipMapCount, 1u);
+    uint64_t dataSize = 0;
+    for (uint32_t level = 0; valid && level < mipCount; level++)
+        dataSize += GetLevelSize(compression, header.Width, header.Height, level);
+    if (!valid || file->GetSize() < DDS_DATA_OFFSET + dataSize)
+    {
+        DOO_CORE_WARN("Invalid or unsupported DDS file: {0}", cookedPath.string());
+        return false;
+    }
+
+    image.File = file;
+    image.Data = file->GetData() + DDS_DATA_OFFSET;
+    image.Width = header.Width;
+    image.Height = header.Height;
+    image.MipCount = mipCount;
+    image.Compression = compression;
+    image.Srgb = srgb;
+    return true;
+}
+
+bool TextureCooker::Cook(const void *pixels, uint32_t width, uint32_t height, uint32_t channelCount, bool hdr,
+                         const TextureParams &params, const std::filesystem::path &cookedPath)
+{
+    TextureCompression compression = params.Compression;
+    if (compression == TextureCompression::None || (hdr && compression != TextureCompression::BC6H))
+        return false;
+
+    bool srgb = compression == TextureCompression::BC7 &&
+                (params.Format == TextureFormat::SRGB8 || params.Format == TextureFormat::SRGB8ALPHA8);
+    uint32_t mipCount = GetMipCount(width, height);
+    uint64_t dataSize = 0;
+    for (uint32_t level = 0; level < mipCount; level++)
+        dataSize += GetLevelSize(compression, width, height, level);
+
+    uint32_t magic = DDS_MAGIC;
+    DDSHeader header = {};
+    header.Size = sizeof(DDSHeader);
+    // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+    header.Flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000;
+    header.Height = height;
+    header.Width = width;
+    header.PitchOrLinearSize = static_cast<uint32_t>(GetLevelSize(compression, width, height, 0));
+    header.MipMapCount = mipCount;
+    header.PixelFormat.Size = sizeof(DDSPixelFormat);
+    header.PixelFormat.Flags = 0x4; // FOURCC
+    header.PixelFormat.FourCC = DDS_FOURCC_DX10;
+    header.Caps = 0x8 | 0x1000 | 0x400000; // COMPLEX | TEXTURE | MIPMAP
+    DDSHeaderDX10 headerDX10 = {};
+    headerDX10.DXGIFormat = GetDXGIFormat(compression, srgb);
+    headerDX10.ResourceDimension = 3; // TEXTURE2D
+    headerDX10.ArraySize = 1;
+
+    Buffer buffer;
+    buffer.Allocate(DDS_DATA_OFFSET + dataSize);
+    buffer.Write(&magic, sizeof(magic));
+    buffer.Write(&header, sizeof(header), sizeof(magic));
+    buffer.Write(&headerDX10, sizeof(headerDX10), sizeof(magic) + sizeof(header));
+
+    MipLevel level = ConvertPixels(pixels, width, height, channelCount, hdr, srgb);
+    uint64_t offset = DDS_DATA_OFFSET;
+    for (uint32_t mip = 0; mip < mipCount; mip++)
+    {
+        if (mip > 0)
+            level = Downsample(level, compression == TextureCompression::BC5);
+        EncodeLevel(level, compression, srgb, buffer.As<std::byte>() + offset);
+        offset += GetLevelSize(compression, width, height, mip);
+    }
+
+    bool written = FileSystem::WriteBytesAtomic(cookedPath, buffer);
+    buffer.Release();
+    if (!written)
+    {
+        DOO_CORE_ERROR("Failed to write cooked texture: {0}", cookedPath.string());
+        return false;
+    }
+    return true;
+}
+
+// 烘焙只占用一半的核心，避免与纹理解码争抢
+struct TextureCookQueue
+{
+    std::mutex Mutex;
+    std::unordered_set<std::string> Pending;
+    ThreadPool Workers{std::max(ThreadPool::GetDefaultThreadCount() / 2, 1u)};
+};
+
+static TextureCookQueue &GetTextureCookQueue()
+{
+    static TextureCookQueue s_Queue;
+    return s_Queue;
+}
+
+void TextureCooker::CookAsync(const void *pixels, uint32_t width, uint32_t height, uint32_t channelCount, bool hdr,
+                              const TextureParams &params, const std::filesystem::path &cookedPath)
+{
+    if (params.Compression == TextureCompression::None || (hdr && params.Compression != TextureCompression::BC6H))
+        return;
+
+    auto &queue = GetTextureCookQueue();
+    {
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        if (!queue.Pending.insert(cookedPath.string()).second)
+            return;
+    }
+
+    uint64_t size = static_cast<uint64_t>(width) * height * channelCount * (hdr ? sizeof(float) : sizeof(uint8_t));
+    auto copy = std::make_shared<std::vector<std::byte>>(size);
+    std::memcpy(copy->data(), pixels, size);
+    queue.Workers.Enqueue([copy, width, height, channelCount, hdr, params, cookedPath]() {
+        if (Cook(copy->data(), width, height, channelCount, hdr, params, cookedPath))
+            DOO_CORE_TRACE("Texture cooked: {0}", cookedPath.string());
+        auto &queue = GetTextureCookQueue();
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Pending.erase(cookedPath.string());
+    });
+}
+
+} // namespace Doodle
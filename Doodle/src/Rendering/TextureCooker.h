@@ -0,0 +1,51 @@
+#pragma once
+
+#include "pch.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "MappedFile.h"
+#include "TextureParams.h"
+
+namespace Doodle
+{
+
+// 从 DDS 文件映射出的块压缩纹理，各级 mip 从 Data 开始依次紧密排列
+struct CookedImage
+{
+    std::shared_ptr<MappedFile> File;
+    const std::byte *Data = nullptr;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint32_t MipCount = 0;
+    TextureCompression Compression = TextureCompression::None;
+    bool Srgb = false;
+};
+
+// 纹理的离线烘焙：在 CPU 上生成完整 mip 链并编码为 BC 格式，以带 DX10 头的 DDS 保存在缓存目录。
+// 行序与引擎上传的像素一致（自下而上），加载时无需翻转
+class DOO_API TextureCooker
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // 文件名由源文件路径、大小、修改时间与压缩参数的哈希决定，源文件修改后自动失效
+    static std::filesystem::path GetCookedPath(const std::string &filepath, const TextureParams &params);
+
+    static bool Load(const std::filesystem::path &cookedPath, CookedImage &image);
+
+    // pixels 为 8 位或 32 位浮点（hdr）的 channelCount 通道像素，可以在任意线程上调用
+    static bool Cook(const void *pixels, uint32_t width, uint32_t height, uint32_t channelCount, bool hdr,
+                     const TextureParams &params, const std::filesystem::path &cookedPath);
+
+    // 复制像素后交给后台线程烘焙，同一输出文件同时只烘焙一次
+    static void CookAsync(const void *pixels, uint32_t width, uint32_t height, uint32_t channelCount, bool hdr,
+                          const TextureParams &params, const std::filesystem::path &cookedPath);
+
+    static uint32_t GetMipCount(uint32_t width, uint32_t height);
+    static uint64_t GetLevelSize(TextureCompression compression, uint32_t width, uint32_t height, uint32_t level);
+};
+
+} // namespace Doodle
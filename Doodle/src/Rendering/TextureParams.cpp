@@ -64,4 +64,21 @@ std::string TextureFilterToString(TextureFilter filter)
     }
 }
 
+std::string TextureCompressionToString(TextureCompression compression)
+{
+    switch (compression)
+    {
+    case TextureCompression::BC4:
+        return "BC4";
+    case TextureCompression::BC5:
+        return "BC5";
+    case TextureCompression::BC6H:
+        return "BC6H";
+    case TextureCompression::BC7:
+        return "BC7";
+    default:
+        return "None";
+    }
+}
+
 } // namespace Doodle
\ No newline at end of file
@@ -41,9 +41,20 @@ enum class TextureFilter
     MipmapNearest = 3,
     MipmapLinear = 4,
 };
+
+// 离线烘焙使用的块压缩格式，None 表示直接上传解码后的像素
+enum class TextureCompression
+{
+    None = 0,
+    BC4 = 1,  // 单通道，粗糙度、金属度
+    BC5 = 2,  // 双通道，切线空间法线的 xy
+    BC6H = 3, // HDR RGB
+    BC7 = 4,  // LDR RGBA，基础色
+};
 DOO_API std::string TextureFormatToString(TextureFormat format);
 DOO_API std::string TextureWrapToString(TextureWrap wrap);
 DOO_API std::string TextureFilterToString(TextureFilter filter);
+DOO_API std::string TextureCompressionToString(TextureCompression compression);
 
 struct TextureParams
 {
@@ -52,13 +63,17 @@ struct TextureParams
     TextureFilter Filter = TextureFilter::Linear;
     uint32_t Width = 1;
     uint32_t Height = 1;
-    bool InvertColor = false; // only works for LDR textures
+    bool InvertColor = false;   // only works for LDR textures
+    uint32_t SourceChannel = 0; // copied into RGB when non-zero, only works for LDR textures
+    bool Streamable = false;    // only works for cooked textures, starts with the coarsest mips resident
+    TextureCompression Compression = TextureCompression::None; // only works for textures loaded from files
 
     std::string ToString() const
     {
         std::ostringstream oss;
         oss << "Format=" << TextureFormatToString(Format) << ", Wrap=" << TextureWrapToString(Wrap)
-            << ", Filter=" << TextureFilterToString(Filter) << ", Width=" << Width << ", Height=" << Height;
+            << ", Filter=" << TextureFilterToString(Filter) << ", Width=" << Width << ", Height=" << Height
+            << ", Compression=" << TextureCompressionToString(Compression);
         return oss.str();
     }
 };
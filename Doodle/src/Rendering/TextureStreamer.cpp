@@ -0,0 +1,195 @@
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "MaterialInstance.h"
+#include "Mesh.h"
+#include "RenderList.h"
+#include "Renderer.h"
+#include "TextureStreamer.h"
+
+namespace Doodle
+{
+
+static const std::string STREAMING_TEXTURE_NAMES[] = {"u_AlbedoTexture", "u_NormalTexture", "u_MetallicTexture",
+                                                       "u_RoughnessTexture"};
+
+bool TextureStreamer::IsStreamedTexture(const std::string &name)
+{
+    return std::find(std::begin(STREAMING_TEXTURE_NAMES), std::end(STREAMING_TEXTURE_NAMES), name) !=
+           std::end(STREAMING_TEXTURE_NAMES);
+}
+
+void TextureStreamer::RequestTextures(MaterialInstance &materialInstance, float uvPerPixel)
+{
+    for (const auto &name : STREAMING_TEXTURE_NAMES)
+    {
+        auto texture = std::dynamic_pointer_cast<Texture2D>(materialInstance.GetUniformTexture(name));
+        if (!texture || !texture->IsStreamable())
+            continue;
+
+        // 一个屏幕像素覆盖的纹素数量的 log2 即采样时选中的 mip
+        float texelsPerPixel = uvPerPixel * std::sqrt(static_cast<float>(texture->GetWidth()) * texture->GetHeight());
+        uint32_t level = static_cast<uint32_t>(std::floor(std::log2(std::max(texelsPerPixel, 1.0f))));
+        level = std::min(level, texture->GetMaxResidentMipLevel());
+
+        auto &state = m_textures[texture.get()];
+        if (state.Texture.expired())
+            state = {texture, level, m_frame, m_frame};
+        else if (state.LastUsedFrame != m_frame)
+            state.RequestedLevel = level;
+        else
+            state.RequestedLevel = std::min(state.RequestedLevel, level);
+        state.LastUsedFrame = m_frame;
+    }
+}
+
+void TextureStreamer::SetResidentMipLevel(const std::shared_ptr<Texture2D> &texture, uint32_t level)
+{
+    m_residentBytes -= texture->GetResidentMemorySize(texture->GetResidentMipLevel());
+    texture->SetResidentMipLevel(level);
+    m_residentBytes += texture->GetResidentMemorySize(level);
+    // 重建纹理的命令在帧末执行，期间纹理不能被释放
+    Renderer::Submit([texture]() {});
+}
+
+void TextureStreamer::Update(const glm::vec3 &cameraPosition, const glm::mat4 &projection, uint32_t viewportHeight)
+{
+    m_frame++;
+    bool perspective = projection[3][3] == 0.0f;
+    // 距离为 1 处一个像素对应的世界空间尺寸，正交投影与距离无关
+    float worldPerPixelScale = 2.0f / (projection[1][1] * static_cast<float>(std::max(viewportHeight, 1u)));
+
+    // 同一材质实例只保留最大的需求
+    std::unordered_map<MaterialInstance *, float> materialRequests;
+    for (const auto &item : RenderList::Get()->GetMeshItems())
+    {
+        if (!item.MaterialInstance || !item.Mesh)
+            continue;
+
+        float worldPerPixel = worldPerPixelScale;
+        float maxScale = std::max({glm::length(glm::vec3(item.Model[0])), glm::length(glm::vec3(item.Model[1])),
+                                   glm::length(glm::vec3(item.Model[2]))});
+        if (perspective && item.WorldBounds.IsValid())
+        {
+            float radius = glm::length(item.WorldBounds.GetExtents());
+            float distance = std::max(glm::length(item.WorldBounds.GetCenter() - cameraPosition) - radius, 0.1f);
+            worldPerPixel *= distance;
+        }
+        float uvPerPixel = worldPerPixel * item.Mesh->GetUVDensity() / std::max(maxScale, 1e-4f);
+
+        auto [it, inserted] = materialRequests.try_emplace(item.MaterialInstance, uvPerPixel);
+        if (!inserted)
+            it->second = std::min(it->second, uvPerPixel);
+    }
+    // 没有网格信息的顶点数组物体直接请求完整的 mip 链
+    for (const auto &item : RenderList::Get()->GetVertexArrayItems())
+    {
+        if (item.MaterialInstance)
+            materialRequests[item.MaterialInstance] = 0.0f;
+    }
+    for (auto [materialInstance, uvPerPixel] : materialRequests)
+        RequestTextures(*materialInstance, m_enabled ? uvPerPixel : 0.0f);
+
+    std::vector<std::pair<std::shared_ptr<Texture2D>, TextureState *>> textures;
+    m_residentBytes = 0;
+    for (auto it = m_textures.begin(); it != m_textures.end();)
+    {
+        auto texture = it->second.Texture.lock();
+        if (!texture)
+        {
+            it = m_textures.erase(it);
+            continue;
+        }
+        auto &state = it->second;
+        if (!m_enabled)
+            state.RequestedLevel = 0;
+        else if (state.LastUsedFrame != m_frame)
+            state.RequestedLevel = UINT32_MAX;
+        if (state.RequestedLevel <= texture->GetResidentMipLevel())
+            state.LastNeededFrame = m_frame;
+        m_residentBytes += texture->GetResidentMemorySize(texture->GetResidentMipLevel());
+        textures.emplace_back(std::move(texture), &state);
+        ++it;
+    }
+
+    // 换出：一段时间内都不需要的 mip 降到当前需要的级别
+    for (auto &[texture, state] : textures)
+    {
+        uint32_t wantedLevel = std::min(state->RequestedLevel, texture->GetMaxResidentMipLevel());
+        if (wantedLevel > texture->GetResidentMipLevel() && m_frame - state->LastNeededFrame > STREAM_OUT_DELAY)
+        {
+            SetResidentMipLevel(texture, wantedLevel);
+            state->LastNeededFrame = m_frame;
+        }
+    }
+
+    // 超出预算时逐级换出，优先多余 mip 最多的纹理，其次最久未使用的
+    auto getExcess = [](const std::shared_ptr<Texture2D> &texture, const TextureState &state) {
+        uint32_t wantedLevel = std::min(state.RequestedLevel, texture->GetMaxResidentMipLevel());
+        return static_cast<int32_t>(wantedLevel) - static_cast<int32_t>(texture->GetResidentMipLevel());
+    };
+    while (m_residentBytes > m_budget)
+    {
+        std::pair<std::shared_ptr<Texture2D>, TextureState *> *victim = nullptr;
+        for (auto &entry : textures)
+        {
+            if (entry.first->GetResidentMipLevel() >= entry.first->GetMaxResidentMipLevel())
+                continue;
+            if (!victim)
+            {
+                victim = &entry;
+                continue;
+            }
+            int32_t excess = getExcess(entry.first, *entry.second);
+            int32_t victimExcess = getExcess(victim->first, *victim->second);
+            if (excess > victimExcess ||
+                (excess == victimExcess && entry.second->LastUsedFrame < victim->second->LastUsedFrame))
+                victim = &entry;
+        }
+        if (!victim)
+            break;
+        SetResidentMipLevel(victim->first, victim->first->GetResidentMipLevel() + 1);
+    }
+
+    // 换入：按缺少的 mip 级数从多到少处理，受显存预算与每帧上传量限制
+    std::vector<std::pair<std::shared_ptr<Texture2D>, TextureState *>> pending;
+    for (auto &entry : textures)
+    {
+        if (entry.second->RequestedLevel < entry.first->GetResidentMipLevel())
+            pending.push_back(entry);
+    }
+    std::sort(pending.begin(), pending.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first->GetResidentMipLevel() - lhs.second->RequestedLevel >
+               rhs.first->GetResidentMipLevel() - rhs.second->RequestedLevel;
+    });
+
+    uint64_t uploadBytes = 0;
+    for (auto &[texture, state] : pending)
+    {
+        uint32_t residentLevel = texture->GetResidentMipLevel();
+        uint64_t residentSize = texture->GetResidentMemorySize(residentLevel);
+        // 选择预算内能达到的最精细的 mip
+        uint32_t level = state->RequestedLevel;
+        while (level < residentLevel)
+        {
+            uint64_t growth = texture->GetResidentMemorySize(level) - residentSize;
+            bool fitsUpload = uploadBytes == 0 || uploadBytes + growth <= UPLOAD_BUDGET;
+            if (m_residentBytes + growth <= m_budget && fitsUpload)
+                break;
+            level++;
+        }
+        if (level >= residentLevel)
+            continue;
+
+        uploadBytes += texture->GetResidentMemorySize(level) - residentSize;
+        SetResidentMipLevel(texture, level);
+        state->LastNeededFrame = m_frame;
+        if (uploadBytes >= UPLOAD_BUDGET)
+            break;
+    }
+}
+
+} // namespace Doodle
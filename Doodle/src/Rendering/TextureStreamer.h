@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Singleton.h"
+#include "Texture.h"
+
+namespace Doodle
+{
+
+class MaterialInstance;
+// 流式纹理的常驻 mip 管理：每帧根据 RenderList 中物体的屏幕尺寸与网格的 UV 密度估计各材质纹理需要的 mip，
+// 在显存预算内换入更精细的 mip，长时间不需要或超出预算时换出
+class DOO_API TextureStreamer : public Singleton<TextureStreamer>
+{
+public:
+    static constexpr uint64_t DEFAULT_BUDGET = 512ull * 1024 * 1024;
+    // 每帧换入的数据量上限，至少换入一张纹理
+    static constexpr uint64_t UPLOAD_BUDGET = 16ull * 1024 * 1024;
+    // 不再需要的 mip 保留的帧数，避免镜头来回移动时反复换入换出
+    static constexpr uint32_t STREAM_OUT_DELAY = 120;
+
+    struct TextureState
+    {
+        std::weak_ptr<Texture2D> Texture;
+        uint32_t RequestedLevel = UINT32_MAX; // 本帧需要的最精细 mip，没有物体使用时为 UINT32_MAX
+        uint32_t LastUsedFrame = 0;
+        uint32_t LastNeededFrame = 0; // 最近一次需要当前常驻的全部 mip 的帧
+    };
+
+    // 只有这些材质纹理参与流式加载，模型导入时以 Streamable 参数加载
+    static bool IsStreamedTexture(const std::string &name);
+
+    void Update(const glm::vec3 &cameraPosition, const glm::mat4 &projection, uint32_t viewportHeight);
+
+    void SetEnabled(bool enabled)
+    {
+        m_enabled = enabled;
+    }
+
+    bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    void SetBudget(uint64_t budget)
+    {
+        m_budget = budget;
+    }
+
+    uint64_t GetBudget() const
+    {
+        return m_budget;
+    }
+
+    uint64_t GetResidentBytes() const
+    {
+        return m_residentBytes;
+    }
+
+    const std::unordered_map<Texture2D *, TextureState> &GetTextures() const
+    {
+        return m_textures;
+    }
+
+private:
+    void RequestTextures(MaterialInstance &materialInstance, float uvPerPixel);
+    void SetResidentMipLevel(const std::shared_ptr<Texture2D> &texture, uint32_t level);
+
+    std::unordered_map<Texture2D *, TextureState> m_textures;
+    uint64_t m_budget = DEFAULT_BUDGET;
+    uint64_t m_residentBytes = 0;
+    uint32_t m_frame = 0;
+    bool m_enabled = true;
+};
+
+} // namespace Doodle
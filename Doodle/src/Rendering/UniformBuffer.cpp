@@ -2,6 +2,7 @@
 #include <glad/glad.h>
 #include <sstream>
 
+#include "GPUMemoryTracker.h"
 #include "Log.h"
 #include "Renderer.h"
 #include "UniformBuffer.h"
@@ -21,6 +22,7 @@ public:
             glNamedBufferData(m_rendererId, m_size, data, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
             DOO_CORE_DEBUG("UBO <{0}> created: size={1}, dynamic={2}", m_rendererId, m_size, m_dynamic);
         });
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::UniformBuffer, "UniformBuffer", m_size);
     }
 
     OpenGLUniformBuffer(size_t size, bool dynamic)
@@ -32,10 +34,12 @@ public:
             glNamedBufferData(m_rendererId, m_size, nullptr, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
             DOO_CORE_DEBUG("UBO <{0}> created: size={1}, dynamic={2}", m_rendererId, m_size, m_dynamic);
         });
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::UniformBuffer, "UniformBuffer", m_size);
     }
 
     ~OpenGLUniformBuffer()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
         Renderer::Submit([this]() { glDeleteBuffers(1, &m_rendererId); });
     }
 
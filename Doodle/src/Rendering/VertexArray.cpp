@@ -32,6 +32,12 @@ std::pair<GLenum, size_t> GetGLType(VertexDataType type)
         {VertexDataType::Vec4, {GL_FLOAT, sizeof(float)}},
         {VertexDataType::Mat3, {GL_FLOAT, sizeof(float)}},
         {VertexDataType::Mat4, {GL_FLOAT, sizeof(float)}},
+        {VertexDataType::Short2, {GL_SHORT, sizeof(int16_t)}},
+        {VertexDataType::Short4, {GL_SHORT, sizeof(int16_t)}},
+        {VertexDataType::UnsignedShort2, {GL_UNSIGNED_SHORT, sizeof(uint16_t)}},
+        {VertexDataType::UnsignedShort4, {GL_UNSIGNED_SHORT, sizeof(uint16_t)}},
+        {VertexDataType::Half2, {GL_HALF_FLOAT, sizeof(uint16_t)}},
+        {VertexDataType::Half4, {GL_HALF_FLOAT, sizeof(uint16_t)}},
     };
     auto it = TYPE_MAP.find(type);
     DOO_CORE_ASSERT(it != TYPE_MAP.end(), "Unknown vertex data type");
@@ -1,4 +1,5 @@
 #include "VertexBuffer.h"
+#include "GPUMemoryTracker.h"
 #include "Log.h"
 #include "Renderer.h"
 #include <cstddef>
@@ -40,6 +41,14 @@ size_t GetSize(VertexDataType type)
         return sizeof(float) * 9;
     case VertexDataType::Mat4:
         return sizeof(float) * 16;
+    case VertexDataType::Short2:
+    case VertexDataType::UnsignedShort2:
+    case VertexDataType::Half2:
+        return sizeof(uint16_t) * 2;
+    case VertexDataType::Short4:
+    case VertexDataType::UnsignedShort4:
+    case VertexDataType::Half4:
+        return sizeof(uint16_t) * 4;
     default:
         DOO_CORE_ASSERT(false, "Unknown vertex data type");
         return 0;
@@ -57,10 +66,12 @@ public:
             glCreateBuffers(1, &m_rendererId);
             glNamedBufferData(m_rendererId, m_size, data, m_dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
         });
+        GPUMemoryTracker::Get()->Track(this, GPUMemoryCategory::Geometry, "VertexBuffer", m_size);
     }
 
     ~OpenGLVertexBuffer()
     {
+        GPUMemoryTracker::Get()->Untrack(this);
         Renderer::Submit([this]() { glDeleteBuffers(1, &m_rendererId); });
     }
 
@@ -25,7 +25,13 @@ enum class VertexDataType
     Vec3,
     Vec4,
     Mat3,
-    Mat4
+    Mat4,
+    Short2, // 与 normalized 一起使用时为 snorm16
+    Short4,
+    UnsignedShort2,
+    UnsignedShort4,
+    Half2,
+    Half4
 };
 
 struct BufferElement
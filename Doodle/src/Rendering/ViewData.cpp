@@ -0,0 +1,48 @@
+#include "pch.h"
+#include <glad/glad.h>
+
+#include "Framebuffer.h"
+#include "Renderer.h"
+#include "Texture.h"
+#include "ViewData.h"
+
+namespace Doodle
+{
+
+// 与着色器中 FrameTextureBuffer 的 std430 布局一一对应
+struct GPUFrameTextures
+{
+    uint64_t PrefilterMap;
+    uint64_t BrdfLUT;
+    uint64_t LTC1;
+    uint64_t LTC2;
+    uint64_t ShadowMap;
+    uint64_t OcclusionMap;
+};
+
+FrameTextureBuffer::FrameTextureBuffer()
+{
+    m_storageBuffer = StorageBuffer::Create(sizeof(GPUFrameTextures), true);
+}
+
+void FrameTextureBuffer::Update(const FrameTextures &textures)
+{
+    // 帧缓冲调整大小后句柄会在渲染线程上重新生成，因此在渲染线程上读取句柄
+    Renderer::Submit([this, textures]() {
+        GPUFrameTextures data = {};
+        data.PrefilterMap = textures.PrefilterMap->GetTextureHandle();
+        data.BrdfLUT = textures.BrdfLUT->GetTextureHandle();
+        data.LTC1 = textures.LTC1->GetTextureHandle();
+        data.LTC2 = textures.LTC2->GetTextureHandle();
+        data.ShadowMap = textures.ShadowMap->GetDepthAttachmentTextureHandle();
+        data.OcclusionMap = textures.OcclusionMap->GetColorAttachmentTextureHandle(0);
+        glNamedBufferSubData(m_storageBuffer->GetRendererID(), 0, sizeof(GPUFrameTextures), &data);
+    });
+}
+
+void FrameTextureBuffer::Bind() const
+{
+    m_storageBuffer->Bind(FRAME_TEXTURE_BUFFER_BINDING);
+}
+
+} // namespace Doodle
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "StorageBuffer.h"
+
+namespace Doodle
+{
+
+// 与着色器中 ViewData 的 std140 布局一一对应
+struct UBOView
+{
+    glm::mat4 View{1.0f};
+    glm::mat4 Projection{1.0f};
+    glm::mat4 ViewProjection{1.0f};
+    glm::mat4 LightSpaceMatrix{1.0f};
+    float NearPlane = 0.1f;
+    float FarPlane = 1000.0f;
+    float Padding[2];
+    // 未抖动的当前帧与上一帧矩阵，用于计算运动矢量
+    glm::mat4 UnjitteredViewProjection{1.0f};
+    glm::mat4 PreviousViewProjection{1.0f};
+};
+
+class Texture;
+class FrameBuffer;
+struct FrameTextures
+{
+    std::shared_ptr<Texture> PrefilterMap;
+    std::shared_ptr<Texture> BrdfLUT;
+    std::shared_ptr<Texture> LTC1;
+    std::shared_ptr<Texture> LTC2;
+    std::shared_ptr<FrameBuffer> ShadowMap;
+    std::shared_ptr<FrameBuffer> OcclusionMap;
+};
+
+// 着色所需的全局纹理句柄，每帧上传一次而不是逐次绘制设置统一值
+class DOO_API FrameTextureBuffer
+{
+public:
+    static constexpr uint32_t FRAME_TEXTURE_BUFFER_BINDING = 5;
+
+    FrameTextureBuffer();
+
+    void Update(const FrameTextures &textures);
+    void Bind() const;
+
+private:
+    std::shared_ptr<StorageBuffer> m_storageBuffer;
+};
+
+} // namespace Doodle
@@ -10,9 +10,11 @@
 #include <memory>
 #include <vector>
 
+#include "AssetManager.h"
 #include "Component.h"
 #include "EditorCamera.h"
 #include "Entity.h"
+#include "EnvironmentLoader.h"
 #include "EventManager.h"
 #include "Model.h"
 #include "Scene.h"
@@ -40,7 +42,28 @@ Scene::~Scene()
 void Scene::OnUpdate()
 {
     UpdateGlobalTransforms();
+    UpdateStaticMaterials();
     UpdateSceneData();
+    UpdateEnvironmentLoader();
+}
+
+void Scene::UpdateStaticMaterials()
+{
+    // 静态合批使用合并时的材质状态，任一静态物体的材质实例被替换或修改都需要重建
+    size_t hash = 0;
+    auto view = m_registry.view<TransformComponent, MaterialComponent>();
+    for (auto entity : view)
+    {
+        if (!view.get<TransformComponent>(entity).Static)
+            continue;
+        const auto &materialInstance = view.get<MaterialComponent>(entity).MaterialInstance;
+        hash += std::hash<MaterialInstance *>{}(materialInstance.get()) ^ materialInstance->GetVersion();
+    }
+    if (hash != m_staticMaterialHash)
+    {
+        m_staticMaterialHash = hash;
+        MarkStaticDirty();
+    }
 }
 
 void Scene::UpdateGlobalTransformTree(const TransformComponent &parentTransform, bool parentDirty)
@@ -48,8 +71,12 @@ void Scene::UpdateGlobalTransformTree(const TransformComponent &parentTransform,
     for (auto &entity : parentTransform.GetChildren())
     {
         auto &transform = entity.GetComponent<TransformComponent>();
-        transform.UpdateGlobalTransform(parentTransform.GlobalTransform);
         bool dirty = parentDirty || transform.Dirty;
+        transform.UpdateGlobalTransform(parentTransform.GlobalTransform);
+        if (dirty && transform.Static)
+        {
+            MarkStaticDirty();
+        }
         UpdateGlobalTransformTree(transform, dirty);
     }
 }
@@ -62,9 +89,13 @@ void Scene::UpdateGlobalTransforms()
         auto &transform = view.get<TransformComponent>(entity);
         if (transform.ParentHandle == UUID::Nil())
         {
-            auto &globalTransform = transform.GlobalTransform;
+            bool dirty = transform.Dirty;
             transform.UpdateGlobalTransform();
-            UpdateGlobalTransformTree(transform, transform.Dirty);
+            if (dirty && transform.Static)
+            {
+                MarkStaticDirty();
+            }
+            UpdateGlobalTransformTree(transform, dirty);
         }
     }
 }
@@ -96,14 +127,16 @@ Entity Scene::CreateEntity(const std::string &name)
     return entity;
 }
 
-Entity Scene::ProcessModelNode(ModelNode node)
+Entity Scene::ProcessModelNode(ModelNode node, bool isStatic)
 {
     Entity entity = CreateEntity(node.Name);
+    entity.GetComponent<TransformComponent>().SetStatic(isStatic);
     for (auto &[meshName, mesh] : node.Meshes)
     {
         Entity meshEntity = CreateEntity(meshName);
         meshEntity.AddComponent<MeshComponent>(mesh);
         meshEntity.GetComponent<TransformComponent>().SetParent(entity);
+        meshEntity.GetComponent<TransformComponent>().SetStatic(isStatic);
         auto material = StandardMaterial::Create();
         for (auto &[name, texture] : mesh->GetTextures())
         {
@@ -122,15 +155,15 @@ Entity Scene::ProcessModelNode(ModelNode node)
 
     for (auto &childNode : node.Children)
     {
-        auto child = ProcessModelNode(childNode);
+        auto child = ProcessModelNode(childNode, isStatic);
         child.GetComponent<TransformComponent>().SetParent(entity);
     }
     return entity;
 }
 
-Entity Scene::CreateEntityFromModel(std::shared_ptr<Model> model)
+Entity Scene::CreateEntityFromModel(std::shared_ptr<Model> model, bool isStatic)
 {
-    return ProcessModelNode(model->GetRootNode());
+    return ProcessModelNode(model->GetRootNode(), isStatic);
 }
 
 Entity Scene::FindEntity(const std::string &name) const
@@ -180,6 +213,10 @@ void Scene::RemoveEntity(const UUID &id)
         SelectionManager::Deselect(SelectionContext::Global, id);
     }
     auto entity = m_entityMap[id];
+    if (entity.GetComponent<TransformComponent>().Static)
+    {
+        MarkStaticDirty();
+    }
     auto parent = entity.GetParent();
     if (parent)
     {
@@ -201,78 +238,32 @@ void Scene::DestroyEntity(const Entity &entity)
     RemoveEntity(id);
 }
 
-void Scene::LoadEnvironment(const std::string &filepath)
+void Scene::LoadEnvironment(const std::string &filepath, bool progressive)
 {
-    const uint32_t CUBEMAP_SIZE = 2048;
-    const uint32_t IRRADIANCE_MAP_SIZE = 32;
-
-    TextureParams params;
-    params.Width = CUBEMAP_SIZE;
-    params.Height = CUBEMAP_SIZE;
-    params.Format = TextureFormat::RGBA16F;
-    params.Wrap = TextureWrap::ClampToEdge;
-    params.Filter = TextureFilter::MipmapLinear;
-
-    std::shared_ptr<TextureCube> envUnfiltered = TextureCube::Create(params);
-    static std::shared_ptr<Shader> s_EquirectangularConversionShader, s_EnvFilteringShader, s_EnvIrradianceShader;
-    if (!s_EquirectangularConversionShader)
-        s_EquirectangularConversionShader = Shader::Create("assets/shaders/equirectangularToCubeMap.glsl");
-
-    TextureParams equirectParams;
-    equirectParams.Format = TextureFormat::RGBA16F;
-    std::shared_ptr<Texture2D> envEquirect = Texture2D::Create(filepath, equirectParams);
-    DOO_CORE_ASSERT(envEquirect->GetFormat() == TextureFormat::RGBA16F, "Texture is not HDR!");
-
-    s_EquirectangularConversionShader->Bind();
-    envEquirect->Bind();
-    Renderer::Submit([envUnfiltered, CUBEMAP_SIZE, envEquirect]() {
-        glBindImageTexture(0, envUnfiltered->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-        glDispatchCompute(CUBEMAP_SIZE / 32, CUBEMAP_SIZE / 32, 6);
-        glGenerateTextureMipmap(envUnfiltered->GetRendererID());
-    });
-
-    if (!s_EnvFilteringShader)
-        s_EnvFilteringShader = Shader::Create("assets/shaders/environmentMipFilter.glsl");
-
-    std::shared_ptr<TextureCube> envFiltered = TextureCube::Create(params);
-
-    Renderer::Submit([envUnfiltered, envFiltered]() {
-        glCopyImageSubData(envUnfiltered->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0,
-                           envFiltered->GetRendererID(), GL_TEXTURE_CUBE_MAP, 0, 0, 0, 0, envFiltered->GetWidth(),
-                           envFiltered->GetHeight(), 6);
-    });
-
-    s_EnvFilteringShader->Bind();
-    envUnfiltered->Bind();
-
-    Renderer::Submit([envUnfiltered, envFiltered, CUBEMAP_SIZE]() {
-        const float DELTA_ROUGHNESS = 1.0f / glm::max((envFiltered->GetMipLevelCount() - 1.0f), 1.0f);
-        for (int level = 1, size = CUBEMAP_SIZE / 2; level < envFiltered->GetMipLevelCount();
-             level++, size /= 2) // <= ?
-        {
-            const GLuint NUM_GROUPS = glm::max(1, size / 32);
-            glBindImageTexture(0, envFiltered->GetRendererID(), level, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-            glProgramUniform1f(s_EnvFilteringShader->GetRendererID(), 0, level * DELTA_ROUGHNESS);
-            glDispatchCompute(NUM_GROUPS, NUM_GROUPS, 6);
-        }
-    });
-
-    if (!s_EnvIrradianceShader)
-        s_EnvIrradianceShader = Shader::Create("assets/shaders/environmentIrradiance.glsl");
-
-    params.Width = IRRADIANCE_MAP_SIZE;
-    params.Height = IRRADIANCE_MAP_SIZE;
-    params.Filter = TextureFilter::Linear;
+    m_environmentLoader = EnvironmentLoader::Create(filepath);
+    if (progressive)
+        return;
 
-    std::shared_ptr<TextureCube> irradianceMap = TextureCube::Create(params);
-    s_EnvIrradianceShader->Bind();
-    envFiltered->Bind();
-    Renderer::Submit([irradianceMap]() {
-        glBindImageTexture(0, irradianceMap->GetRendererID(), 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
-        glDispatchCompute(irradianceMap->GetWidth() / 32, irradianceMap->GetHeight() / 32, 6);
-    });
+    m_environmentLoader->Flush();
+    UpdateEnvironmentLoader();
+}
 
-    m_sceneData.EnvironmentData = {envFiltered, irradianceMap};
+void Scene::UpdateEnvironmentLoader()
+{
+    if (!m_environmentLoader)
+        return;
+
+    // 非渐进加载在 Flush 后直接取结果，球谐系数在本帧的渲染队列中读取
+    bool complete = m_environmentLoader->IsComplete() || m_environmentLoader->Update();
+    auto &environment = m_sceneData.EnvironmentData;
+    if (auto radianceMap = m_environmentLoader->GetRadianceMap())
+        environment.RadianceMap = radianceMap;
+    // 新的系数回读之前继续使用之前的环境光
+    auto irradiance = m_environmentLoader->GetIrradiance();
+    if (irradiance && (irradiance->IsReady() || complete))
+        environment.Irradiance = irradiance;
+    if (complete)
+        m_environmentLoader = nullptr;
 }
 
 void Scene::BeginScene()
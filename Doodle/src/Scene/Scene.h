@@ -9,6 +9,7 @@
 #include "ApplicationEvent.h"
 #include "Camera.h"
 #include "EventManager.h"
+#include "IrradianceSH.h"
 #include "Light.h"
 #include "UUID.h"
 #include "UniformBuffer.h"
@@ -54,7 +55,7 @@ struct CameraData
 struct EnvironmentData
 {
     std::shared_ptr<TextureCube> RadianceMap;
-    std::shared_ptr<TextureCube> IrradianceMap;
+    std::shared_ptr<IrradianceSH> Irradiance;
     float Intensity = 1.0f;
     float Rotation = 0.0f;
 };
@@ -74,6 +75,7 @@ class SceneRenderer;
 class TransformComponent;
 class Model;
 class ModelNode;
+class EnvironmentLoader;
 class DOO_API Scene : public std::enable_shared_from_this<Scene>
 {
     friend class SceneRenderer;
@@ -93,7 +95,8 @@ public:
     void AddEntity(const Entity &entity);
     void RemoveEntity(const UUID &id);
     void DestroyEntity(const Entity &entity);
-    void LoadEnvironment(const std::string &filepath);
+    // 渐进模式下预过滤分摊到之后的帧中，期间使用低质量版本
+    void LoadEnvironment(const std::string &filepath, bool progressive = true);
 
     inline std::string GetName() const
     {
@@ -125,23 +128,39 @@ public:
 
     void UpdateGlobalTransforms();
 
-    Entity CreateEntityFromModel(std::shared_ptr<Model> model);
+    Entity CreateEntityFromModel(std::shared_ptr<Model> model, bool isStatic = false);
+
+    // 静态物体集合、变换或材质发生变化时递增，StaticBatcher 据此重建合批
+    void MarkStaticDirty()
+    {
+        m_staticVersion++;
+    }
+
+    uint32_t GetStaticVersion() const
+    {
+        return m_staticVersion;
+    }
 
 private:
     std::string m_name;
     bool m_active = false;
+    uint32_t m_staticVersion = 0;
+    size_t m_staticMaterialHash = 0;
     std::unordered_map<UUID, Entity> m_entityMap;
     std::unordered_map<UUID, std::vector<BaseComponent *>> m_entityComponents;
     std::unordered_map<UUID, glm::mat4> m_entityGlobalTransforms;
     entt::registry m_registry;
 
     SceneData m_sceneData;
+    std::shared_ptr<EnvironmentLoader> m_environmentLoader;
 
     void OnUpdate();
     void UpdateSceneData();
+    void UpdateEnvironmentLoader();
+    void UpdateStaticMaterials();
     void UpdateGlobalTransformTree(const TransformComponent &parentTransform, bool parentDirty);
 
-    Entity ProcessModelNode(ModelNode node);
+    Entity ProcessModelNode(ModelNode node, bool isStatic);
 };
 
 } // namespace Doodle
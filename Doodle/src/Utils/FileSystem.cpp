@@ -6,6 +6,7 @@
 #endif
 
 #include <format>
+#include <fstream>
 #include <nfd.hpp>
 #include <shellapi.h>
 
@@ -180,6 +181,59 @@ bool FileSystem::OpenExternally(const std::filesystem::path &path)
 #endif
 }
 
+bool FileSystem::WriteBytes(const std::filesystem::path &filepath, const Buffer &buffer)
+{
+    std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        DOO_CORE_ERROR("FileSystem::WriteBytes - could not open file: {}", filepath.string());
+        return false;
+    }
+
+    stream.write(static_cast<const char *>(buffer.Data), static_cast<std::streamsize>(buffer.Size));
+    return stream.good();
+}
+
+bool FileSystem::WriteBytesAtomic(const std::filesystem::path &filepath, const Buffer &buffer)
+{
+    std::filesystem::path tempPath = filepath;
+    tempPath += ".tmp";
+    CreateDirectory(filepath.parent_path());
+    if (!WriteBytes(tempPath, buffer))
+        return false;
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filepath, error);
+    if (error)
+    {
+        DOO_CORE_ERROR("FileSystem::WriteBytesAtomic - could not replace file: {}", filepath.string());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+Buffer FileSystem::ReadBytes(const std::filesystem::path &filepath)
+{
+    Buffer buffer;
+
+    std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return buffer;
+
+    std::streampos end = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+    uint64_t size = end - stream.tellg();
+    if (size == 0)
+        return buffer;
+
+    buffer.Allocate(size);
+    stream.read(static_cast<char *>(buffer.Data), static_cast<std::streamsize>(size));
+    if (!stream)
+        buffer.Release();
+    return buffer;
+}
+
 std::filesystem::path FileSystem::GetUniqueFileName(const std::filesystem::path &filepath)
 {
     if (!FileSystem::Exists(filepath))
@@ -61,6 +61,8 @@ public:
     static bool OpenExternally(const std::filesystem::path &path);
 
     static bool WriteBytes(const std::filesystem::path &filepath, const Buffer &buffer);
+    // 先写临时文件再替换，避免其他进程读到不完整的文件，目录不存在时自动创建
+    static bool WriteBytesAtomic(const std::filesystem::path &filepath, const Buffer &buffer);
     static Buffer ReadBytes(const std::filesystem::path &filepath);
 
     static std::filesystem::path GetUniqueFileName(const std::filesystem::path &filepath);
@@ -0,0 +1,218 @@
+#include "pch.h"
+#include <atomic>
+#include <cstring>
+
+#include "ImageKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DOO_IMAGE_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define DOO_TARGET(features)
+#else
+#include <cpuid.h>
+#define DOO_TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+
+namespace Doodle
+{
+
+struct CPUFeatures
+{
+    bool SSE2 = false;
+    bool SSSE3 = false;
+    bool F16C = false;
+};
+
+static CPUFeatures DetectCPUFeatures()
+{
+    CPUFeatures features;
+#ifdef DOO_IMAGE_KERNELS_X86
+    uint32_t ecx = 0, edx = 0;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    ecx = static_cast<uint32_t>(info[2]);
+    edx = static_cast<uint32_t>(info[3]);
+#else
+    uint32_t eax, ebx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return features;
+#endif
+    features.SSE2 = edx & (1u << 26);
+    features.SSSE3 = ecx & (1u << 9);
+    // F16C 是 VEX 编码的指令，还需要操作系统保存 AVX 寄存器状态
+    if ((ecx & (1u << 27)) && (ecx & (1u << 28)))
+    {
+#ifdef _MSC_VER
+        uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        uint64_t xcr0 = (static_cast<uint64_t>(xcr0High) << 32) | xcr0Low;
+#endif
+        features.F16C = (ecx & (1u << 29)) && (xcr0 & 0x6) == 0x6;
+    }
+#endif
+    return features;
+}
+
+static std::atomic<bool> s_SIMDEnabled = true;
+
+static CPUFeatures GetCPUFeatures()
+{
+    static CPUFeatures s_Features = DetectCPUFeatures();
+    return s_SIMDEnabled.load(std::memory_order_relaxed) ? s_Features : CPUFeatures();
+}
+
+// 与 F16C 逐位一致：就近偶数舍入，超出范围得到无穷，NaN 保留高位载荷并置为 quiet NaN。
+// glm::packHalf1x16 在恰好居中时向上舍入，与硬件结果不同
+static uint16_t FloatToHalf(uint32_t bits)
+{
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7FFFFFFFu;
+    if (magnitude > 0x7F800000u)
+        return static_cast<uint16_t>(sign | 0x7E00u | ((magnitude >> 13) & 0x3FFu));
+    if (magnitude >= 0x47800000u) // 65536 及以上与无穷
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    if (magnitude < 0x38800000u)
+    {
+        // 结果是非规格化数：加上 0.5 让浮点加法按当前舍入模式完成舍入，尾数低位即为结果
+        float value, magic = 0.5f;
+        std::memcpy(&value, &magnitude, sizeof(value));
+        value += magic;
+        uint32_t rounded, magicBits;
+        std::memcpy(&rounded, &value, sizeof(rounded));
+        std::memcpy(&magicBits, &magic, sizeof(magicBits));
+        return static_cast<uint16_t>(sign | (rounded - magicBits));
+    }
+    // 重新偏置指数并就近偶数舍入，进位会自然进入指数，65520 以上得到无穷
+    uint32_t mantissaOdd = (magnitude >> 13) & 1u;
+    magnitude += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+    return static_cast<uint16_t>(sign | (magnitude >> 13));
+}
+
+// 各 SIMD 实现处理能整块处理的部分，返回已处理的数量，剩余部分由标量代码完成
+#ifdef DOO_IMAGE_KERNELS_X86
+DOO_TARGET("avx,f16c") static size_t ConvertFloatToHalfF16C(const float *src, uint16_t *dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), half);
+    }
+    return i;
+}
+
+DOO_TARGET("sse2") static size_t InvertBytesSSE2(uint8_t *data, size_t byteCount, const uint8_t *mask)
+{
+    __m128i invertMask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask));
+    size_t i = 0;
+    for (; i + 16 <= byteCount; i += 16)
+    {
+        auto *block = reinterpret_cast<__m128i *>(data + i);
+        _mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), invertMask));
+    }
+    return i;
+}
+
+DOO_TARGET("ssse3")
+static size_t SwizzleRGBA8SSSE3(const uint8_t *src, uint8_t *dst, const int32_t *channelMap, size_t pixelCount)
+{
+    uint8_t shuffle[16], ones[16];
+    for (uint32_t b = 0; b < 16; b++)
+    {
+        int32_t channel = channelMap[b % 4];
+        shuffle[b] = channel >= 0 ? static_cast<uint8_t>(b / 4 * 4 + channel) : 0x80;
+        ones[b] = channel == ImageKernels::SWIZZLE_ONE ? 0xFF : 0x00;
+    }
+    __m128i shuffleMask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle));
+    __m128i onesMask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ones));
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffleMask), onesMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), pixels);
+    }
+    return i;
+}
+#endif
+
+void ImageKernels::SetSIMDEnabled(bool enabled)
+{
+    s_SIMDEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ImageKernels::IsSIMDEnabled()
+{
+    return s_SIMDEnabled.load(std::memory_order_relaxed);
+}
+
+void ImageKernels::ConvertFloatToHalf(const float *src, uint16_t *dst, size_t count)
+{
+    size_t i = 0;
+#ifdef DOO_IMAGE_KERNELS_X86
+    if (GetCPUFeatures().F16C)
+        i = ConvertFloatToHalfF16C(src, dst, count);
+#endif
+    // 原地转换时 src 与 dst 重叠，用 memcpy 读写避免别名问题
+    for (; i < count; i++)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, src + i, sizeof(bits));
+        uint16_t half = FloatToHalf(bits);
+        std::memcpy(dst + i, &half, sizeof(half));
+    }
+}
+
+void ImageKernels::InvertChannels(uint8_t *data, size_t pixelCount, uint32_t channelCount, uint32_t invertCount)
+{
+    invertCount = std::min(invertCount, channelCount);
+    if (invertCount == 0)
+        return;
+
+    size_t byteCount = pixelCount * channelCount;
+    size_t i = 0;
+#ifdef DOO_IMAGE_KERNELS_X86
+    // 全部通道反转，或通道数能整除 16 时，16 字节的异或掩码在每次迭代中相同
+    bool allChannels = invertCount == channelCount;
+    if (GetCPUFeatures().SSE2 && (allChannels || 16 % channelCount == 0))
+    {
+        uint8_t mask[16];
+        for (uint32_t b = 0; b < 16; b++)
+            mask[b] = allChannels || b % channelCount < invertCount ? 0xFF : 0x00;
+        i = InvertBytesSSE2(data, byteCount, mask);
+    }
+#endif
+    for (; i < byteCount; i++)
+    {
+        if (i % channelCount < invertCount)
+            data[i] = 255 - data[i];
+    }
+}
+
+void ImageKernels::SwizzleChannels(const uint8_t *src, uint32_t srcChannelCount, uint8_t *dst,
+                                   uint32_t dstChannelCount, const int32_t *channelMap, size_t pixelCount)
+{
+    size_t i = 0;
+#ifdef DOO_IMAGE_KERNELS_X86
+    if (GetCPUFeatures().SSSE3 && srcChannelCount == 4 && dstChannelCount == 4)
+        i = SwizzleRGBA8SSSE3(src, dst, channelMap, pixelCount);
+#endif
+    for (; i < pixelCount; i++)
+    {
+        uint8_t pixel[4];
+        for (uint32_t c = 0; c < dstChannelCount; c++)
+        {
+            int32_t channel = channelMap[c];
+            pixel[c] = channel >= 0 ? src[i * srcChannelCount + channel] : channel == SWIZZLE_ONE ? 255 : 0;
+        }
+        std::memcpy(dst + i * dstChannelCount, pixel, dstChannelCount);
+    }
+}
+
+} // namespace Doodle
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "pch.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Doodle
+{
+
+// CPU 上的逐像素图像处理，启动时按 CPU 特性选择 SIMD 实现（SSE2/SSSE3/F16C），不支持时退回标量实现
+class DOO_API ImageKernels
+{
+public:
+    static constexpr int32_t SWIZZLE_ZERO = -1;
+    static constexpr int32_t SWIZZLE_ONE = -2;
+
+    // 关闭后全部走标量实现，用于核对 SIMD 实现的结果与测量加速比
+    static void SetSIMDEnabled(bool enabled);
+    static bool IsSIMDEnabled();
+
+    // 32 位浮点转半精度，dst 可以与 src 指向同一块内存（原地转换）
+    static void ConvertFloatToHalf(const float *src, uint16_t *dst, size_t count);
+
+    // 原地反转每个像素的前 invertCount 个通道
+    static void InvertChannels(uint8_t *data, size_t pixelCount, uint32_t channelCount, uint32_t invertCount);
+
+    // dst 的第 c 个通道取 src 的第 channelMap[c] 个通道，或 SWIZZLE_ZERO/SWIZZLE_ONE 常量；
+    // dst 的通道数不多于 src 时可以原地处理
+    static void SwizzleChannels(const uint8_t *src, uint32_t srcChannelCount, uint8_t *dst, uint32_t dstChannelCount,
+                                const int32_t *channelMap, size_t pixelCount);
+};
+
+} // namespace Doodle
@@ -0,0 +1,96 @@
+#include "pch.h"
+
+#ifndef DOO_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+namespace Doodle
+{
+
+#ifdef DOO_PLATFORM_WINDOWS
+
+MappedFile::MappedFile(const std::filesystem::path &filepath)
+{
+    m_file = CreateFileW(filepath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        DOO_CORE_ERROR("MappedFile - could not open file: {}", filepath.string());
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+    {
+        DOO_CORE_ERROR("MappedFile - empty or unreadable file: {}", filepath.string());
+        return;
+    }
+
+    m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        DOO_CORE_ERROR("MappedFile - could not map file: {}", filepath.string());
+        return;
+    }
+
+    m_data = static_cast<const std::byte *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data)
+        m_size = static_cast<uint64_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path &filepath)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        DOO_CORE_ERROR("MappedFile - could not open file: {}", filepath.string());
+        return;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0)
+    {
+        DOO_CORE_ERROR("MappedFile - empty or unreadable file: {}", filepath.string());
+        close(fd);
+        return;
+    }
+
+    // 映射建立后即可关闭文件描述符
+    void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        DOO_CORE_ERROR("MappedFile - could not map file: {}", filepath.string());
+        return;
+    }
+
+    m_data = static_cast<const std::byte *>(data);
+    m_size = static_cast<uint64_t>(status.st_size);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data)
+        munmap(const_cast<std::byte *>(m_data), m_size);
+}
+
+#endif
+
+} // namespace Doodle
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "pch.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Doodle
+{
+
+// 只读的内存映射文件，数据由操作系统按需分页载入，析构时解除映射
+class DOO_API MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path &filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const std::byte *GetData() const
+    {
+        return m_data;
+    }
+
+    uint64_t GetSize() const
+    {
+        return m_size;
+    }
+
+    operator bool() const
+    {
+        return m_data != nullptr;
+    }
+
+private:
+    const std::byte *m_data = nullptr;
+    uint64_t m_size = 0;
+#ifdef DOO_PLATFORM_WINDOWS
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+} // namespace Doodle
@@ -104,4 +104,30 @@ glm::mat4 RemoveScaling(const glm::mat4 &modelMatrix)
     return noScaleMatrix;
 }
 
+BoundingBox BoundingBox::Transform(const glm::mat4 &transform) const
+{
+    if (!IsValid())
+        return *this;
+
+    glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+    glm::vec3 extents = GetExtents();
+    glm::mat3 absolute = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])),
+                                   glm::abs(glm::vec3(transform[2])));
+    glm::vec3 newExtents = absolute * extents;
+    return BoundingBox(center - newExtents, center + newExtents);
+}
+
+BoundingSphere BoundingSphere::FromBox(const BoundingBox &box, const glm::mat4 &transform)
+{
+    BoundingSphere sphere;
+    if (!box.IsValid())
+        return sphere;
+
+    float scale = glm::max(glm::max(glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1]))),
+                           glm::length(glm::vec3(transform[2])));
+    sphere.Center = glm::vec3(transform * glm::vec4(box.GetCenter(), 1.0f));
+    sphere.Radius = glm::length(box.GetExtents()) * scale;
+    return sphere;
+}
+
 } // namespace Doodle
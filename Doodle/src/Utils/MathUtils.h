@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pch.h"
+#include <cfloat>
 #include <glm/glm.hpp>
 
 namespace Doodle
@@ -10,4 +11,55 @@ bool DecomposeTransform(const glm::mat4 &transform, glm::vec3 &outTranslation, g
                         glm::vec3 &outScale);
 
 glm::mat4 RemoveScaling(const glm::mat4 &modelMatrix);
-}
\ No newline at end of file
+
+struct BoundingBox
+{
+    glm::vec3 Min = glm::vec3(FLT_MAX);
+    glm::vec3 Max = glm::vec3(-FLT_MAX);
+
+    BoundingBox() = default;
+    BoundingBox(const glm::vec3 &min, const glm::vec3 &max) : Min(min), Max(max)
+    {
+    }
+
+    bool IsValid() const
+    {
+        return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+    }
+
+    void Expand(const glm::vec3 &point)
+    {
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    void Expand(const BoundingBox &other)
+    {
+        Min = glm::min(Min, other.Min);
+        Max = glm::max(Max, other.Max);
+    }
+
+    glm::vec3 GetCenter() const
+    {
+        return (Min + Max) * 0.5f;
+    }
+
+    glm::vec3 GetExtents() const
+    {
+        return (Max - Min) * 0.5f;
+    }
+
+    // 变换后的轴对齐包围盒
+    BoundingBox Transform(const glm::mat4 &transform) const;
+};
+
+struct BoundingSphere
+{
+    glm::vec3 Center = glm::vec3(0.0f);
+    float Radius = 0.0f;
+
+    // 由局部包围盒和变换矩阵得到世界空间的包围球，半径按最大轴缩放
+    static BoundingSphere FromBox(const BoundingBox &box, const glm::mat4 &transform);
+};
+
+} // namespace Doodle
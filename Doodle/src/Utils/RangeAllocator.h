@@ -0,0 +1,93 @@
+#pragma once
+
+#include "pch.h"
+#include <cstdint>
+#include <map>
+
+namespace Doodle
+{
+
+// 管理一段连续区间（顶点、索引等）的首次适配分配器，只记录偏移，不持有实际内存
+class RangeAllocator
+{
+public:
+    static constexpr uint32_t INVALID_OFFSET = UINT32_MAX;
+
+    RangeAllocator() = default;
+    explicit RangeAllocator(uint32_t capacity)
+    {
+        Grow(capacity);
+    }
+
+    uint32_t Allocate(uint32_t count)
+    {
+        if (count == 0)
+            return INVALID_OFFSET;
+
+        for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+        {
+            auto [offset, size] = *it;
+            if (size < count)
+                continue;
+
+            m_freeRanges.erase(it);
+            if (size > count)
+                m_freeRanges[offset + count] = size - count;
+            m_used += count;
+            return offset;
+        }
+        return INVALID_OFFSET;
+    }
+
+    void Free(uint32_t offset, uint32_t count)
+    {
+        if (offset == INVALID_OFFSET || count == 0)
+            return;
+
+        m_used -= count;
+        auto next = m_freeRanges.lower_bound(offset);
+        if (next != m_freeRanges.end() && offset + count == next->first)
+        {
+            count += next->second;
+            next = m_freeRanges.erase(next);
+        }
+        if (next != m_freeRanges.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                prev->second += count;
+                return;
+            }
+        }
+        m_freeRanges[offset] = count;
+    }
+
+    void Grow(uint32_t capacity)
+    {
+        if (capacity <= m_capacity)
+            return;
+
+        uint32_t oldCapacity = m_capacity;
+        m_capacity = capacity;
+        m_used += capacity - oldCapacity;
+        Free(oldCapacity, capacity - oldCapacity);
+    }
+
+    uint32_t GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    uint32_t GetUsed() const
+    {
+        return m_used;
+    }
+
+private:
+    std::map<uint32_t, uint32_t> m_freeRanges;
+    uint32_t m_capacity = 0;
+    uint32_t m_used = 0;
+};
+
+} // namespace Doodle
@@ -0,0 +1,56 @@
+#include "pch.h"
+
+#include "ThreadPool.h"
+
+namespace Doodle
+{
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+        m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto &thread : m_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            // 析构时丢弃尚未开始的任务
+            if (m_stopping)
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+} // namespace Doodle
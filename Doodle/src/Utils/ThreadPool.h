@@ -0,0 +1,49 @@
+#pragma once
+
+#include "pch.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Doodle
+{
+
+// 固定数量工作线程的任务队列，任务不得调用 GL，结果需要交回主线程处理
+class DOO_API ThreadPool
+{
+public:
+    // 默认保留一个核心给主线程
+    explicit ThreadPool(uint32_t threadCount = GetDefaultThreadCount());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void Enqueue(std::function<void()> task);
+
+    uint32_t GetThreadCount() const
+    {
+        return static_cast<uint32_t>(m_threads.size());
+    }
+
+    static uint32_t GetDefaultThreadCount()
+    {
+        uint32_t concurrency = std::thread::hardware_concurrency();
+        return concurrency > 1 ? concurrency - 1 : 1;
+    }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+};
+
+} // namespace Doodle
@@ -1,5 +1,6 @@
 #include "Utils.h"
 #include "Log.h"
+#include "TextureParams.h"
 
 std::string NormalizePath(const std::string &path)
 {
@@ -61,3 +62,23 @@ DOO_API std::string GetDirectory(const std::string &path)
     size_t lastindex = path.find_last_of("/\\");
     return path.substr(0, lastindex);
 }
+
+DOO_API uint64_t HashFileStamp(const std::filesystem::path &filepath)
+{
+    std::error_code error;
+    uint64_t fileSize = std::filesystem::file_size(filepath, error);
+    uint64_t writeTime = 0;
+    if (!error)
+        writeTime = std::filesystem::last_write_time(filepath, error).time_since_epoch().count();
+
+    std::string path = std::filesystem::absolute(filepath).lexically_normal().generic_string();
+    uint64_t stamp[] = {fileSize, writeTime};
+    return HashBytes(stamp, sizeof(stamp), HashBytes(path.data(), path.size()));
+}
+
+DOO_API std::string GetTextureKey(const std::string &path, const Doodle::TextureParams &params)
+{
+    return fmt::format("{}|{}|{}|{}|{}|{}|{}|{}", path, static_cast<int>(params.Format),
+                       static_cast<int>(params.Wrap), static_cast<int>(params.Filter), params.InvertColor,
+                       params.SourceChannel, static_cast<int>(params.Compression), params.Streamable);
+}
@@ -3,9 +3,33 @@
 #include "Core.h"
 #include "pch.h"
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+namespace Doodle
+{
+struct TextureParams;
+} // namespace Doodle
 
 DOO_API std::string NormalizePath(const std::string &path);
 DOO_API std::string FormatTimePoint(const std::chrono::time_point<std::chrono::system_clock> &tp);
 DOO_API void PrintBinary(const void *ptr, size_t size);
 DOO_API std::string RemoveExtension(const std::string &filename);
-DOO_API std::string GetDirectory(const std::string &path);
\ No newline at end of file
+DOO_API std::string GetDirectory(const std::string &path);
+
+// FNV-1a，用于磁盘缓存的文件名等需要跨进程稳定的哈希
+inline uint64_t HashBytes(const void *data, uint64_t size, uint64_t hash = 14695981039346656037ull)
+{
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (uint64_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 按规范化的绝对路径、文件大小与修改时间哈希，源文件变化时结果随之变化，不需要读取文件内容
+DOO_API uint64_t HashFileStamp(const std::filesystem::path &filepath);
+// 纹理在进程内缓存中的键，路径与影响导入结果的参数都参与
+DOO_API std::string GetTextureKey(const std::string &path, const Doodle::TextureParams &params);
@@ -0,0 +1,62 @@
+#type vertex
+#version 450
+
+layout(location = 0) in vec3 a_PositionOS;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    gl_Position = vec4(a_PositionOS, 1.0);
+    v_TexCoord = (a_PositionOS.xy + 1.0) / 2.0;
+}
+
+#type fragment
+#version 450
+#extension GL_ARB_bindless_texture : require
+
+layout(location = 0) out vec4 FinalColor;
+
+in vec2 v_TexCoord;
+
+// 半分辨率输入，r: AO, g: 线性深度
+layout(binding = 0) uniform sampler2D u_Texture;
+
+uniform sampler2D u_GDepth;
+uniform mat4 u_InverseProjection;
+uniform vec2 u_Direction;          // 分离滤波的方向，(1, 0) 或 (0, 1)
+uniform bool u_Upsample;           // 为 true 时输出到全分辨率，中心深度取自 G-Buffer
+uniform float u_SpatialSigma = 2.0;
+uniform float u_DepthSigma = 0.1;  // 相对深度差的标准差
+uniform int u_FilterRadius = 3;
+
+float LinearizeDepth(float depth)
+{
+    vec4 viewPos = u_InverseProjection * vec4(0.0, 0.0, depth * 2.0 - 1.0, 1.0);
+    return -viewPos.z / viewPos.w;
+}
+
+void main()
+{
+    vec2 texelSize = 1.0 / textureSize(u_Texture, 0);
+    float centerDepth = u_Upsample ? LinearizeDepth(texture(u_GDepth, v_TexCoord).r)
+                                   : texture(u_Texture, v_TexCoord).g;
+
+    float weightSum = 0.0;
+    float aoSum = 0.0;
+    for (int i = -u_FilterRadius; i <= u_FilterRadius; ++i)
+    {
+        vec2 sampleAO = texture(u_Texture, v_TexCoord + u_Direction * texelSize * float(i)).rg;
+
+        float spatialWeight = exp(-float(i * i) / (2.0 * u_SpatialSigma * u_SpatialSigma));
+        float depthDistance = (sampleAO.g - centerDepth) / max(centerDepth, 1e-4);
+        float depthWeight = exp(-(depthDistance * depthDistance) / (2.0 * u_DepthSigma * u_DepthSigma));
+
+        float weight = spatialWeight * depthWeight;
+        aoSum += sampleAO.r * weight;
+        weightSum += weight;
+    }
+
+    float ao = weightSum > 0.0 ? aoSum / weightSum : texture(u_Texture, v_TexCoord).r;
+    FinalColor = u_Upsample ? vec4(vec3(ao), 1.0) : vec4(ao, centerDepth, 0.0, 1.0);
+}
@@ -22,7 +22,7 @@ layout(binding = 0) uniform sampler2D u_Texture;
 
 uniform float u_BloomStrength = 0.04f;
 uniform float u_Exposure = 1.0f;
-uniform sampler2D u_BloomTexture;
+layout(binding = 1) uniform sampler2D u_BloomTexture;
 
 vec3 FilmicToneMapping(vec3 color) {
     color *= u_Exposure;
@@ -34,7 +34,7 @@ vec3 FilmicToneMapping(vec3 color) {
 void main()
 {
     vec3 color = texture(u_Texture, v_TexCoord).rgb;
-    vec3 bloom = texture(u_BloomTexture, v_TexCoord).rgb;
+    vec3 bloom = textureLod(u_BloomTexture, v_TexCoord, 0.0).rgb;
     color = mix(color, bloom, vec3(u_BloomStrength));
     color = FilmicToneMapping(color);
     FinalColor = vec4(color, 1.0);
@@ -0,0 +1,59 @@
+#type compute
+#version 450
+#extension GL_ARB_bindless_texture : require
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(rgba16f, binding = 0) uniform writeonly image2D u_Destination;
+
+layout(binding = 1) uniform sampler2D u_MipChain;
+uniform sampler2D u_SourceTexture; // 第一级降采样的输入，即场景颜色
+uniform bool u_FromSource;
+uniform int u_SourceLod;
+
+vec3 Sample(vec2 texCoord)
+{
+	if (u_FromSource)
+		return textureLod(u_SourceTexture, texCoord, 0.0).rgb;
+	return textureLod(u_MipChain, texCoord, float(u_SourceLod)).rgb;
+}
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 size = imageSize(u_Destination);
+	if (any(greaterThanEqual(texel, size)))
+		return;
+
+	vec2 texCoord = (vec2(texel) + 0.5) / vec2(size);
+	vec2 texelSize = 1.0 / vec2(u_FromSource ? textureSize(u_SourceTexture, 0) : textureSize(u_MipChain, u_SourceLod));
+	float x = texelSize.x;
+	float y = texelSize.y;
+
+	// 13 次采样，e 为当前像素
+	// a - b - c
+	// - j - k -
+	// d - e - f
+	// - l - m -
+	// g - h - i
+	vec3 a = Sample(texCoord + vec2(-2 * x, 2 * y));
+	vec3 b = Sample(texCoord + vec2(0, 2 * y));
+	vec3 c = Sample(texCoord + vec2(2 * x, 2 * y));
+	vec3 d = Sample(texCoord + vec2(-2 * x, 0));
+	vec3 e = Sample(texCoord);
+	vec3 f = Sample(texCoord + vec2(2 * x, 0));
+	vec3 g = Sample(texCoord + vec2(-2 * x, -2 * y));
+	vec3 h = Sample(texCoord + vec2(0, -2 * y));
+	vec3 i = Sample(texCoord + vec2(2 * x, -2 * y));
+	vec3 j = Sample(texCoord + vec2(-x, y));
+	vec3 k = Sample(texCoord + vec2(x, y));
+	vec3 l = Sample(texCoord + vec2(-x, -y));
+	vec3 m = Sample(texCoord + vec2(x, -y));
+
+	vec3 color = e * 0.125;
+	color += (a + c + g + i) * 0.03125;
+	color += (b + d + f + h) * 0.0625;
+	color += (j + k + l + m) * 0.125;
+	color = max(color, vec3(0.0001f));
+	imageStore(u_Destination, texel, vec4(color, 1.0));
+}
@@ -0,0 +1,46 @@
+#type compute
+#version 450
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+// 上一级 mip 的结果累加到当前级
+layout(rgba16f, binding = 0) uniform image2D u_Destination;
+
+layout(binding = 1) uniform sampler2D u_MipChain;
+uniform int u_SourceLod;
+uniform float u_FilterRadius;
+
+void main()
+{
+	ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 size = imageSize(u_Destination);
+	if (any(greaterThanEqual(texel, size)))
+		return;
+
+	vec2 texCoord = (vec2(texel) + 0.5) / vec2(size);
+	float x = u_FilterRadius;
+	float y = u_FilterRadius;
+	float lod = float(u_SourceLod);
+
+	// 3x3 帐篷滤波，e 为当前像素
+	// a - b - c
+	// d - e - f
+	// g - h - i
+	vec3 a = textureLod(u_MipChain, texCoord + vec2(-x, y), lod).rgb;
+	vec3 b = textureLod(u_MipChain, texCoord + vec2(0, y), lod).rgb;
+	vec3 c = textureLod(u_MipChain, texCoord + vec2(x, y), lod).rgb;
+	vec3 d = textureLod(u_MipChain, texCoord + vec2(-x, 0), lod).rgb;
+	vec3 e = textureLod(u_MipChain, texCoord, lod).rgb;
+	vec3 f = textureLod(u_MipChain, texCoord + vec2(x, 0), lod).rgb;
+	vec3 g = textureLod(u_MipChain, texCoord + vec2(-x, -y), lod).rgb;
+	vec3 h = textureLod(u_MipChain, texCoord + vec2(0, -y), lod).rgb;
+	vec3 i = textureLod(u_MipChain, texCoord + vec2(x, -y), lod).rgb;
+
+	vec3 color = e * 4.0;
+	color += (b + d + f + h) * 2.0;
+	color += (a + c + g + i);
+	color *= 1.0 / 16.0;
+
+	vec3 destination = imageLoad(u_Destination, texel).rgb;
+	imageStore(u_Destination, texel, vec4(destination + color, 1.0));
+}
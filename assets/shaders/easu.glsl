@@ -0,0 +1,131 @@
+#type vertex
+#version 450
+
+layout(location = 0) in vec3 a_PositionOS;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	gl_Position = vec4(a_PositionOS, 1.0);
+    v_TexCoord = (a_PositionOS.xy + 1.0) / 2.0;
+}
+
+#type fragment
+#version 450
+
+// 边缘自适应的空间上采样（EASU）：根据 12 个输入样本估计局部边缘方向与强度，
+// 沿边缘拉伸的近似 Lanczos2 核重建输出像素，并用最近 2x2 样本的范围去振铃
+
+layout(location = 0) out vec4 FinalColor;
+
+in vec2 v_TexCoord;
+
+layout(binding = 0) uniform sampler2D u_Texture; // 渲染分辨率的场景颜色
+
+float Luma(vec3 color)
+{
+    return dot(color, vec3(0.5, 1.0, 0.5));
+}
+
+vec3 FetchColor(ivec2 texel)
+{
+    ivec2 maxTexel = textureSize(u_Texture, 0) - 1;
+    return texelFetch(u_Texture, clamp(texel, ivec2(0), maxTexel), 0).rgb;
+}
+
+// 以 center 为中心的样本对方向和边缘强度的贡献，按双线性权重累加
+void AccumulateDirection(inout vec2 dir, inout float len, float weight, float left, float center, float right,
+                         float top, float bottom)
+{
+    float dirX = right - left;
+    float lenX = clamp(abs(dirX) / max(max(abs(center - left), abs(right - center)), 1e-5), 0.0, 1.0);
+    float dirY = bottom - top;
+    float lenY = clamp(abs(dirY) / max(max(abs(center - top), abs(bottom - center)), 1e-5), 0.0, 1.0);
+    dir += vec2(dirX, dirY) * weight;
+    len += (lenX * lenX + lenY * lenY) * weight;
+}
+
+void AccumulateTap(inout vec3 colorSum, inout float weightSum, vec2 offset, vec2 dir, vec2 len2, float lobe,
+                   float clipDistance, vec3 color)
+{
+    vec2 v = vec2(dot(offset, dir), dot(offset, vec2(-dir.y, dir.x))) * len2;
+    float d2 = min(dot(v, v), clipDistance);
+    // Lanczos2 的多项式近似：[25/16 * (2/5 * x^2 - 1)^2 - (25/16 - 1)] * (lobe * x^2 - 1)^2
+    float windowWeight = 2.0 / 5.0 * d2 - 1.0;
+    float baseWeight = lobe * d2 - 1.0;
+    windowWeight *= windowWeight;
+    baseWeight *= baseWeight;
+    windowWeight = 25.0 / 16.0 * windowWeight - (25.0 / 16.0 - 1.0);
+    float weight = windowWeight * baseWeight;
+    colorSum += color * weight;
+    weightSum += weight;
+}
+
+void main()
+{
+    vec2 inputSize = vec2(textureSize(u_Texture, 0));
+    vec2 pp = v_TexCoord * inputSize - 0.5;
+    vec2 fp = floor(pp);
+    pp -= fp;
+    ivec2 base = ivec2(fp);
+
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    vec3 b = FetchColor(base + ivec2(0, -1));
+    vec3 c = FetchColor(base + ivec2(1, -1));
+    vec3 e = FetchColor(base + ivec2(-1, 0));
+    vec3 f = FetchColor(base + ivec2(0, 0));
+    vec3 g = FetchColor(base + ivec2(1, 0));
+    vec3 h = FetchColor(base + ivec2(2, 0));
+    vec3 i = FetchColor(base + ivec2(-1, 1));
+    vec3 j = FetchColor(base + ivec2(0, 1));
+    vec3 k = FetchColor(base + ivec2(1, 1));
+    vec3 l = FetchColor(base + ivec2(2, 1));
+    vec3 n = FetchColor(base + ivec2(0, 2));
+    vec3 o = FetchColor(base + ivec2(1, 2));
+
+    float bL = Luma(b), cL = Luma(c), eL = Luma(e), fL = Luma(f), gL = Luma(g), hL = Luma(h);
+    float iL = Luma(i), jL = Luma(j), kL = Luma(k), lL = Luma(l), nL = Luma(n), oL = Luma(o);
+
+    vec2 dir = vec2(0.0);
+    float len = 0.0;
+    AccumulateDirection(dir, len, (1.0 - pp.x) * (1.0 - pp.y), eL, fL, gL, bL, jL);
+    AccumulateDirection(dir, len, pp.x * (1.0 - pp.y), fL, gL, hL, cL, kL);
+    AccumulateDirection(dir, len, (1.0 - pp.x) * pp.y, iL, jL, kL, fL, nL);
+    AccumulateDirection(dir, len, pp.x * pp.y, jL, kL, lL, gL, oL);
+
+    // 方向过弱时退化为水平方向，此时核接近各向同性
+    float dirLength = dot(dir, dir);
+    dir = dirLength < 1.0 / 32768.0 ? vec2(1.0, 0.0) : dir * inversesqrt(dirLength);
+
+    // 边缘越强，核沿边缘方向拉伸得越长、越锐利
+    len = len * 0.5;
+    len *= len;
+    float stretch = 1.0 / max(abs(dir.x), abs(dir.y));
+    vec2 len2 = vec2(1.0 + (stretch - 1.0) * len, 1.0 - 0.5 * len);
+    float lobe = 0.5 + (1.0 / 4.0 - 0.04 - 0.5) * len;
+    float clipDistance = 1.0 / lobe;
+
+    vec3 colorSum = vec3(0.0);
+    float weightSum = 0.0;
+    AccumulateTap(colorSum, weightSum, vec2(0.0, -1.0) - pp, dir, len2, lobe, clipDistance, b);
+    AccumulateTap(colorSum, weightSum, vec2(1.0, -1.0) - pp, dir, len2, lobe, clipDistance, c);
+    AccumulateTap(colorSum, weightSum, vec2(-1.0, 1.0) - pp, dir, len2, lobe, clipDistance, i);
+    AccumulateTap(colorSum, weightSum, vec2(0.0, 1.0) - pp, dir, len2, lobe, clipDistance, j);
+    AccumulateTap(colorSum, weightSum, vec2(0.0, 0.0) - pp, dir, len2, lobe, clipDistance, f);
+    AccumulateTap(colorSum, weightSum, vec2(-1.0, 0.0) - pp, dir, len2, lobe, clipDistance, e);
+    AccumulateTap(colorSum, weightSum, vec2(1.0, 1.0) - pp, dir, len2, lobe, clipDistance, k);
+    AccumulateTap(colorSum, weightSum, vec2(2.0, 1.0) - pp, dir, len2, lobe, clipDistance, l);
+    AccumulateTap(colorSum, weightSum, vec2(2.0, 0.0) - pp, dir, len2, lobe, clipDistance, h);
+    AccumulateTap(colorSum, weightSum, vec2(1.0, 0.0) - pp, dir, len2, lobe, clipDistance, g);
+    AccumulateTap(colorSum, weightSum, vec2(1.0, 2.0) - pp, dir, len2, lobe, clipDistance, o);
+    AccumulateTap(colorSum, weightSum, vec2(0.0, 2.0) - pp, dir, len2, lobe, clipDistance, n);
+
+    vec3 minColor = min(min(f, g), min(j, k));
+    vec3 maxColor = max(max(f, g), max(j, k));
+    vec3 color = clamp(colorSum / max(weightSum, 1e-5), minColor, maxColor);
+    FinalColor = vec4(color, 1.0);
+}
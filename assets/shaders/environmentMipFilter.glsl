@@ -19,6 +19,8 @@ layout(binding = 0, rgba16f) restrict writeonly uniform imageCube outputTexture[
 
 // Roughness value to pre-filter for.
 layout(location=0) uniform float roughness;
+// 分帧预过滤时本次调度的起始 texel 与面
+layout(location=1) uniform ivec3 u_Offset = ivec3(0);
 
 #define PARAM_LEVEL     0
 #define PARAM_ROUGHNESS roughness
@@ -67,18 +69,18 @@ float ndfGGX(float cosLh, float roughness)
 	return alphaSq / (PI * denom * denom);
 }
 
-vec3 GetCubeMapTexCoord()
+vec3 GetCubeMapTexCoord(ivec3 id)
 {
-    vec2 st = gl_GlobalInvocationID.xy / vec2(imageSize(outputTexture[PARAM_LEVEL]));
+    vec2 st = id.xy / vec2(imageSize(outputTexture[PARAM_LEVEL]));
     vec2 uv = 2.0 * vec2(st.x, 1.0 - st.y) - vec2(1.0);
 
     vec3 ret;
-    if (gl_GlobalInvocationID.z == 0)      ret = vec3(  1.0, uv.y, -uv.x);
-    else if (gl_GlobalInvocationID.z == 1) ret = vec3( -1.0, uv.y,  uv.x);
-    else if (gl_GlobalInvocationID.z == 2) ret = vec3( uv.x,  1.0, -uv.y);
-    else if (gl_GlobalInvocationID.z == 3) ret = vec3( uv.x, -1.0,  uv.y);
-    else if (gl_GlobalInvocationID.z == 4) ret = vec3( uv.x, uv.y,   1.0);
-    else if (gl_GlobalInvocationID.z == 5) ret = vec3(-uv.x, uv.y,  -1.0);
+    if (id.z == 0)      ret = vec3(  1.0, uv.y, -uv.x);
+    else if (id.z == 1) ret = vec3( -1.0, uv.y,  uv.x);
+    else if (id.z == 2) ret = vec3( uv.x,  1.0, -uv.y);
+    else if (id.z == 3) ret = vec3( uv.x, -1.0,  uv.y);
+    else if (id.z == 4) ret = vec3( uv.x, uv.y,   1.0);
+    else if (id.z == 5) ret = vec3(-uv.x, uv.y,  -1.0);
     return normalize(ret);
 }
 
@@ -102,9 +104,11 @@ vec3 tangentToWorld(const vec3 v, const vec3 N, const vec3 S, const vec3 T)
 layout(local_size_x=32, local_size_y=32, local_size_z=1) in;
 void main(void)
 {
+	ivec3 id = ivec3(gl_GlobalInvocationID) + u_Offset;
+
 	// Make sure we won't write past output when computing higher mipmap levels.
 	ivec2 outputSize = imageSize(outputTexture[PARAM_LEVEL]);
-	if(gl_GlobalInvocationID.x >= outputSize.x || gl_GlobalInvocationID.y >= outputSize.y) {
+	if(id.x >= outputSize.x || id.y >= outputSize.y) {
 		return;
 	}
 	
@@ -114,7 +118,7 @@ void main(void)
 	float wt = 4.0 * PI / (6 * inputSize.x * inputSize.y);
 	
 	// Approximation: Assume zero viewing angle (isotropic reflections).
-	vec3 N = GetCubeMapTexCoord();
+	vec3 N = GetCubeMapTexCoord(id);
 	vec3 Lo = N;
 	
 	vec3 S, T;
@@ -155,5 +159,5 @@ void main(void)
 	}
 	color /= weight;
 
-	imageStore(outputTexture[PARAM_LEVEL], ivec3(gl_GlobalInvocationID), vec4(color, 1.0));
+	imageStore(outputTexture[PARAM_LEVEL], id, vec4(color, 1.0));
 }
@@ -0,0 +1,96 @@
+#type compute
+#version 450 core
+
+// 把环境辐射度投影到 3 阶球谐（9 个系数）并做余弦卷积。
+// 每个工作组负责立方体贴图的一个面，各面的部分和写入缓冲后在 CPU 上累加
+
+layout(binding=0) uniform samplerCube inputTexture;
+
+layout(std430, binding=6) writeonly buffer SHBuffer
+{
+    vec4 Coefficients[]; // 6 个面 x 9 个系数
+} u_SH;
+
+layout(location=0) uniform float u_SourceLod = 0.0;
+
+const uint GROUP_SIZE = 8u;
+const uint THREAD_COUNT = GROUP_SIZE * GROUP_SIZE;
+
+// 基函数的常数部分，投影与求值各乘一次
+const float SH_BASIS_CONSTANTS[9] = float[](0.282095, 0.488603, 0.488603, 0.488603, 1.092548, 1.092548, 0.315392,
+                                            1.092548, 0.546274);
+// 余弦卷积 A_l 再除以 π，使结果直接是白色漫反射表面的出射辐射度，与原辐照度立方体贴图一致
+const float SH_BAND_FACTORS[9] = float[](1.0, 2.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0, 0.25, 0.25, 0.25, 0.25, 0.25);
+
+shared vec3 s_Sums[THREAD_COUNT][9];
+
+vec3 GetCubeMapDirection(vec2 uv, uint face)
+{
+    uv.y = -uv.y;
+    vec3 ret;
+    if (face == 0)      ret = vec3(  1.0, uv.y, -uv.x);
+    else if (face == 1) ret = vec3( -1.0, uv.y,  uv.x);
+    else if (face == 2) ret = vec3( uv.x,  1.0, -uv.y);
+    else if (face == 3) ret = vec3( uv.x, -1.0,  uv.y);
+    else if (face == 4) ret = vec3( uv.x, uv.y,   1.0);
+    else                ret = vec3(-uv.x, uv.y,  -1.0);
+    return normalize(ret);
+}
+
+layout(local_size_x=8, local_size_y=8, local_size_z=1) in;
+void main(void)
+{
+    uint face = gl_WorkGroupID.z;
+    uint thread = gl_LocalInvocationIndex;
+    int size = textureSize(inputTexture, int(u_SourceLod)).x;
+    float texelSize = 2.0 / float(size);
+
+    vec3 sums[9];
+    for (int i = 0; i < 9; i++)
+        sums[i] = vec3(0.0);
+
+    for (uint y = gl_LocalInvocationID.y; y < size; y += GROUP_SIZE)
+    {
+        for (uint x = gl_LocalInvocationID.x; x < size; x += GROUP_SIZE)
+        {
+            vec2 uv = (vec2(x, y) + 0.5) * texelSize - 1.0;
+            // texel 所占的立体角
+            float solidAngle = texelSize * texelSize / pow(1.0 + dot(uv, uv), 1.5);
+            vec3 d = GetCubeMapDirection(uv, face);
+            vec3 L = textureLod(inputTexture, d, u_SourceLod).rgb * solidAngle;
+
+            sums[0] += L;
+            sums[1] += L * d.y;
+            sums[2] += L * d.z;
+            sums[3] += L * d.x;
+            sums[4] += L * (d.x * d.y);
+            sums[5] += L * (d.y * d.z);
+            sums[6] += L * (3.0 * d.z * d.z - 1.0);
+            sums[7] += L * (d.x * d.z);
+            sums[8] += L * (d.x * d.x - d.y * d.y);
+        }
+    }
+
+    for (int i = 0; i < 9; i++)
+        s_Sums[thread][i] = sums[i];
+    barrier();
+
+    for (uint stride = THREAD_COUNT / 2u; stride > 0u; stride >>= 1u)
+    {
+        if (thread < stride)
+        {
+            for (int i = 0; i < 9; i++)
+                s_Sums[thread][i] += s_Sums[thread + stride][i];
+        }
+        barrier();
+    }
+
+    if (thread == 0u)
+    {
+        for (int i = 0; i < 9; i++)
+        {
+            float scale = SH_BASIS_CONSTANTS[i] * SH_BASIS_CONSTANTS[i] * SH_BAND_FACTORS[i];
+            u_SH.Coefficients[face * 9u + i] = vec4(s_Sums[0][i] * scale, 0.0);
+        }
+    }
+}
@@ -1,10 +1,10 @@
 #type vertex
 #version 450
+#extension GL_ARB_shader_draw_parameters : require
 
 layout(location = 0) in vec3 a_PositionOS;
-layout(location = 1) in vec3 a_NormalOS;
-layout(location = 2) in vec3 a_TangentOS;
-layout(location = 3) in vec3 a_BinormalOS;
+layout(location = 1) in vec2 a_NormalOS;  // 八面体编码
+layout(location = 2) in vec2 a_TangentOS; // 八面体编码，y 的最低位是副切线的符号
 layout(location = 4) in vec2 a_TexCoord;
 
 out Varyings
@@ -14,46 +14,150 @@ out Varyings
     vec3 PositionWS;
     mat3 TBN; 
     vec4 PositionHLS;
+    vec4 CurrentPositionCS;
+    vec4 PreviousPositionCS;
+    flat uint MaterialIndex;
 } vs_out;
 
 uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
-uniform mat4 u_LightSpaceMatrix;
+uniform mat3 u_NormalMatrix = mat3(1.0); // u_Model 的逆转置，由 CPU 计算
+uniform bool u_UseObjectBuffer;
+uniform bool u_UseInstanceBuffer;
+uniform uint u_MaterialID = 0xFFFFFFFFu; // MaterialTable 槽位，无效值表示使用材质统一值
+
+layout(std140, binding = 4) uniform ViewData
+{
+    mat4 View;
+    mat4 Projection;
+    mat4 ViewProjection;
+    mat4 LightSpaceMatrix;
+    float NearPlane;
+    float FarPlane;
+    mat4 UnjitteredViewProjection;
+    mat4 PreviousViewProjection;
+} u_ViewData;
+
+struct ObjectData
+{
+    mat4 Model;
+    mat4 NormalMatrix; // 只用左上 3x3
+    vec4 BoundingSphere;
+    uint MaterialIndex;
+    uint IndexCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint Flags;
+    uint ShadowIndexCount;
+    uint ShadowFirstIndex;
+    uint Padding;
+};
+
+layout(std430, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData u_Objects[];
+};
+
+struct InstanceData
+{
+    mat4 Model;
+    mat4 NormalMatrix; // 只用左上 3x3
+};
+
+layout(std430, binding = 4) readonly buffer InstanceBuffer
+{
+    InstanceData u_Instances[];
+};
+
+mat4 GetModelMatrix()
+{
+    if (u_UseObjectBuffer)
+        return u_Objects[gl_BaseInstanceARB].Model;
+    if (u_UseInstanceBuffer)
+        return u_Instances[gl_BaseInstanceARB + gl_InstanceID].Model;
+    return u_Model;
+}
+
+mat3 GetNormalMatrix()
+{
+    if (u_UseObjectBuffer)
+        return mat3(u_Objects[gl_BaseInstanceARB].NormalMatrix);
+    if (u_UseInstanceBuffer)
+        return mat3(u_Instances[gl_BaseInstanceARB + gl_InstanceID].NormalMatrix);
+    return u_NormalMatrix;
+}
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+    return normalize(v);
+}
 
 void main()
 {
-    gl_Position = u_Projection * u_View * u_Model * vec4(a_PositionOS, 1.0);
+    mat4 model = GetModelMatrix();
+    vs_out.MaterialIndex = u_UseObjectBuffer ? u_Objects[gl_BaseInstanceARB].MaterialIndex : u_MaterialID;
+    gl_Position = u_ViewData.ViewProjection * model * vec4(a_PositionOS, 1.0);
     vs_out.TexCoord = a_TexCoord;
     
+    vec3 normalOS = OctDecode(a_NormalOS);
+    vec3 tangentOS = OctDecode(a_TangentOS);
+    float binormalSign = (int(round(a_TangentOS.y * 32767.0)) & 1) != 0 ? -1.0 : 1.0;
+    vec3 binormalOS = cross(normalOS, tangentOS) * binormalSign;
+
     // Transform normal to world space
-    mat3 normalModel = mat3(transpose(inverse(u_Model))); // TODO 放在CPU端计算
-    vs_out.NormalWS = normalModel * a_NormalOS; 
+    mat3 normalModel = GetNormalMatrix();
+    vs_out.NormalWS = normalModel * normalOS; 
     // Transform position to world space
-    vs_out.PositionWS = vec3(u_Model * vec4(a_PositionOS, 1.0));
+    vs_out.PositionWS = vec3(model * vec4(a_PositionOS, 1.0));
     
     // Compute TBN matrix
-    vec3 T = normalModel * a_TangentOS;
-    vec3 B = normalModel * a_BinormalOS;
+    vec3 T = normalModel * tangentOS;
+    vec3 B = normalModel * binormalOS;
     vs_out.TBN = mat3(T, B, vs_out.NormalWS);
 
     // Calculate light space position
-    vs_out.PositionHLS = u_LightSpaceMatrix * vec4(vs_out.PositionWS, 1.0);
+    vs_out.PositionHLS = u_ViewData.LightSpaceMatrix * vec4(vs_out.PositionWS, 1.0);
+
+    // 只考虑相机运动，运动物体依靠时间上采样的邻域裁剪处理
+    vs_out.CurrentPositionCS = u_ViewData.UnjitteredViewProjection * vec4(vs_out.PositionWS, 1.0);
+    vs_out.PreviousPositionCS = u_ViewData.PreviousViewProjection * vec4(vs_out.PositionWS, 1.0);
 }
 
 #type fragment
 #version 450
+#extension GL_ARB_bindless_texture : require
 
 layout(location = 0) out vec4 gPositionWS;
 layout(location = 1) out vec4 gNormalWS;
+layout(location = 2) out vec4 gMotion;
+
+layout(std140, binding = 4) uniform ViewData
+{
+    mat4 View;
+    mat4 Projection;
+    mat4 ViewProjection;
+    mat4 LightSpaceMatrix;
+    float NearPlane;
+    float FarPlane;
+    mat4 UnjitteredViewProjection;
+    mat4 PreviousViewProjection;
+} u_ViewData;
 
-uniform float u_NearPlane;
-uniform float u_FarPlane;
+// 只使用 xy，z 由单位长度重建，兼容 BC5 双通道法线贴图
+vec3 DecodeNormal(vec4 packedNormal)
+{
+    vec2 xy = packedNormal.xy * 2.0 - 1.0;
+    return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+}
 
 float LinearizeDepth(float depth) // TODO 没有考虑正交相机
 {
     float z = depth * 2.0 - 1.0; // 回到NDC
-    return (2.0 * u_NearPlane * u_FarPlane) / (u_FarPlane + u_NearPlane - z * (u_FarPlane - u_NearPlane));
+    float nearPlane = u_ViewData.NearPlane;
+    float farPlane = u_ViewData.FarPlane;
+    return (2.0 * nearPlane * farPlane) / (farPlane + nearPlane - z * (farPlane - nearPlane));
 }
 
 in Varyings
@@ -63,14 +167,51 @@ in Varyings
     vec3 PositionWS;
     mat3 TBN;
     vec4 PositionHLS;
+    vec4 CurrentPositionCS;
+    vec4 PreviousPositionCS;
+    flat uint MaterialIndex;
 } fs_in;
 
 uniform float u_NormalScale;
 uniform sampler2D u_NormalTexture;
 
+struct MaterialData
+{
+    vec4 AlbedoColor;
+    float Metallic;
+    float Roughness;
+    float NormalScale;
+    float Padding;
+    uvec2 AlbedoTexture;
+    uvec2 NormalTexture;
+    uvec2 MetallicTexture;
+    uvec2 RoughnessTexture;
+};
+
+layout(std430, binding = 1) readonly buffer MaterialBuffer
+{
+    MaterialData u_Materials[];
+};
+
+const uint INVALID_MATERIAL_ID = 0xFFFFFFFFu;
+
 void main()
 {
+    float normalScale = u_NormalScale;
+    sampler2D normalTexture = u_NormalTexture;
+    if (fs_in.MaterialIndex != INVALID_MATERIAL_ID)
+    {
+        MaterialData material = u_Materials[fs_in.MaterialIndex];
+        normalScale = material.NormalScale;
+        normalTexture = sampler2D(material.NormalTexture);
+    }
+
     gPositionWS = vec4(fs_in.PositionWS, LinearizeDepth(gl_FragCoord.z));
-    gNormalWS.xyz = normalize(fs_in.TBN * (texture(u_NormalTexture, fs_in.TexCoord).xyz * 2.0 - 1.0) * u_NormalScale);
+    gNormalWS.xyz = normalize(fs_in.TBN * DecodeNormal(texture(normalTexture, fs_in.TexCoord)) * normalScale);
     gNormalWS.w = 1.0;
+
+    // 屏幕 UV 空间的运动矢量：当前位置减去上一帧位置
+    vec2 currentUV = fs_in.CurrentPositionCS.xy / fs_in.CurrentPositionCS.w * 0.5 + 0.5;
+    vec2 previousUV = fs_in.PreviousPositionCS.xy / fs_in.PreviousPositionCS.w * 0.5 + 0.5;
+    gMotion = vec4(currentUV - previousUV, 0.0, 1.0);
 }
\ No newline at end of file
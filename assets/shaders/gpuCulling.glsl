@@ -0,0 +1,82 @@
+#type compute
+#version 450
+
+layout(local_size_x = 64) in;
+
+struct ObjectData
+{
+	mat4 Model;
+	mat4 NormalMatrix; // 只用左上 3x3
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+	uint IndexCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint Flags;
+	uint ShadowIndexCount;
+	uint ShadowFirstIndex;
+	uint Padding;
+};
+
+struct DrawElementsIndirectCommand
+{
+	uint Count;
+	uint InstanceCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint BaseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer ObjectBuffer
+{
+	ObjectData u_Objects[];
+};
+
+layout(std430, binding = 2) writeonly buffer DrawCommandBuffer
+{
+	DrawElementsIndirectCommand u_DrawCommands[];
+};
+
+layout(std430, binding = 3) buffer DrawCountBuffer
+{
+	uint u_DrawCount;
+};
+
+uniform mat4 u_ViewProjection;
+uniform int u_ObjectCount;
+uniform int u_RequiredFlags;
+uniform bool u_UseShadowLOD;
+
+bool IsSphereVisible(vec4 sphere)
+{
+	mat4 m = transpose(u_ViewProjection);
+	vec4 planes[6] = vec4[6](m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2]);
+	for (int i = 0; i < 6; i++)
+	{
+		vec4 plane = planes[i] / length(planes[i].xyz);
+		if (dot(plane.xyz, sphere.xyz) + plane.w < -sphere.w)
+			return false;
+	}
+	return true;
+}
+
+void main()
+{
+	uint index = gl_GlobalInvocationID.x;
+	if (index >= uint(u_ObjectCount))
+		return;
+
+	ObjectData object = u_Objects[index];
+	uint requiredFlags = uint(u_RequiredFlags);
+	if ((object.Flags & requiredFlags) != requiredFlags)
+		return;
+	if (!IsSphereVisible(object.BoundingSphere))
+		return;
+
+	uint drawIndex = atomicAdd(u_DrawCount, 1u);
+	u_DrawCommands[drawIndex].Count = u_UseShadowLOD ? object.ShadowIndexCount : object.IndexCount;
+	u_DrawCommands[drawIndex].InstanceCount = 1u;
+	u_DrawCommands[drawIndex].FirstIndex = u_UseShadowLOD ? object.ShadowFirstIndex : object.FirstIndex;
+	u_DrawCommands[drawIndex].BaseVertex = object.BaseVertex;
+	u_DrawCommands[drawIndex].BaseInstance = index;
+}
@@ -37,6 +37,7 @@ uniform int u_FrameCounter;
 uniform sampler2D u_NoiseTexture;
 uniform vec2 u_Resolution;
 uniform vec2 u_PixelSize;
+uniform bool u_HalfResolution; // 半分辨率模式：噪声逐帧轮换，并输出线性深度供时间累积与上采样使用
 
 // Common constants
 const float pi           = 3.14159265359;
@@ -276,11 +277,14 @@ void main() {
 #ifdef TAA
     int seed = (u_FrameCounter % 40000) + u_FrameCounter * 2;
 #else
-	int seed = 0;
+	int seed = u_HalfResolution ? u_FrameCounter % 64 : 0;
 #endif
     vec2 r2 = fract(R2_samples(seed) + blueNoise(gl_FragCoord.xy).rg);
 
     float ao = ambient_occlusion(screen_pos, view_pos, view_normal, r2);
 
-    Ao = vec4(vec3(ao), 1.0);
+    if (u_HalfResolution)
+        Ao = vec4(ao, -view_pos.z, 0.0, 1.0);
+    else
+        Ao = vec4(vec3(ao), 1.0);
 }
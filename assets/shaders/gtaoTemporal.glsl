@@ -0,0 +1,79 @@
+#type vertex
+#version 450
+
+layout(location = 0) in vec3 a_PositionOS;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    gl_Position = vec4(a_PositionOS, 1.0);
+    v_TexCoord = (a_PositionOS.xy + 1.0) / 2.0;
+}
+
+#type fragment
+#version 450
+#extension GL_ARB_bindless_texture : require
+
+layout(location = 0) out vec4 FinalColor;
+
+in vec2 v_TexCoord;
+
+// r: 当前帧 AO, g: 线性深度
+layout(binding = 0) uniform sampler2D u_Texture;
+
+uniform sampler2D u_HistoryTexture;
+uniform bool u_HistoryValid;
+uniform mat4 u_InverseProjection;
+uniform mat4 u_InverseView;
+uniform mat4 u_PreviousView;
+uniform mat4 u_PreviousViewProjection;
+uniform float u_TemporalBlend = 0.1; // 当前帧的权重
+uniform float u_DepthThreshold = 0.05; // 重投影深度的相对误差阈值
+
+vec3 ReconstructViewPosition(vec2 uv, float linearDepth)
+{
+    vec4 farPoint = u_InverseProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 ray = farPoint.xyz / farPoint.w;
+    return ray * (linearDepth / -ray.z);
+}
+
+void main()
+{
+    vec2 current = texture(u_Texture, v_TexCoord).rg;
+    if (!u_HistoryValid)
+    {
+        FinalColor = vec4(current, 0.0, 1.0);
+        return;
+    }
+
+    // 用 3x3 邻域的范围约束历史值，减少拖影
+    float aoMin = current.r;
+    float aoMax = current.r;
+    for (int x = -1; x <= 1; ++x)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            float ao = textureOffset(u_Texture, v_TexCoord, ivec2(x, y)).r;
+            aoMin = min(aoMin, ao);
+            aoMax = max(aoMax, ao);
+        }
+    }
+
+    vec3 viewPos = ReconstructViewPosition(v_TexCoord, current.g);
+    vec4 worldPos = u_InverseView * vec4(viewPos, 1.0);
+    vec4 previousClip = u_PreviousViewProjection * worldPos;
+    vec2 previousUV = previousClip.xy / previousClip.w * 0.5 + 0.5;
+    float previousDepth = -(u_PreviousView * worldPos).z;
+
+    float result = current.r;
+    if (all(greaterThanEqual(previousUV, vec2(0.0))) && all(lessThanEqual(previousUV, vec2(1.0))))
+    {
+        vec2 history = texture(u_HistoryTexture, previousUV).rg;
+        // 深度差异过大说明是新暴露的区域，丢弃历史
+        if (abs(history.g - previousDepth) < u_DepthThreshold * previousDepth)
+            result = mix(clamp(history.r, aoMin, aoMax), current.r, u_TemporalBlend);
+    }
+
+    FinalColor = vec4(result, current.g, 0.0, 1.0);
+}
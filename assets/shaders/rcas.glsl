@@ -0,0 +1,54 @@
+#type vertex
+#version 450
+
+layout(location = 0) in vec3 a_PositionOS;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	gl_Position = vec4(a_PositionOS, 1.0);
+    v_TexCoord = (a_PositionOS.xy + 1.0) / 2.0;
+}
+
+#type fragment
+#version 450
+
+// 对比度自适应锐化（RCAS）：十字形 5 个样本，锐化强度受邻域范围限制以避免超出 [0, 1] 产生振铃
+
+layout(location = 0) out vec4 FinalColor;
+
+in vec2 v_TexCoord;
+
+layout(binding = 0) uniform sampler2D u_Texture;
+
+uniform float u_Sharpness = 0.2; // 以 stop 为单位，0 最锐利
+
+const float RCAS_LIMIT = 0.25 - 1.0 / 16.0;
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(u_Texture, 0) - 1;
+
+    //   b
+    // d e f
+    //   h
+    vec3 b = texelFetch(u_Texture, clamp(texel + ivec2(0, -1), ivec2(0), maxTexel), 0).rgb;
+    vec3 d = texelFetch(u_Texture, clamp(texel + ivec2(-1, 0), ivec2(0), maxTexel), 0).rgb;
+    vec3 e = texelFetch(u_Texture, texel, 0).rgb;
+    vec3 f = texelFetch(u_Texture, clamp(texel + ivec2(1, 0), ivec2(0), maxTexel), 0).rgb;
+    vec3 h = texelFetch(u_Texture, clamp(texel + ivec2(0, 1), ivec2(0), maxTexel), 0).rgb;
+
+    vec3 minColor = min(min(b, d), min(f, h));
+    vec3 maxColor = max(max(b, d), max(f, h));
+
+    // 求不会让结果超出邻域范围的最大负向权重
+    vec3 hitMin = min(minColor, e) / (4.0 * maxColor + 1e-5);
+    vec3 hitMax = (1.0 - max(maxColor, e)) / (4.0 * min(minColor, e) - 4.0 - 1e-5);
+    vec3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-RCAS_LIMIT, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * exp2(-u_Sharpness);
+
+    vec3 color = (lobe * (b + d + f + h) + e) / (4.0 * lobe + 1.0);
+    FinalColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
@@ -1,15 +1,67 @@
 #type vertex
 #version 450
+#extension GL_ARB_shader_draw_parameters : require
 
 layout(location = 0) in vec3 a_PositionOS;
 
 uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
+uniform bool u_UseObjectBuffer;
+uniform bool u_UseInstanceBuffer;
+
+layout(std140, binding = 4) uniform ViewData
+{
+	mat4 View;
+	mat4 Projection;
+	mat4 ViewProjection;
+	mat4 LightSpaceMatrix;
+	float NearPlane;
+	float FarPlane;
+} u_ViewData;
+
+struct ObjectData
+{
+	mat4 Model;
+	mat4 NormalMatrix; // 只用左上 3x3
+	vec4 BoundingSphere;
+	uint MaterialIndex;
+	uint IndexCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint Flags;
+	uint ShadowIndexCount;
+	uint ShadowFirstIndex;
+	uint Padding;
+};
+
+layout(std430, binding = 0) readonly buffer ObjectBuffer
+{
+	ObjectData u_Objects[];
+};
+
+struct InstanceData
+{
+	mat4 Model;
+	mat4 NormalMatrix; // 只用左上 3x3
+};
+
+layout(std430, binding = 4) readonly buffer InstanceBuffer
+{
+	InstanceData u_Instances[];
+};
+
+mat4 GetModelMatrix()
+{
+	if (u_UseObjectBuffer)
+		return u_Objects[gl_BaseInstanceARB].Model;
+	if (u_UseInstanceBuffer)
+		return u_Instances[gl_BaseInstanceARB + gl_InstanceID].Model;
+	return u_Model;
+}
 
 void main()
 {
-	gl_Position = u_Projection * u_View * u_Model * vec4(a_PositionOS, 1.0);
+	mat4 model = GetModelMatrix();
+	gl_Position = u_ViewData.ViewProjection * model * vec4(a_PositionOS, 1.0);
 }
 
 #type fragment
@@ -1,10 +1,10 @@
 #type vertex
 #version 450
+#extension GL_ARB_shader_draw_parameters : require
 
 layout(location = 0) in vec3 a_PositionOS;
-layout(location = 1) in vec3 a_NormalOS;
-layout(location = 2) in vec3 a_TangentOS;
-layout(location = 3) in vec3 a_BinormalOS;
+layout(location = 1) in vec2 a_NormalOS;  // 八面体编码
+layout(location = 2) in vec2 a_TangentOS; // 八面体编码，y 的最低位是副切线的符号
 layout(location = 4) in vec2 a_TexCoord;
 
 out Varyings
@@ -14,35 +14,112 @@ out Varyings
     vec3 PositionWS;
     mat3 TBN; 
     vec4 PositionHLS; // Homogeneous Light Space
+    flat uint MaterialIndex;
 } vs_out;
 
 uniform mat4 u_Model;
-uniform mat4 u_View;
-uniform mat4 u_Projection;
-uniform mat4 u_LightSpaceMatrix;
+uniform mat3 u_NormalMatrix = mat3(1.0); // u_Model 的逆转置，由 CPU 计算
+uniform bool u_UseObjectBuffer;
+uniform bool u_UseInstanceBuffer;
+uniform uint u_MaterialID = 0xFFFFFFFFu; // MaterialTable 槽位，无效值表示使用材质统一值
+
+layout(std140, binding = 4) uniform ViewData
+{
+    mat4 View;
+    mat4 Projection;
+    mat4 ViewProjection;
+    mat4 LightSpaceMatrix;
+    float NearPlane;
+    float FarPlane;
+} u_ViewData;
+
+struct ObjectData
+{
+    mat4 Model;
+    mat4 NormalMatrix; // 只用左上 3x3
+    vec4 BoundingSphere;
+    uint MaterialIndex;
+    uint IndexCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint Flags;
+    uint ShadowIndexCount;
+    uint ShadowFirstIndex;
+    uint Padding;
+};
+
+layout(std430, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData u_Objects[];
+};
+
+struct InstanceData
+{
+    mat4 Model;
+    mat4 NormalMatrix; // 只用左上 3x3
+};
+
+layout(std430, binding = 4) readonly buffer InstanceBuffer
+{
+    InstanceData u_Instances[];
+};
+
+mat4 GetModelMatrix()
+{
+    if (u_UseObjectBuffer)
+        return u_Objects[gl_BaseInstanceARB].Model;
+    if (u_UseInstanceBuffer)
+        return u_Instances[gl_BaseInstanceARB + gl_InstanceID].Model;
+    return u_Model;
+}
+
+mat3 GetNormalMatrix()
+{
+    if (u_UseObjectBuffer)
+        return mat3(u_Objects[gl_BaseInstanceARB].NormalMatrix);
+    if (u_UseInstanceBuffer)
+        return mat3(u_Instances[gl_BaseInstanceARB + gl_InstanceID].NormalMatrix);
+    return u_NormalMatrix;
+}
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-v.z, 0.0);
+    v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+    return normalize(v);
+}
 
 void main()
 {
-    gl_Position = u_Projection * u_View * u_Model * vec4(a_PositionOS, 1.0);
+    mat4 model = GetModelMatrix();
+    vs_out.MaterialIndex = u_UseObjectBuffer ? u_Objects[gl_BaseInstanceARB].MaterialIndex : u_MaterialID;
+    gl_Position = u_ViewData.ViewProjection * model * vec4(a_PositionOS, 1.0);
     vs_out.TexCoord = a_TexCoord;
     
+    vec3 normalOS = OctDecode(a_NormalOS);
+    vec3 tangentOS = OctDecode(a_TangentOS);
+    float binormalSign = (int(round(a_TangentOS.y * 32767.0)) & 1) != 0 ? -1.0 : 1.0;
+    vec3 binormalOS = cross(normalOS, tangentOS) * binormalSign;
+
     // Transform normal to world space
-    mat3 normalModel = mat3(transpose(inverse(u_Model))); // TODO 放在CPU端计算
-    vs_out.NormalWS = normalModel * a_NormalOS; 
+    mat3 normalModel = GetNormalMatrix();
+    vs_out.NormalWS = normalModel * normalOS; 
     // Transform position to world space
-    vs_out.PositionWS = vec3(u_Model * vec4(a_PositionOS, 1.0));
+    vs_out.PositionWS = vec3(model * vec4(a_PositionOS, 1.0));
     
     // Compute TBN matrix
-    vec3 T = normalModel * a_TangentOS;
-    vec3 B = normalModel * a_BinormalOS;
+    vec3 T = normalModel * tangentOS;
+    vec3 B = normalModel * binormalOS;
     vs_out.TBN = mat3(T, B, vs_out.NormalWS);
 
     // Calculate light space position
-    vs_out.PositionHLS = u_LightSpaceMatrix * vec4(vs_out.PositionWS, 1.0);
+    vs_out.PositionHLS = u_ViewData.LightSpaceMatrix * vec4(vs_out.PositionWS, 1.0);
 }
 
 #type fragment
 #version 450
+#extension GL_ARB_bindless_texture : require
 
 layout(location = 0) out vec4 FinalColor;
 
@@ -53,6 +130,7 @@ in Varyings
     vec3 PositionWS;
     mat3 TBN;
     vec4 PositionHLS;
+    flat uint MaterialIndex;
 } fs_in;
 
 uniform vec4 u_AlbedoColor;
@@ -64,18 +142,45 @@ uniform sampler2D u_NormalTexture;
 uniform sampler2D u_MetallicTexture;
 uniform sampler2D u_RoughnessTexture;
 
-uniform samplerCube u_IrradianceMap;
-uniform samplerCube u_PrefilterMap;
-uniform sampler2D u_BrdfLUT;
+struct MaterialData
+{
+    vec4 AlbedoColor;
+    float Metallic;
+    float Roughness;
+    float NormalScale;
+    float Padding;
+    uvec2 AlbedoTexture;
+    uvec2 NormalTexture;
+    uvec2 MetallicTexture;
+    uvec2 RoughnessTexture;
+};
+
+layout(std430, binding = 1) readonly buffer MaterialBuffer
+{
+    MaterialData u_Materials[];
+};
 
-uniform sampler2D u_ShadowMap;
+const uint INVALID_MATERIAL_ID = 0xFFFFFFFFu;
 
-uniform sampler2D u_OcclusionMap;
+// 每帧共享的纹理句柄，由 ShadingPass 上传一次
+layout(std430, binding = 5) readonly buffer FrameTextureBuffer
+{
+    uvec2 PrefilterMap;
+    uvec2 BrdfLUT;
+    uvec2 LTC1;
+    uvec2 LTC2;
+    uvec2 ShadowMap;
+    uvec2 OcclusionMap;
+} u_FrameTextures;
 
 const float PI = 3.141592;
 
-uniform sampler2D u_LTC1; // for inverse M
-uniform sampler2D u_LTC2; // GGX norm, fresnel, 0(unused), sphere
+#define u_PrefilterMap samplerCube(u_FrameTextures.PrefilterMap)
+#define u_BrdfLUT sampler2D(u_FrameTextures.BrdfLUT)
+#define u_ShadowMap sampler2D(u_FrameTextures.ShadowMap)
+#define u_OcclusionMap sampler2D(u_FrameTextures.OcclusionMap)
+#define u_LTC1 sampler2D(u_FrameTextures.LTC1) // for inverse M
+#define u_LTC2 sampler2D(u_FrameTextures.LTC2) // GGX norm, fresnel, 0(unused), sphere
 
 const float LUT_SIZE  = 64.0; // ltc_texture size
 const float LUT_SCALE = (LUT_SIZE - 1.0)/LUT_SIZE;
@@ -100,6 +205,8 @@ layout(std140, binding = 0) uniform SceneData
     float ShadowNormalBias;
 
     vec2 Resolution;
+
+    vec4 IrradianceSH[9]; // 已包含基函数常数与余弦卷积，w 未使用
 } u_Scene;
 
 struct PointLight
@@ -326,6 +433,21 @@ vec3 RotateVectorAboutY(float angle, vec3 vec)
     return rotationMatrix * vec;
 }
 
+// 球谐求值得到白色漫反射表面的出射辐射度
+vec3 EvaluateIrradianceSH(vec3 n)
+{
+    vec3 result = u_Scene.IrradianceSH[0].rgb;
+    result += u_Scene.IrradianceSH[1].rgb * n.y;
+    result += u_Scene.IrradianceSH[2].rgb * n.z;
+    result += u_Scene.IrradianceSH[3].rgb * n.x;
+    result += u_Scene.IrradianceSH[4].rgb * (n.x * n.y);
+    result += u_Scene.IrradianceSH[5].rgb * (n.y * n.z);
+    result += u_Scene.IrradianceSH[6].rgb * (3.0 * n.z * n.z - 1.0);
+    result += u_Scene.IrradianceSH[7].rgb * (n.x * n.z);
+    result += u_Scene.IrradianceSH[8].rgb * (n.x * n.x - n.y * n.y);
+    return max(result, vec3(0.0));
+}
+
 vec3 IBL(vec3 normal, vec3 viewDir, vec4 albedo, float metallic, float roughness)
 {
     // IBL
@@ -339,7 +461,7 @@ vec3 IBL(vec3 normal, vec3 viewDir, vec4 albedo, float metallic, float roughness
     vec3 kS = F;
     vec3 kD = 1.0 - kS;
     kD *= 1.0 - metallic;
-    vec3 irradiance = texture(u_IrradianceMap, N).rgb;
+    vec3 irradiance = EvaluateIrradianceSH(N);
     vec3 diffuse = irradiance * albedo.rgb;
 
     vec3 prefilteredColor = textureLod(u_PrefilterMap, R, roughness * textureQueryLevels(u_PrefilterMap)).rgb;
@@ -371,6 +493,13 @@ float ShadowCalculation(vec4 PositionHLS, vec3 lightDir)
     return shadow;
 }
 
+// 只使用 xy，z 由单位长度重建，兼容 BC5 双通道法线贴图
+vec3 DecodeNormal(vec4 packedNormal)
+{
+    vec2 xy = packedNormal.xy * 2.0 - 1.0;
+    return vec3(xy, sqrt(max(1.0 - dot(xy, xy), 0.0)));
+}
+
 vec3 MultiBounceAO(float ao, vec3 albedo)
 {
     vec3 a = 2.0404 * albedo - 0.3324;
@@ -383,13 +512,34 @@ vec3 MultiBounceAO(float ao, vec3 albedo)
 
 void main()
 {
+    vec4 albedoColor = u_AlbedoColor;
+    float metallicScale = u_Metallic;
+    float roughnessScale = u_Roughness;
+    float normalScale = u_NormalScale;
+    sampler2D albedoTexture = u_AlbedoTexture;
+    sampler2D normalTexture = u_NormalTexture;
+    sampler2D metallicTexture = u_MetallicTexture;
+    sampler2D roughnessTexture = u_RoughnessTexture;
+    if (fs_in.MaterialIndex != INVALID_MATERIAL_ID)
+    {
+        MaterialData material = u_Materials[fs_in.MaterialIndex];
+        albedoColor = material.AlbedoColor;
+        metallicScale = material.Metallic;
+        roughnessScale = material.Roughness;
+        normalScale = material.NormalScale;
+        albedoTexture = sampler2D(material.AlbedoTexture);
+        normalTexture = sampler2D(material.NormalTexture);
+        metallicTexture = sampler2D(material.MetallicTexture);
+        roughnessTexture = sampler2D(material.RoughnessTexture);
+    }
+
     // Sample textures
-    vec4 albedo = texture(u_AlbedoTexture, fs_in.TexCoord) * u_AlbedoColor;
-    float metallic = texture(u_MetallicTexture, fs_in.TexCoord).r * u_Metallic;
-    float roughness = texture(u_RoughnessTexture, fs_in.TexCoord).r * u_Roughness;
+    vec4 albedo = texture(albedoTexture, fs_in.TexCoord) * albedoColor;
+    float metallic = texture(metallicTexture, fs_in.TexCoord).r * metallicScale;
+    float roughness = texture(roughnessTexture, fs_in.TexCoord).r * roughnessScale;
     float ao = texture(u_OcclusionMap, gl_FragCoord.xy / u_Scene.Resolution).r;
     // Transform normal from tangent space to world space
-    vec3 normal = normalize(fs_in.TBN * (texture(u_NormalTexture, fs_in.TexCoord).xyz * 2.0 - 1.0) * u_NormalScale);
+    vec3 normal = normalize(fs_in.TBN * DecodeNormal(texture(normalTexture, fs_in.TexCoord)) * normalScale);
     
     // Calculate view direction
     vec3 viewDir = normalize(u_Scene.CameraPosition - fs_in.PositionWS);
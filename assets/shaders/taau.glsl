@@ -0,0 +1,159 @@
+#type vertex
+#version 450
+
+layout(location = 0) in vec3 a_PositionOS;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	gl_Position = vec4(a_PositionOS, 1.0);
+    v_TexCoord = (a_PositionOS.xy + 1.0) / 2.0;
+}
+
+#type fragment
+#version 450
+#extension GL_ARB_bindless_texture : require
+
+layout(location = 0) out vec4 FinalColor;
+
+in vec2 v_TexCoord;
+
+layout(binding = 0) uniform sampler2D u_Texture; // 渲染分辨率下带抖动的场景颜色
+uniform sampler2D u_MotionTexture;
+uniform sampler2D u_GDepth;
+uniform sampler2D u_HistoryTexture;
+
+uniform bool u_HistoryValid;
+uniform vec2 u_Jitter; // 渲染分辨率像素单位
+uniform mat4 u_InverseViewProjection;
+uniform mat4 u_PreviousViewProjection;
+uniform float u_BlendFactor = 0.1;
+uniform float u_ClampGamma = 1.0;
+
+vec3 RGBToYCoCg(vec3 color)
+{
+    return vec3(0.25 * color.r + 0.5 * color.g + 0.25 * color.b, 0.5 * color.r - 0.5 * color.b,
+                -0.25 * color.r + 0.5 * color.g - 0.25 * color.b);
+}
+
+vec3 YCoCgToRGB(vec3 color)
+{
+    return vec3(color.x + color.y - color.z, color.x + color.z, color.x - color.y - color.z);
+}
+
+// 9 次双线性采样近似的 Catmull-Rom 滤波，减轻历史重采样带来的模糊
+vec3 SampleHistory(vec2 uv)
+{
+    vec2 historySize = vec2(textureSize(u_HistoryTexture, 0));
+    vec2 samplePos = uv * historySize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 offset12 = w2 / w12;
+
+    vec2 texPos0 = (texPos1 - 1.0) / historySize;
+    vec2 texPos3 = (texPos1 + 2.0) / historySize;
+    vec2 texPos12 = (texPos1 + offset12) / historySize;
+
+    vec3 result = vec3(0.0);
+    result += texture(u_HistoryTexture, vec2(texPos0.x, texPos0.y)).rgb * w0.x * w0.y;
+    result += texture(u_HistoryTexture, vec2(texPos12.x, texPos0.y)).rgb * w12.x * w0.y;
+    result += texture(u_HistoryTexture, vec2(texPos3.x, texPos0.y)).rgb * w3.x * w0.y;
+
+    result += texture(u_HistoryTexture, vec2(texPos0.x, texPos12.y)).rgb * w0.x * w12.y;
+    result += texture(u_HistoryTexture, vec2(texPos12.x, texPos12.y)).rgb * w12.x * w12.y;
+    result += texture(u_HistoryTexture, vec2(texPos3.x, texPos12.y)).rgb * w3.x * w12.y;
+
+    result += texture(u_HistoryTexture, vec2(texPos0.x, texPos3.y)).rgb * w0.x * w3.y;
+    result += texture(u_HistoryTexture, vec2(texPos12.x, texPos3.y)).rgb * w12.x * w3.y;
+    result += texture(u_HistoryTexture, vec2(texPos3.x, texPos3.y)).rgb * w3.x * w3.y;
+    return max(result, vec3(0.0));
+}
+
+// 天空没有写入运动矢量，按远平面上的点只根据相机运动重投影
+vec2 GetMotion(ivec2 texel, vec2 inputSize)
+{
+    float depth = texelFetch(u_GDepth, texel, 0).r;
+    if (depth < 1.0)
+        return texelFetch(u_MotionTexture, texel, 0).xy;
+
+    vec2 uv = (vec2(texel) + 0.5) / inputSize;
+    vec4 positionWS = u_InverseViewProjection * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec4 previousPositionCS = u_PreviousViewProjection * vec4(positionWS.xyz / positionWS.w, 1.0);
+    return uv - (previousPositionCS.xy / previousPositionCS.w * 0.5 + 0.5);
+}
+
+void main()
+{
+    vec2 inputSize = vec2(textureSize(u_Texture, 0));
+    ivec2 maxTexel = ivec2(inputSize) - 1;
+
+    // 输出像素对应的场景内容在抖动后的输入图像中位于 uv * inputSize + jitter
+    vec2 inputPos = v_TexCoord * inputSize + u_Jitter;
+    ivec2 centerTexel = ivec2(floor(inputPos));
+
+    vec3 colorSum = vec3(0.0);
+    float weightSum = 0.0;
+    float maxWeight = 0.0;
+    vec3 m1 = vec3(0.0);
+    vec3 m2 = vec3(0.0);
+    vec3 minColor = vec3(1e10);
+    vec3 maxColor = vec3(-1e10);
+    float closestDepth = 1.0;
+    ivec2 closestTexel = clamp(centerTexel, ivec2(0), maxTexel);
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            ivec2 texel = clamp(centerTexel + ivec2(x, y), ivec2(0), maxTexel);
+            vec3 color = RGBToYCoCg(texelFetch(u_Texture, texel, 0).rgb);
+
+            // 按输入样本到输出像素中心的距离加权重建当前帧颜色
+            vec2 offset = vec2(centerTexel + ivec2(x, y)) + 0.5 - inputPos;
+            float weight = exp(-2.29 * dot(offset, offset));
+            colorSum += color * weight;
+            weightSum += weight;
+            maxWeight = max(maxWeight, weight);
+
+            m1 += color;
+            m2 += color * color;
+            minColor = min(minColor, color);
+            maxColor = max(maxColor, color);
+
+            // 取邻域内最近的深度对应的运动矢量，避免物体边缘拖影
+            float depth = texelFetch(u_GDepth, texel, 0).r;
+            if (depth < closestDepth)
+            {
+                closestDepth = depth;
+                closestTexel = texel;
+            }
+        }
+    }
+    vec3 current = colorSum / max(weightSum, 1e-5);
+
+    vec2 historyUV = v_TexCoord - GetMotion(closestTexel, inputSize);
+    bool offscreen = any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0)));
+    if (!u_HistoryValid || offscreen)
+    {
+        FinalColor = vec4(YCoCgToRGB(current), 1.0);
+        return;
+    }
+
+    // 方差裁剪：历史颜色限制在邻域统计范围内，处理遮挡变化与运动物体
+    vec3 mean = m1 / 9.0;
+    vec3 sigma = sqrt(max(m2 / 9.0 - mean * mean, vec3(0.0)));
+    vec3 boxMin = max(mean - u_ClampGamma * sigma, minColor);
+    vec3 boxMax = min(mean + u_ClampGamma * sigma, maxColor);
+    vec3 history = clamp(RGBToYCoCg(SampleHistory(historyUV)), boxMin, boxMax);
+
+    // 离输入样本越远的输出像素越依赖历史
+    float blend = clamp(u_BlendFactor * maxWeight, 0.01, 1.0);
+    FinalColor = vec4(YCoCgToRGB(mix(history, current, blend)), 1.0);
+}
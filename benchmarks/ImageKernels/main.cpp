@@ -0,0 +1,196 @@
+// 对比 ImageKernels 各函数的 SIMD 实现与标量实现：先核对两者输出逐字节一致，再分别计时
+// 用法: ImageKernelsBenchmark [边长]，默认按 2048x2048 的纹理测试；输出不一致时返回 1
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ImageKernels.h"
+
+using namespace Doodle;
+
+static constexpr uint32_t DEFAULT_SIZE = 2048;
+static constexpr size_t TAIL_PIXELS = 5; // 让像素数不是任何 SIMD 块大小的整数倍，覆盖标量收尾
+static constexpr uint32_t MIN_ITERATIONS = 5;
+static constexpr double MIN_SECONDS = 0.5;
+
+using KernelFunction = std::function<void(std::vector<uint8_t> &buffer)>;
+
+static std::vector<uint8_t> RandomBytes(size_t size, uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<uint32_t> distribution(0, 255);
+    std::vector<uint8_t> bytes(size);
+    for (auto &byte : bytes)
+        byte = static_cast<uint8_t>(distribution(random));
+    return bytes;
+}
+
+// HDR 像素值，混入半精度的非规格化数、溢出值、恰好落在两个半精度数正中间的值与无穷、NaN 等特殊值
+static std::vector<uint8_t> RandomFloats(size_t count, uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> radiance(0.0f, 64.0f);
+    std::uniform_real_distribution<float> tiny(0.0f, 1.0e-4f);
+    std::uniform_real_distribution<float> huge(-70000.0f, 70000.0f);
+    std::uniform_int_distribution<uint32_t> mantissa(0, 0x3FF);
+    const float specials[] = {0.0f,
+                              -0.0f,
+                              65504.0f,
+                              65519.0f,
+                              65520.0f,
+                              std::numeric_limits<float>::infinity(),
+                              -std::numeric_limits<float>::infinity(),
+                              std::numeric_limits<float>::quiet_NaN(),
+                              std::numeric_limits<float>::signaling_NaN(),
+                              std::numeric_limits<float>::denorm_min(),
+                              std::ldexp(1.0f, -24),
+                              std::ldexp(1.0f, -25),
+                              std::ldexp(3.0f, -25)};
+
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (i % 8)
+        {
+        case 0:
+            values[i] = specials[i / 8 % std::size(specials)];
+            break;
+        case 1:
+            values[i] = tiny(random);
+            break;
+        case 2:
+            values[i] = huge(random);
+            break;
+        case 3: {
+            // 1 + (m + 0.5) / 1024：尾数第 11 位为 1、其余为 0，必须按就近偶数舍入
+            uint32_t bits = 0x3F800000u | (mantissa(random) << 13) | 0x1000u;
+            std::memcpy(&values[i], &bits, sizeof(bits));
+            break;
+        }
+        default:
+            values[i] = radiance(random);
+            break;
+        }
+    }
+    std::vector<uint8_t> bytes(count * sizeof(float));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+}
+
+static double Measure(const std::vector<uint8_t> &input, const KernelFunction &kernel, bool simd)
+{
+    ImageKernels::SetSIMDEnabled(simd);
+    std::vector<uint8_t> buffer;
+    double best = std::numeric_limits<double>::max();
+    double total = 0.0;
+    for (uint32_t i = 0; i < MIN_ITERATIONS || total < MIN_SECONDS; i++)
+    {
+        buffer = input;
+        auto start = std::chrono::steady_clock::now();
+        kernel(buffer);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+static bool RunCase(const char *name, const std::vector<uint8_t> &input, size_t processedBytes,
+                    const KernelFunction &kernel)
+{
+    std::vector<uint8_t> scalar = input;
+    ImageKernels::SetSIMDEnabled(false);
+    kernel(scalar);
+    std::vector<uint8_t> simd = input;
+    ImageKernels::SetSIMDEnabled(true);
+    kernel(simd);
+
+    auto mismatch = std::mismatch(scalar.begin(), scalar.end(), simd.begin());
+    if (mismatch.first != scalar.end())
+    {
+        size_t offset = mismatch.first - scalar.begin();
+        std::printf("%-32s MISMATCH at byte %zu: scalar 0x%02x, simd 0x%02x\n", name, offset, *mismatch.first,
+                    *mismatch.second);
+        return false;
+    }
+
+    double scalarSeconds = Measure(input, kernel, false);
+    double simdSeconds = Measure(input, kernel, true);
+    double gigabytes = processedBytes / 1.0e9;
+    std::printf("%-32s scalar %8.3f ms %7.2f GB/s   simd %8.3f ms %7.2f GB/s   %6.2fx\n", name,
+                scalarSeconds * 1000.0, gigabytes / scalarSeconds, simdSeconds * 1000.0, gigabytes / simdSeconds,
+                scalarSeconds / simdSeconds);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t size = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : DEFAULT_SIZE;
+    if (size == 0)
+    {
+        std::fprintf(stderr, "Invalid size: %s\n", argv[1]);
+        return 1;
+    }
+    size_t pixelCount = static_cast<size_t>(size) * size + TAIL_PIXELS;
+    std::printf("%ux%u + %zu pixels\n", size, size, TAIL_PIXELS);
+
+    bool passed = true;
+
+    // 与 Texture.cpp 中 HDR 纹理的用法相同，半精度结果写回 float 数组的前半段
+    size_t floatCount = pixelCount * 4;
+    auto floats = RandomFloats(floatCount, 1);
+    passed &= RunCase("ConvertFloatToHalf (in place)", floats, floatCount * sizeof(float),
+                      [floatCount](std::vector<uint8_t> &buffer) {
+                          ImageKernels::ConvertFloatToHalf(reinterpret_cast<const float *>(buffer.data()),
+                                                           reinterpret_cast<uint16_t *>(buffer.data()), floatCount);
+                      });
+    auto floatsAndHalves = floats;
+    floatsAndHalves.resize(floatCount * (sizeof(float) + sizeof(uint16_t)));
+    passed &= RunCase("ConvertFloatToHalf", floatsAndHalves, floatCount * sizeof(float),
+                      [floatCount](std::vector<uint8_t> &buffer) {
+                          auto *halves = reinterpret_cast<uint16_t *>(buffer.data() + floatCount * sizeof(float));
+                          ImageKernels::ConvertFloatToHalf(reinterpret_cast<const float *>(buffer.data()), halves,
+                                                           floatCount);
+                      });
+
+    auto rgba = RandomBytes(pixelCount * 4, 2);
+    auto rgb = RandomBytes(pixelCount * 3, 3);
+    passed &= RunCase("InvertChannels (RGBA, RGB only)", rgba, rgba.size(), [pixelCount](std::vector<uint8_t> &buffer) {
+        ImageKernels::InvertChannels(buffer.data(), pixelCount, 4, 3);
+    });
+    passed &= RunCase("InvertChannels (RGB)", rgb, rgb.size(), [pixelCount](std::vector<uint8_t> &buffer) {
+        ImageKernels::InvertChannels(buffer.data(), pixelCount, 3, 3);
+    });
+
+    passed &= RunCase("SwizzleChannels (RGBA to BGRA)", rgba, rgba.size(), [pixelCount](std::vector<uint8_t> &buffer) {
+        const int32_t channelMap[] = {2, 1, 0, 3};
+        ImageKernels::SwizzleChannels(buffer.data(), 4, buffer.data(), 4, channelMap, pixelCount);
+    });
+    passed &= RunCase("SwizzleChannels (RGBA to R001)", rgba, rgba.size(), [pixelCount](std::vector<uint8_t> &buffer) {
+        const int32_t channelMap[] = {0, ImageKernels::SWIZZLE_ZERO, ImageKernels::SWIZZLE_ZERO,
+                                      ImageKernels::SWIZZLE_ONE};
+        ImageKernels::SwizzleChannels(buffer.data(), 4, buffer.data(), 4, channelMap, pixelCount);
+    });
+    // 与 Texture.cpp 中拆分 glTF 粗糙度、金属度纹理的用法相同
+    passed &= RunCase("SwizzleChannels (RGBA to GGGA)", rgba, rgba.size(), [pixelCount](std::vector<uint8_t> &buffer) {
+        const int32_t channelMap[] = {1, 1, 1, 3};
+        ImageKernels::SwizzleChannels(buffer.data(), 4, buffer.data(), 4, channelMap, pixelCount);
+    });
+
+    ImageKernels::SetSIMDEnabled(true);
+    if (!passed)
+    {
+        std::fprintf(stderr, "SIMD and scalar results differ\n");
+        return 1;
+    }
+    return 0;
+}
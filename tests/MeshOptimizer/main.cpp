@@ -0,0 +1,279 @@
+// MeshOptimizer 在固定的小网格上的检查：去重、三角形集合与绕序在各步骤后保持不变、ACMR 不变差、顶点按首次使用排序
+// 用法: MeshOptimizerTest，全部通过时返回 0
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "MeshOptimizer.h"
+
+using namespace Doodle;
+
+static int s_FailureCount = 0;
+
+#define CHECK(condition)                                                                                               \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(condition))                                                                                              \
+        {                                                                                                              \
+            std::printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                             \
+            s_FailureCount++;                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+struct TestMesh
+{
+    std::vector<Vertex> Vertices;
+    std::vector<uint32_t> Indices;
+};
+
+static Vertex MakeVertex(float x, float y, float u, float v)
+{
+    Vertex vertex = {};
+    vertex.Position = {x, y, 0.0f};
+    vertex.Normal = {0.0f, 0.0f, 1.0f};
+    vertex.Tangent = {1.0f, 0.0f, 0.0f};
+    vertex.Binormal = {0.0f, 1.0f, 0.0f};
+    vertex.TexCoord = {u, v};
+    return vertex;
+}
+
+// size x size 个四边形的平面网格，三角形按行排列，逆时针绕序
+static TestMesh MakeGrid(uint32_t size)
+{
+    TestMesh mesh;
+    for (uint32_t y = 0; y <= size; y++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+        {
+            float u = static_cast<float>(x) / size;
+            float v = static_cast<float>(y) / size;
+            mesh.Vertices.push_back(MakeVertex(static_cast<float>(x), static_cast<float>(y), u, v));
+        }
+    }
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t i0 = y * (size + 1) + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + size + 1;
+            uint32_t i3 = i2 + 1;
+            mesh.Indices.insert(mesh.Indices.end(), {i0, i1, i3, i0, i3, i2});
+        }
+    }
+    return mesh;
+}
+
+// 打乱三角形的顺序与每个三角形的起始顶点（绕序不变），以及顶点的存放顺序
+static TestMesh MakeShuffledGrid(uint32_t size, uint32_t seed)
+{
+    TestMesh mesh = MakeGrid(size);
+    std::mt19937 random(seed);
+
+    std::vector<uint32_t> vertexOrder(mesh.Vertices.size());
+    for (uint32_t i = 0; i < vertexOrder.size(); i++)
+        vertexOrder[i] = i;
+    std::shuffle(vertexOrder.begin(), vertexOrder.end(), random);
+    std::vector<Vertex> vertices(mesh.Vertices.size());
+    for (uint32_t i = 0; i < vertexOrder.size(); i++)
+        vertices[vertexOrder[i]] = mesh.Vertices[i];
+    mesh.Vertices = std::move(vertices);
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < mesh.Indices.size(); i += 3)
+    {
+        std::array<uint32_t, 3> triangle = {vertexOrder[mesh.Indices[i]], vertexOrder[mesh.Indices[i + 1]],
+                                            vertexOrder[mesh.Indices[i + 2]]};
+        std::rotate(triangle.begin(), triangle.begin() + random() % 3, triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    mesh.Indices.clear();
+    for (const auto &triangle : triangles)
+        mesh.Indices.insert(mesh.Indices.end(), triangle.begin(), triangle.end());
+    return mesh;
+}
+
+using VertexKey = std::tuple<float, float, float, float, float>;
+using TriangleKey = std::array<VertexKey, 3>;
+
+// 按顶点内容比较三角形，与顶点下标无关；起始顶点旋转到最小的一个，保留绕序
+static std::vector<TriangleKey> GetTriangles(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+{
+    std::vector<TriangleKey> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        TriangleKey triangle;
+        for (size_t k = 0; k < 3; k++)
+        {
+            const Vertex &vertex = vertices[indices[i + k]];
+            triangle[k] = {vertex.Position.x, vertex.Position.y, vertex.Position.z, vertex.TexCoord.x,
+                           vertex.TexCoord.y};
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+static bool IndicesInRange(const std::vector<uint32_t> &indices, size_t vertexCount)
+{
+    return std::all_of(indices.begin(), indices.end(), [&](uint32_t index) { return index < vertexCount; });
+}
+
+static void TestDeduplicateVertices()
+{
+    // 每个三角形各自带着完整的三个顶点，共用的顶点逐字节相同，应当合并；
+    // 最后一个三角形中的接缝顶点与已有顶点只差纹理坐标，必须保留
+    TestMesh mesh;
+    mesh.Vertices = {MakeVertex(0, 0, 0, 0), MakeVertex(1, 0, 1, 0), MakeVertex(1, 1, 1, 1),
+                     MakeVertex(0, 0, 0, 0), MakeVertex(1, 1, 1, 1), MakeVertex(0, 1, 0, 1),
+                     MakeVertex(0, 1, 0, 1), MakeVertex(1, 1, 1, 1), MakeVertex(0, 2, 0.5f, 2)};
+    mesh.Indices = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    Vertex seam = MakeVertex(0, 1, 0.25f, 1);
+    mesh.Vertices.push_back(seam);
+    mesh.Indices.insert(mesh.Indices.end(), {9, 8, 7});
+    TestMesh original = mesh;
+
+    uint32_t removed = MeshOptimizer::DeduplicateVertices(mesh.Vertices, mesh.Indices);
+    CHECK(removed == 4);
+    CHECK(mesh.Vertices.size() == original.Vertices.size() - 4);
+    CHECK(mesh.Indices.size() == original.Indices.size());
+    CHECK(IndicesInRange(mesh.Indices, mesh.Vertices.size()));
+    for (size_t i = 0; i < mesh.Indices.size() && IndicesInRange(mesh.Indices, mesh.Vertices.size()); i++)
+    {
+        // 重映射后每个位置引用的顶点与原来逐字节相同
+        CHECK(std::memcmp(&mesh.Vertices[mesh.Indices[i]], &original.Vertices[original.Indices[i]], sizeof(Vertex)) ==
+              0);
+    }
+    CHECK(mesh.Indices[0] == mesh.Indices[3]);
+    CHECK(mesh.Indices[2] == mesh.Indices[4]);
+    CHECK(mesh.Indices[9] != mesh.Indices[5]);
+
+    // 没有重复时不做任何修改
+    TestMesh grid = MakeGrid(4);
+    TestMesh gridCopy = grid;
+    CHECK(MeshOptimizer::DeduplicateVertices(grid.Vertices, grid.Indices) == 0);
+    CHECK(grid.Indices == gridCopy.Indices);
+    CHECK(grid.Vertices.size() == gridCopy.Vertices.size());
+}
+
+static void TestTrianglesPreserved()
+{
+    TestMesh mesh = MakeShuffledGrid(16, 1);
+    auto expected = GetTriangles(mesh.Vertices, mesh.Indices);
+    auto vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+
+    MeshOptimizer::OptimizeVertexCache(mesh.Indices, vertexCount);
+    CHECK(mesh.Indices.size() == expected.size() * 3);
+    CHECK(IndicesInRange(mesh.Indices, vertexCount));
+    CHECK(GetTriangles(mesh.Vertices, mesh.Indices) == expected);
+
+    MeshOptimizer::OptimizeOverdraw(mesh.Indices, mesh.Vertices);
+    CHECK(mesh.Indices.size() == expected.size() * 3);
+    CHECK(IndicesInRange(mesh.Indices, vertexCount));
+    CHECK(GetTriangles(mesh.Vertices, mesh.Indices) == expected);
+
+    MeshOptimizer::OptimizeVertexFetch(mesh.Vertices, mesh.Indices);
+    CHECK(mesh.Vertices.size() == vertexCount);
+    CHECK(IndicesInRange(mesh.Indices, mesh.Vertices.size()));
+    CHECK(GetTriangles(mesh.Vertices, mesh.Indices) == expected);
+
+    // 完整流程，包括去重
+    TestMesh duplicated = MakeShuffledGrid(8, 2);
+    duplicated.Vertices.push_back(duplicated.Vertices[duplicated.Indices[0]]);
+    duplicated.Indices[0] = static_cast<uint32_t>(duplicated.Vertices.size() - 1);
+    auto duplicatedExpected = GetTriangles(duplicated.Vertices, duplicated.Indices);
+    MeshOptimizationResult result = MeshOptimizer::Optimize(duplicated.Vertices, duplicated.Indices);
+    CHECK(result.RemovedVertexCount == 1);
+    CHECK(IndicesInRange(duplicated.Indices, duplicated.Vertices.size()));
+    CHECK(GetTriangles(duplicated.Vertices, duplicated.Indices) == duplicatedExpected);
+}
+
+static void TestCacheEfficiency()
+{
+    TestMesh mesh = MakeShuffledGrid(32, 3);
+    MeshOptimizationResult result = MeshOptimizer::Optimize(mesh.Vertices, mesh.Indices);
+    std::printf("  shuffled 32x32 grid: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", result.Before.ACMR,
+                result.After.ACMR, result.Before.ATVR, result.After.ATVR);
+    CHECK(result.After.ACMR <= result.Before.ACMR);
+    CHECK(result.After.ATVR <= result.Before.ATVR);
+
+    auto vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+    VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(mesh.Indices, vertexCount);
+    CHECK(stats.ACMR == result.After.ACMR);
+    CHECK(stats.ATVR == result.After.ATVR);
+
+    // 每个顶点只未命中一次时 ATVR 为 1；每个三角形三个新顶点时 ACMR 为 3
+    TestMesh separate;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        float x = static_cast<float>(i * 2);
+        separate.Vertices.insert(separate.Vertices.end(),
+                                 {MakeVertex(x, 0, 0, 0), MakeVertex(x + 1, 0, 1, 0), MakeVertex(x, 1, 0, 1)});
+        separate.Indices.insert(separate.Indices.end(), {i * 3, i * 3 + 1, i * 3 + 2});
+    }
+    stats = MeshOptimizer::AnalyzeVertexCache(separate.Indices, static_cast<uint32_t>(separate.Vertices.size()));
+    CHECK(stats.ACMR == 3.0f);
+    CHECK(stats.ATVR == 1.0f);
+}
+
+static void TestVertexFetchOrder()
+{
+    TestMesh mesh = MakeShuffledGrid(8, 4);
+    // 没有被引用的顶点会被丢弃
+    mesh.Vertices.push_back(MakeVertex(100, 100, 0, 0));
+    auto expected = GetTriangles(mesh.Vertices, mesh.Indices);
+    size_t vertexCount = mesh.Vertices.size();
+
+    MeshOptimizer::OptimizeVertexFetch(mesh.Vertices, mesh.Indices);
+    CHECK(mesh.Vertices.size() == vertexCount - 1);
+    CHECK(GetTriangles(mesh.Vertices, mesh.Indices) == expected);
+
+    // 按索引顺序扫描，新出现的顶点下标依次为 0, 1, 2, ...
+    uint32_t next = 0;
+    bool ordered = true;
+    for (uint32_t index : mesh.Indices)
+    {
+        if (index > next)
+            ordered = false;
+        else if (index == next)
+            next++;
+    }
+    CHECK(ordered);
+    CHECK(next == mesh.Vertices.size());
+}
+
+int main()
+{
+    struct Test
+    {
+        const char *Name;
+        void (*Run)();
+    };
+    const Test tests[] = {{"DeduplicateVertices", TestDeduplicateVertices},
+                          {"TrianglesPreserved", TestTrianglesPreserved},
+                          {"CacheEfficiency", TestCacheEfficiency},
+                          {"VertexFetchOrder", TestVertexFetchOrder}};
+
+    int failedTests = 0;
+    for (const auto &test : tests)
+    {
+        int failures = s_FailureCount;
+        std::printf("%s\n", test.Name);
+        test.Run();
+        bool passed = s_FailureCount == failures;
+        failedTests += passed ? 0 : 1;
+        std::printf("  %s\n", passed ? "passed" : "FAILED");
+    }
+
+    std::printf("%d/%zu tests passed\n", static_cast<int>(std::size(tests)) - failedTests, std::size(tests));
+    return failedTests == 0 ? 0 : 1;
+}
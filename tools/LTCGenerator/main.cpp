@@ -0,0 +1,53 @@
+// 把 LTCMatrix.h 中的拟合数据写成引擎运行时映射加载的二进制查找表
+// 用法: LTCGenerator [输出路径]，默认写入 assets/textures/ltc.bin
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "LTCMatrix.h"
+
+// 与 Doodle/src/Rendering/LTCTable.cpp 中的文件头一致
+struct LTCTableHeader
+{
+    char Magic[4];
+    uint32_t Version;
+    uint32_t Size;
+    uint32_t Padding;
+};
+
+static constexpr uint32_t LTC_TABLE_VERSION = 1;
+static constexpr uint32_t LTC_TABLE_SIZE = 64;
+
+static_assert(sizeof(LTC1) == LTC_TABLE_SIZE * LTC_TABLE_SIZE * 4 * sizeof(float), "Unexpected LTC1 size");
+static_assert(sizeof(LTC2) == LTC_TABLE_SIZE * LTC_TABLE_SIZE * 4 * sizeof(float), "Unexpected LTC2 size");
+
+int main(int argc, char **argv)
+{
+    const char *outputPath = argc > 1 ? argv[1] : "assets/textures/ltc.bin";
+
+    std::ofstream stream(outputPath, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        std::fprintf(stderr, "Could not open %s\n", outputPath);
+        return 1;
+    }
+
+    LTCTableHeader header = {};
+    std::memcpy(header.Magic, "DLTC", sizeof(header.Magic));
+    header.Version = LTC_TABLE_VERSION;
+    header.Size = LTC_TABLE_SIZE;
+
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char *>(LTC1), sizeof(LTC1));
+    stream.write(reinterpret_cast<const char *>(LTC2), sizeof(LTC2));
+    if (!stream.good())
+    {
+        std::fprintf(stderr, "Failed to write %s\n", outputPath);
+        return 1;
+    }
+
+    std::printf("Wrote %s\n", outputPath);
+    return 0;
+}
@@ -2,7 +2,7 @@ set_project("Doodle")
 set_version("0.1.0")
 add_rules("mode.debug", "mode.release")
 add_requires("fmt", "assimp", "boost", "stb", "spdlog", "nlohmann_json", "glfw", "glm", "entt", "nativefiledialog-extended")
-add_requires("glad", {configs = {extensions = "GL_ARB_bindless_texture"}})
+add_requires("glad", {configs = {extensions = "GL_ARB_bindless_texture,GL_ARB_indirect_parameters,GL_ARB_shader_draw_parameters"}})
 add_requires("imgui v1.91.0-docking", {configs = {glfw_opengl3 = true}})
 add_requires("imnodes")
 add_requireconfs("pybind11.python", {override = true, version = "3.10"})
@@ -107,4 +107,32 @@ target("Sandbox")
         set_optimize("none")
     else 
         set_optimize("fastest")
-    end
\ No newline at end of file
+    end
+target("LTCGenerator")
+    set_kind("binary")
+    set_default(false)
+
+    -- 生成 assets/textures/ltc.bin，运行: xmake run LTCGenerator <输出路径>
+    add_files("tools/LTCGenerator/*.cpp")
+
+target("MeshOptimizerTest")
+    set_kind("binary")
+    set_default(false)
+
+    -- 在固定的小网格上检查 MeshOptimizer，运行: xmake test MeshOptimizerTest/* 或 xmake run MeshOptimizerTest
+    add_files("tests/MeshOptimizer/*.cpp")
+    add_tests("default")
+    add_deps("Doodle")
+    traverse_directory("Doodle/src")
+    add_packages("spdlog", "glm")
+
+target("ImageKernelsBenchmark")
+    set_kind("binary")
+    set_default(false)
+
+    -- 核对并比较 ImageKernels 的 SIMD 与标量实现，运行: xmake run ImageKernelsBenchmark [边长]
+    add_files("benchmarks/ImageKernels/*.cpp")
+    add_deps("Doodle")
+    traverse_directory("Doodle/src")
+    add_packages("spdlog")
+    set_optimize("fastest")